@@ -78,6 +78,11 @@ public abstract class NativeMediaPlayer implements MediaPlayer, MarkerStateListe
     public final static int eventPlayerStalled = 105;
     public final static int eventPlayerFinished = 106;
     public final static int eventPlayerError = 107;
+    //***** Event record types used by sendEventBatch(). Sent from native JNI layer.
+    public final static int eventBatchNewFrame = 200;
+    public final static int eventBatchMarker = 201;
+    public final static int eventBatchBufferProgress = 202;
+    public final static int eventBatchAudioSpectrum = 203;
     // Nominal video frames per second.
     private static final int NOMINAL_VIDEO_FPS = 30;
     // Nanoseconds per second.
@@ -1540,6 +1545,41 @@ public abstract class NativeMediaPlayer implements MediaPlayer, MarkerStateListe
         sendPlayerEvent(new AudioSpectrumEvent(getAudioSpectrum(), timestamp, duration));
     }
 
+    /**
+     * Receives a batch of coalesced events from the native layer. Each event is
+     * encoded as a record type followed by its arguments; doubles are passed as
+     * their raw long bits and marker names as indices into <code>names</code>.
+     */
+    protected void sendEventBatch(long[] events, String[] names) {
+        int i = 0;
+        while (i < events.length) {
+            switch ((int) events[i]) {
+                case eventBatchNewFrame:
+                    sendNewFrameEvent(events[i + 1]);
+                    i += 2;
+                    break;
+                case eventBatchMarker:
+                    sendMarkerEvent(names[(int) events[i + 1]],
+                            Double.longBitsToDouble(events[i + 2]));
+                    i += 3;
+                    break;
+                case eventBatchBufferProgress:
+                    sendBufferProgressEvent(Double.longBitsToDouble(events[i + 1]),
+                            events[i + 2], events[i + 3], events[i + 4]);
+                    i += 5;
+                    break;
+                case eventBatchAudioSpectrum:
+                    sendAudioSpectrumEvent(Double.longBitsToDouble(events[i + 1]),
+                            Double.longBitsToDouble(events[i + 2]));
+                    i += 3;
+                    break;
+                default:
+                    Logger.logMsg(Logger.ERROR, "Unknown event in native event batch: " + events[i]);
+                    return;
+            }
+        }
+    }
+
     @Override
     public void markerStateChanged(boolean hasMarkers) {
         if (hasMarkers) {
@@ -30,7 +30,17 @@
 #include <com_sun_media_jfxmediaimpl_NativeMediaPlayer.h>
 #include <Common/VSMemory.h>
 #include <Utils/LowLevelPerf.h>
+#include <Utils/AutoLock.h>
 #include <jni/Logger.h>
+#include <string.h>
+#include <algorithm>
+#include <list>
+
+#if TARGET_OS_MAC
+#include <mach/mach_time.h>
+#elif !TARGET_OS_WIN32
+#include <time.h>
+#endif
 
 static bool areJMethodIDsInitialized = false;
 
@@ -48,17 +58,370 @@ jmethodID CJavaPlayerEventDispatcher::m_SendMarkerEventMethod = 0;
 jmethodID CJavaPlayerEventDispatcher::m_SendBufferProgressEventMethod = 0;
 jmethodID CJavaPlayerEventDispatcher::m_SendDurationUpdateEventMethod = 0;
 jmethodID CJavaPlayerEventDispatcher::m_SendAudioSpectrumEventMethod = 0;
+jmethodID CJavaPlayerEventDispatcher::m_SendEventBatchMethod = 0;
+jclass    CJavaPlayerEventDispatcher::m_StringClass = NULL;
+
+// Batching deadlines are measured on a monotonic clock so that the wall clock
+// being set backwards does not hold back event delivery.
+static uint64_t GetCurrentTimeMillis()
+{
+#if TARGET_OS_WIN32
+    return (uint64_t)GetTickCount64();
+#elif TARGET_OS_MAC
+    static mach_timebase_info_data_t timebase;
+    if (0 == timebase.denom)
+        mach_timebase_info(&timebase);
+    return mach_absolute_time() * timebase.numer / timebase.denom / 1000000;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+/******************************************************************************************
+ * CJavaEventDeliveryThread
+ *
+ * Single thread shared by all players which delivers event batches that could not be
+ * sent right away because the previous batch of the same player went out less than
+ * EVENT_BATCH_INTERVAL_MS ago. The thread stays attached to the JVM for its whole
+ * lifetime so deferred deliveries do not pay for AttachCurrentThread each time.
+ ******************************************************************************************/
+class CJavaEventDeliveryThread
+{
+public:
+    static void Register(JavaVM *pVM, CJavaPlayerEventDispatcher *pDispatcher);
+    static void Unregister(CJavaPlayerEventDispatcher *pDispatcher);
+    static void Wake();
+
+private:
+    static void Initialize();
+#if !TARGET_OS_WIN32
+    static void InitializeCondition();
+#endif
+    static void Lock();
+    static void Unlock();
+    static void Wait(uint64_t timeoutMs); // 0 means wait until woken
+    static void WaitForFlush();
+    static void NotifyFlushDone();
+    static bool IsDeliveryThread();
+    static bool Start();
+    static void Run();
+
+#if TARGET_OS_WIN32
+    static DWORD WINAPI ThreadProc(LPVOID pData);
+
+    static CRITICAL_SECTION         m_Lock;
+    static CONDITION_VARIABLE       m_Condition;
+    static CONDITION_VARIABLE       m_FlushDoneCondition;
+    static DWORD                    m_ThreadId;
+#else
+    static void* ThreadProc(void* pData);
+
+    static pthread_mutex_t          m_Lock;
+    static pthread_cond_t           m_Condition;
+    static pthread_cond_t           m_FlushDoneCondition;
+    static pthread_t                m_Thread;
+    static pthread_once_t           m_ConditionOnce;
+#endif
+    static volatile bool            m_bInitialized;
+    static bool                     m_bStarted;
+    static JavaVM*                  m_pVM;
+    static list<CJavaPlayerEventDispatcher*> m_Dispatchers;
+    static CJavaPlayerEventDispatcher* m_pFlushing; // dispatcher being flushed without m_Lock held
+};
+
+#if TARGET_OS_WIN32
+CRITICAL_SECTION    CJavaEventDeliveryThread::m_Lock;
+CONDITION_VARIABLE  CJavaEventDeliveryThread::m_Condition;
+CONDITION_VARIABLE  CJavaEventDeliveryThread::m_FlushDoneCondition;
+DWORD               CJavaEventDeliveryThread::m_ThreadId = 0;
+#else
+pthread_mutex_t     CJavaEventDeliveryThread::m_Lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t      CJavaEventDeliveryThread::m_Condition; // see InitializeCondition()
+pthread_cond_t      CJavaEventDeliveryThread::m_FlushDoneCondition = PTHREAD_COND_INITIALIZER;
+pthread_t           CJavaEventDeliveryThread::m_Thread;
+pthread_once_t      CJavaEventDeliveryThread::m_ConditionOnce = PTHREAD_ONCE_INIT;
+#endif
+volatile bool       CJavaEventDeliveryThread::m_bInitialized = false;
+bool                CJavaEventDeliveryThread::m_bStarted = false;
+JavaVM*             CJavaEventDeliveryThread::m_pVM = NULL;
+list<CJavaPlayerEventDispatcher*> CJavaEventDeliveryThread::m_Dispatchers;
+CJavaPlayerEventDispatcher* CJavaEventDeliveryThread::m_pFlushing = NULL;
+
+void CJavaEventDeliveryThread::Initialize()
+{
+#if TARGET_OS_WIN32
+    // Static initialization order is not an issue for the POSIX primitives,
+    // Windows ones have to be set up at run time. Players are created on the
+    // Java side under a lock, so the race here is benign in practice.
+    if (!m_bInitialized)
+    {
+        InitializeCriticalSection(&m_Lock);
+        InitializeConditionVariable(&m_Condition);
+        InitializeConditionVariable(&m_FlushDoneCondition);
+        m_bInitialized = true;
+    }
+#else
+    pthread_once(&m_ConditionOnce, InitializeCondition);
+    m_bInitialized = true;
+#endif
+}
+
+#if !TARGET_OS_WIN32
+// The timed wait in Wait() has to run on the same monotonic clock as
+// GetCurrentTimeMillis(). Mac OS X cannot select the clock of a condition
+// variable, Wait() uses a relative timeout there instead.
+void CJavaEventDeliveryThread::InitializeCondition()
+{
+#if TARGET_OS_MAC
+    pthread_cond_init(&m_Condition, NULL);
+#else
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&m_Condition, &attr);
+    pthread_condattr_destroy(&attr);
+#endif
+}
+#endif
+
+void CJavaEventDeliveryThread::Lock()
+{
+#if TARGET_OS_WIN32
+    EnterCriticalSection(&m_Lock);
+#else
+    pthread_mutex_lock(&m_Lock);
+#endif
+}
+
+void CJavaEventDeliveryThread::Unlock()
+{
+#if TARGET_OS_WIN32
+    LeaveCriticalSection(&m_Lock);
+#else
+    pthread_mutex_unlock(&m_Lock);
+#endif
+}
+
+void CJavaEventDeliveryThread::Wait(uint64_t timeoutMs)
+{
+#if TARGET_OS_WIN32
+    SleepConditionVariableCS(&m_Condition, &m_Lock, timeoutMs ? (DWORD)timeoutMs : INFINITE);
+#else
+    if (timeoutMs == 0) {
+        pthread_cond_wait(&m_Condition, &m_Lock);
+    } else {
+#if TARGET_OS_MAC
+        struct timespec timeout;
+        timeout.tv_sec = (time_t)(timeoutMs / 1000);
+        timeout.tv_nsec = (long)(timeoutMs % 1000) * 1000000;
+        pthread_cond_timedwait_relative_np(&m_Condition, &m_Lock, &timeout);
+#else
+        struct timespec now;
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        uint64_t nsec = (uint64_t)now.tv_nsec + (timeoutMs % 1000) * 1000000;
+        deadline.tv_sec = now.tv_sec + (time_t)(timeoutMs / 1000) + (time_t)(nsec / 1000000000);
+        deadline.tv_nsec = (long)(nsec % 1000000000);
+        pthread_cond_timedwait(&m_Condition, &m_Lock, &deadline);
+#endif
+    }
+#endif
+}
+
+// Call with m_Lock held.
+void CJavaEventDeliveryThread::WaitForFlush()
+{
+#if TARGET_OS_WIN32
+    SleepConditionVariableCS(&m_FlushDoneCondition, &m_Lock, INFINITE);
+#else
+    pthread_cond_wait(&m_FlushDoneCondition, &m_Lock);
+#endif
+}
+
+// Call with m_Lock held.
+void CJavaEventDeliveryThread::NotifyFlushDone()
+{
+#if TARGET_OS_WIN32
+    WakeAllConditionVariable(&m_FlushDoneCondition);
+#else
+    pthread_cond_broadcast(&m_FlushDoneCondition);
+#endif
+}
+
+// Call with m_Lock held.
+bool CJavaEventDeliveryThread::IsDeliveryThread()
+{
+#if TARGET_OS_WIN32
+    return m_bStarted && GetCurrentThreadId() == m_ThreadId;
+#else
+    return m_bStarted && pthread_equal(pthread_self(), m_Thread);
+#endif
+}
+
+// Call with m_Lock held.
+bool CJavaEventDeliveryThread::Start()
+{
+#if TARGET_OS_WIN32
+    HANDLE hThread = CreateThread(NULL, 0, ThreadProc, NULL, 0, &m_ThreadId);
+    if (NULL == hThread)
+        return false;
+    CloseHandle(hThread);
+    return true;
+#else
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    int res = pthread_create(&m_Thread, &attr, ThreadProc, NULL);
+    pthread_attr_destroy(&attr);
+    return (0 == res);
+#endif
+}
+
+#if TARGET_OS_WIN32
+DWORD WINAPI CJavaEventDeliveryThread::ThreadProc(LPVOID pData)
+{
+    Run();
+    return 0;
+}
+#else
+void* CJavaEventDeliveryThread::ThreadProc(void* pData)
+{
+    Run();
+    return NULL;
+}
+#endif
+
+void CJavaEventDeliveryThread::Register(JavaVM *pVM, CJavaPlayerEventDispatcher *pDispatcher)
+{
+    Initialize();
+    Lock();
+    if (NULL == m_pVM)
+        m_pVM = pVM;
+    m_Dispatchers.push_back(pDispatcher);
+    if (!m_bStarted)
+    {
+        m_bStarted = Start();
+        if (!m_bStarted)
+            LOGGER_LOGMSG(LOGGER_WARNING, "Cannot start player event delivery thread.\n");
+    }
+    Unlock();
+}
+
+void CJavaEventDeliveryThread::Unregister(CJavaPlayerEventDispatcher *pDispatcher)
+{
+    if (!m_bInitialized)
+        return;
+
+    // Once this returns the delivery thread no longer touches the dispatcher.
+    // A Java listener may dispose the player from within the batch the
+    // delivery thread is sending for it, that thread must not wait for itself.
+    Lock();
+    m_Dispatchers.remove(pDispatcher);
+    while (m_pFlushing == pDispatcher && !IsDeliveryThread())
+        WaitForFlush();
+    Unlock();
+}
+
+void CJavaEventDeliveryThread::Wake()
+{
+    Lock();
+#if TARGET_OS_WIN32
+    WakeConditionVariable(&m_Condition);
+#else
+    pthread_cond_signal(&m_Condition);
+#endif
+    Unlock();
+}
+
+void CJavaEventDeliveryThread::Run()
+{
+    jboolean attached = false;
+    JNIEnv *pEnv = NULL;
+
+    Lock();
+    pEnv = GetJavaEnvironment(m_pVM, attached);
+    if (NULL == pEnv)
+    {
+        m_bStarted = false;
+        Unlock();
+        return;
+    }
+
+    for (;;)
+    {
+        uint64_t now = GetCurrentTimeMillis();
+        uint64_t nextDueTime = 0;
+        list<CJavaPlayerEventDispatcher*> dueDispatchers;
+
+        for (list<CJavaPlayerEventDispatcher*>::iterator it = m_Dispatchers.begin();
+             it != m_Dispatchers.end(); ++it)
+        {
+            uint64_t dueTime = (*it)->GetEventQueueDueTime();
+            if (0 == dueTime)
+                continue;
+
+            if (dueTime <= now)
+                dueDispatchers.push_back(*it);
+            else if (0 == nextDueTime || dueTime < nextDueTime)
+                nextDueTime = dueTime;
+        }
+
+        // Flushing calls into Java, whose listeners may create or dispose
+        // players, so it is done without m_Lock held. Unregister() waits for
+        // m_pFlushing to be cleared before the dispatcher can go away.
+        for (list<CJavaPlayerEventDispatcher*>::iterator it = dueDispatchers.begin();
+             it != dueDispatchers.end(); ++it)
+        {
+            if (find(m_Dispatchers.begin(), m_Dispatchers.end(), *it) == m_Dispatchers.end())
+                continue; // unregistered while an earlier one was flushed
+
+            m_pFlushing = *it;
+            Unlock();
+            (*it)->FlushEventQueue(pEnv);
+            Lock();
+            m_pFlushing = NULL;
+            NotifyFlushDone();
+        }
+
+        if (!dueDispatchers.empty())
+            continue; // new events may have arrived while unlocked
+
+        Wait(nextDueTime ? nextDueTime - now : 0);
+    }
+}
 
+/******************************************************************************************
+ * CJavaPlayerEventDispatcher
+ ******************************************************************************************/
 CJavaPlayerEventDispatcher::CJavaPlayerEventDispatcher()
 : m_PlayerVM(NULL),
   m_PlayerInstance(NULL),
-  m_MediaReference(0L)
+  m_MediaReference(0L),
+  m_pQueueLock(NULL),
+  m_pDeliveryLock(NULL),
+  m_pPendingFrame(NULL),
+  m_bPendingBufferProgress(false),
+  m_PendingClipDuration(0.0),
+  m_PendingBufferStart(0),
+  m_PendingBufferStop(0),
+  m_PendingBufferPosition(0),
+  m_bPendingAudioSpectrum(false),
+  m_PendingSpectrumTime(0.0),
+  m_PendingSpectrumDuration(0.0),
+  m_LastDeliveryTime(0)
 {
 }
 
 CJavaPlayerEventDispatcher::~CJavaPlayerEventDispatcher()
 {
     Dispose();
+
+    if (m_pQueueLock)
+        delete m_pQueueLock;
+    if (m_pDeliveryLock)
+        delete m_pDeliveryLock;
 }
 
 void CJavaPlayerEventDispatcher::Init(JNIEnv *env, jobject PlayerInstance, CMedia* pMedia)
@@ -159,17 +522,50 @@ void CJavaPlayerEventDispatcher::Init(JNIEnv *env, jobject PlayerInstance, CMedi
             hasException = javaEnv.reportException();
         }
 
+        // Batched delivery is optional, players which do not implement it get
+        // every event delivered immediately.
+        if (!hasException)
+        {
+            m_SendEventBatchMethod = env->GetMethodID(klass, "sendEventBatch", "([J[Ljava/lang/String;)V");
+            if (javaEnv.clearException())
+                m_SendEventBatchMethod = 0;
+        }
+
+        if (!hasException && NULL == m_StringClass)
+        {
+            jclass stringClass = env->FindClass("java/lang/String");
+            if (!javaEnv.clearException() && stringClass)
+            {
+                m_StringClass = (jclass)env->NewGlobalRef(stringClass);
+                env->DeleteLocalRef(stringClass);
+            }
+        }
+
         env->DeleteLocalRef(klass);
 
         areJMethodIDsInitialized = !hasException;
     }
 
+    if (NULL != m_SendEventBatchMethod && NULL != m_StringClass)
+    {
+        m_pQueueLock = CJfxCriticalSection::Create();
+        m_pDeliveryLock = CJfxCriticalSection::Create();
+        if (IsBatchingEnabled())
+            CJavaEventDeliveryThread::Register(m_PlayerVM, this);
+    }
+
     LOWLEVELPERF_EXECTIMESTOP("CJavaPlayerEventDispatcher::Init()");
 }
 
 void CJavaPlayerEventDispatcher::Dispose()
 {
     LOWLEVELPERF_EXECTIMESTART("CJavaPlayerEventDispatcher::Dispose()");
+    if (IsBatchingEnabled())
+    {
+        CJavaEventDeliveryThread::Unregister(this);
+        DiscardEventQueue();
+    }
+
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
@@ -180,11 +576,194 @@ void CJavaPlayerEventDispatcher::Dispose()
     LOWLEVELPERF_EXECTIMESTOP("CJavaPlayerEventDispatcher::Dispose()");
 }
 
+bool CJavaPlayerEventDispatcher::IsBatchingEnabled()
+{
+    return (NULL != m_pQueueLock && NULL != m_pDeliveryLock);
+}
+
+/**
+ * Must be called with m_pQueueLock held after an event has been added to the
+ * queue. Returns true if the queue should be delivered right away by the
+ * calling thread, false if delivery is left to CJavaEventDeliveryThread.
+ */
+bool CJavaPlayerEventDispatcher::QueueEvent()
+{
+    return IsEventQueueDue(GetCurrentTimeMillis());
+}
+
+bool CJavaPlayerEventDispatcher::IsEventQueueDue(uint64_t now)
+{
+    return (now >= m_LastDeliveryTime + EVENT_BATCH_INTERVAL_MS);
+}
+
+/**
+ * Returns the time at which pending events have to be delivered, or 0 if there
+ * is nothing pending.
+ */
+uint64_t CJavaPlayerEventDispatcher::GetEventQueueDueTime()
+{
+    CAutoLock lock(m_pQueueLock);
+    if (NULL == m_pPendingFrame && !m_bPendingBufferProgress &&
+        !m_bPendingAudioSpectrum && m_PendingMarkers.empty())
+        return 0;
+
+    return m_LastDeliveryTime + EVENT_BATCH_INTERVAL_MS;
+}
+
+void CJavaPlayerEventDispatcher::DiscardEventQueue()
+{
+    CAutoLock lock(m_pQueueLock);
+    if (m_pPendingFrame)
+    {
+        delete m_pPendingFrame;
+        m_pPendingFrame = NULL;
+    }
+    m_bPendingBufferProgress = false;
+    m_bPendingAudioSpectrum = false;
+    m_PendingMarkers.clear();
+}
+
+bool CJavaPlayerEventDispatcher::FlushEventQueue()
+{
+    if (!IsBatchingEnabled() || 0 == GetEventQueueDueTime())
+        return true;
+
+    CJavaEnvironment jenv(m_PlayerVM);
+    JNIEnv *pEnv = jenv.getEnvironment();
+    if (pEnv)
+        return FlushEventQueue(pEnv);
+
+    return false;
+}
+
+static inline jlong DoubleToJLongBits(double value)
+{
+    jlong bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * Delivers all pending events in a single sendEventBatch() upcall. The events
+ * are encoded into a long array as [type, args...] records, doubles are passed
+ * as their raw bits and marker names are passed by index into a String array.
+ */
+bool CJavaPlayerEventDispatcher::FlushEventQueue(JNIEnv *pEnv)
+{
+    if (!IsBatchingEnabled())
+        return true;
+
+    CAutoLock deliveryLock(m_pDeliveryLock);
+
+    CVideoFrame* pFrame = NULL;
+    bool bBufferProgress = false;
+    double clipDuration = 0.0;
+    int64_t bufferStart = 0, bufferStop = 0, bufferPosition = 0;
+    bool bAudioSpectrum = false;
+    double spectrumTime = 0.0, spectrumDuration = 0.0;
+    vector<PendingMarker> markers;
+
+    {
+        CAutoLock queueLock(m_pQueueLock);
+        pFrame = m_pPendingFrame;
+        m_pPendingFrame = NULL;
+        bBufferProgress = m_bPendingBufferProgress;
+        m_bPendingBufferProgress = false;
+        clipDuration = m_PendingClipDuration;
+        bufferStart = m_PendingBufferStart;
+        bufferStop = m_PendingBufferStop;
+        bufferPosition = m_PendingBufferPosition;
+        bAudioSpectrum = m_bPendingAudioSpectrum;
+        m_bPendingAudioSpectrum = false;
+        spectrumTime = m_PendingSpectrumTime;
+        spectrumDuration = m_PendingSpectrumDuration;
+        markers.swap(m_PendingMarkers);
+        m_LastDeliveryTime = GetCurrentTimeMillis();
+    }
+
+    if (NULL == pFrame && !bBufferProgress && !bAudioSpectrum && markers.empty())
+        return true;
+
+    LOWLEVELPERF_EXECTIMESTART("CJavaPlayerEventDispatcher::FlushEventQueue()");
+
+    CJavaEnvironment jenv(pEnv);
+    bool bSucceeded = false;
+    bool bFrameDelivered = false;
+    jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
+    if (localPlayer) {
+        jsize count = (jsize)(markers.size() * 3) + (bBufferProgress ? 5 : 0) +
+                      (bAudioSpectrum ? 3 : 0) + (pFrame ? 2 : 0);
+        jlongArray jevents = pEnv->NewLongArray(count);
+        jobjectArray jnames = NULL;
+        if (!jenv.reportException()) {
+            jnames = pEnv->NewObjectArray((jsize)markers.size(), m_StringClass, NULL);
+        }
+
+        if (jevents && jnames && !jenv.reportException()) {
+            vector<jlong> events;
+            events.reserve(count);
+
+            for (size_t i = 0; i < markers.size(); i++) {
+                jstring jname = pEnv->NewStringUTF(markers[i].name.c_str());
+                if (jenv.reportException())
+                    break;
+                pEnv->SetObjectArrayElement(jnames, (jsize)i, jname);
+                pEnv->DeleteLocalRef(jname);
+
+                events.push_back(com_sun_media_jfxmediaimpl_NativeMediaPlayer_eventBatchMarker);
+                events.push_back((jlong)i);
+                events.push_back(DoubleToJLongBits(markers[i].time));
+            }
+
+            if (bBufferProgress) {
+                events.push_back(com_sun_media_jfxmediaimpl_NativeMediaPlayer_eventBatchBufferProgress);
+                events.push_back(DoubleToJLongBits(clipDuration));
+                events.push_back((jlong)bufferStart);
+                events.push_back((jlong)bufferStop);
+                events.push_back((jlong)bufferPosition);
+            }
+
+            if (bAudioSpectrum) {
+                events.push_back(com_sun_media_jfxmediaimpl_NativeMediaPlayer_eventBatchAudioSpectrum);
+                events.push_back(DoubleToJLongBits(spectrumTime));
+                events.push_back(DoubleToJLongBits(spectrumDuration));
+            }
+
+            if (pFrame) {
+                events.push_back(com_sun_media_jfxmediaimpl_NativeMediaPlayer_eventBatchNewFrame);
+                events.push_back(ptr_to_jlong(pFrame));
+            }
+
+            if ((jsize)events.size() == count) {
+                pEnv->SetLongArrayRegion(jevents, 0, count, &events[0]);
+                // sendEventBatch will create the NativeVideoBuffer wrapper for the java side
+                pEnv->CallVoidMethod(localPlayer, m_SendEventBatchMethod, jevents, jnames);
+                bFrameDelivered = true;
+                bSucceeded = !jenv.reportException();
+            }
+        }
+
+        if (jevents)
+            pEnv->DeleteLocalRef(jevents);
+        if (jnames)
+            pEnv->DeleteLocalRef(jnames);
+        pEnv->DeleteLocalRef(localPlayer);
+    }
+
+    if (pFrame && !bFrameDelivered)
+        delete pFrame;
+
+    LOWLEVELPERF_EXECTIMESTOP("CJavaPlayerEventDispatcher::FlushEventQueue()");
+
+    return bSucceeded;
+}
+
 void CJavaPlayerEventDispatcher::Warning(int warningCode, const char* warningMessage)
 {
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             jstring jmessage = NULL;
@@ -212,6 +791,7 @@ bool CJavaPlayerEventDispatcher::SendPlayerMediaErrorEvent(int errorCode)
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             pEnv->CallVoidMethod(localPlayer, m_SendPlayerMediaErrorEventMethod, errorCode);
@@ -230,6 +810,7 @@ bool CJavaPlayerEventDispatcher::SendPlayerHaltEvent(const char* message, double
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             jstring jmessage = NULL;
@@ -293,6 +874,7 @@ bool CJavaPlayerEventDispatcher::SendPlayerStateEvent(int newState, double prese
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             pEnv->CallVoidMethod(localPlayer, m_SendPlayerStateEventMethod, newJavaState, presentTime);
@@ -307,6 +889,25 @@ bool CJavaPlayerEventDispatcher::SendPlayerStateEvent(int newState, double prese
 
 bool CJavaPlayerEventDispatcher::SendNewFrameEvent(CVideoFrame* pVideoFrame)
 {
+    if (IsBatchingEnabled())
+    {
+        bool bDeliverNow = false;
+        {
+            CAutoLock lock(m_pQueueLock);
+            // A frame that has not reached Java yet is superseded by the new one
+            if (m_pPendingFrame)
+                delete m_pPendingFrame;
+            m_pPendingFrame = pVideoFrame;
+            bDeliverNow = QueueEvent();
+        }
+
+        if (bDeliverNow)
+            return FlushEventQueue();
+
+        CJavaEventDeliveryThread::Wake();
+        return true;
+    }
+
     LOWLEVELPERF_EXECTIMESTART("CJavaPlayerEventDispatcher::SendNewFrameEvent()");
     bool bSucceeded = false;
 
@@ -334,6 +935,7 @@ bool CJavaPlayerEventDispatcher::SendFrameSizeChangedEvent(int width, int height
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             pEnv->CallVoidMethod(localPlayer, m_SendFrameSizeChangedEventMethod, (jint)width, (jint)height);
@@ -352,6 +954,7 @@ bool CJavaPlayerEventDispatcher::SendAudioTrackEvent(CAudioTrack* pTrack)
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             jstring name = NULL;
@@ -415,6 +1018,7 @@ bool CJavaPlayerEventDispatcher::SendVideoTrackEvent(CVideoTrack* pTrack)
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             jstring name = NULL;
@@ -445,6 +1049,7 @@ bool CJavaPlayerEventDispatcher::SendSubtitleTrackEvent(CSubtitleTrack* pTrack)
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             jstring name = NULL;
@@ -478,6 +1083,25 @@ bool CJavaPlayerEventDispatcher::SendSubtitleTrackEvent(CSubtitleTrack* pTrack)
 
 bool CJavaPlayerEventDispatcher::SendMarkerEvent(string name, double time)
 {
+    if (IsBatchingEnabled())
+    {
+        bool bDeliverNow = false;
+        {
+            CAutoLock lock(m_pQueueLock);
+            PendingMarker marker;
+            marker.name = name;
+            marker.time = time;
+            m_PendingMarkers.push_back(marker);
+            bDeliverNow = QueueEvent();
+        }
+
+        if (bDeliverNow)
+            return FlushEventQueue();
+
+        CJavaEventDeliveryThread::Wake();
+        return true;
+    }
+
     bool bSucceeded = false;
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
@@ -506,6 +1130,26 @@ bool CJavaPlayerEventDispatcher::SendMarkerEvent(string name, double time)
 
 bool CJavaPlayerEventDispatcher::SendBufferProgressEvent(double clipDuration, int64_t start, int64_t stop, int64_t position)
 {
+    if (IsBatchingEnabled())
+    {
+        bool bDeliverNow = false;
+        {
+            CAutoLock lock(m_pQueueLock);
+            m_bPendingBufferProgress = true;
+            m_PendingClipDuration = clipDuration;
+            m_PendingBufferStart = start;
+            m_PendingBufferStop = stop;
+            m_PendingBufferPosition = position;
+            bDeliverNow = QueueEvent();
+        }
+
+        if (bDeliverNow)
+            return FlushEventQueue();
+
+        CJavaEventDeliveryThread::Wake();
+        return true;
+    }
+
     bool bSucceeded = false;
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
@@ -528,6 +1172,7 @@ bool CJavaPlayerEventDispatcher::SendDurationUpdateEvent(double time)
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
     if (pEnv) {
+        FlushEventQueue(pEnv);
         jobject localPlayer = pEnv->NewLocalRef(m_PlayerInstance);
         if (localPlayer) {
             pEnv->CallVoidMethod(localPlayer, m_SendDurationUpdateEventMethod,
@@ -543,6 +1188,24 @@ bool CJavaPlayerEventDispatcher::SendDurationUpdateEvent(double time)
 
 bool CJavaPlayerEventDispatcher::SendAudioSpectrumEvent(double time, double duration)
 {
+    if (IsBatchingEnabled())
+    {
+        bool bDeliverNow = false;
+        {
+            CAutoLock lock(m_pQueueLock);
+            m_bPendingAudioSpectrum = true;
+            m_PendingSpectrumTime = time;
+            m_PendingSpectrumDuration = duration;
+            bDeliverNow = QueueEvent();
+        }
+
+        if (bDeliverNow)
+            return FlushEventQueue();
+
+        CJavaEventDeliveryThread::Wake();
+        return true;
+    }
+
     bool bSucceeded = false;
     CJavaEnvironment jenv(m_PlayerVM);
     JNIEnv *pEnv = jenv.getEnvironment();
@@ -27,6 +27,7 @@
 #define _JAVA_PLAYER_EVENT_DISPATCHER_H_
 
 #include <jni.h>
+#include <vector>
 
 #include <PipelineManagement/AudioTrack.h>
 #include <PipelineManagement/VideoTrack.h>
@@ -36,6 +37,7 @@
 #include <PipelineManagement/VideoFrame.h>
 #include <MediaManagement/Media.h>
 #include <MediaManagement/MediaWarningListener.h>
+#include <Utils/JfxCriticalSection.h>
 
 using namespace std;
 
@@ -62,11 +64,48 @@ public:
     virtual bool SendAudioSpectrumEvent(double time, double duration);
     virtual void Warning(int warningCode, const char* warningMessage);
 
+    // Minimum interval between two batched upcalls made for the same player.
+    // New frame, buffer progress and audio spectrum events arriving within
+    // this interval are coalesced (only the latest one is kept), markers are
+    // queued in order. All of them are then delivered in a single upcall.
+    static const int EVENT_BATCH_INTERVAL_MS = 16;
+
 private:
+    friend class CJavaEventDeliveryThread;
+
+    struct PendingMarker
+    {
+        string  name;
+        double  time;
+    };
+
+    bool    IsBatchingEnabled();
+    bool    QueueEvent(); // call with m_pQueueLock held
+    bool    FlushEventQueue(JNIEnv *pEnv);
+    bool    FlushEventQueue();
+    void    DiscardEventQueue();
+    bool    IsEventQueueDue(uint64_t now);
+    uint64_t GetEventQueueDueTime();
+
     JavaVM *m_PlayerVM;
     jobject m_PlayerInstance;
     jlong   m_MediaReference; // FIXME: Nuke this field, it's completely unused
 
+    // Coalesced event queue, see EVENT_BATCH_INTERVAL_MS
+    CJfxCriticalSection*    m_pQueueLock;    // guards the pending events below
+    CJfxCriticalSection*    m_pDeliveryLock; // serializes batched upcalls
+    CVideoFrame*            m_pPendingFrame;
+    bool                    m_bPendingBufferProgress;
+    double                  m_PendingClipDuration;
+    int64_t                 m_PendingBufferStart;
+    int64_t                 m_PendingBufferStop;
+    int64_t                 m_PendingBufferPosition;
+    bool                    m_bPendingAudioSpectrum;
+    double                  m_PendingSpectrumTime;
+    double                  m_PendingSpectrumDuration;
+    vector<PendingMarker>   m_PendingMarkers;
+    uint64_t                m_LastDeliveryTime;
+
     static jmethodID m_SendWarningMethod;
 
     static jmethodID m_SendPlayerMediaErrorEventMethod;
@@ -81,6 +120,8 @@ private:
     static jmethodID m_SendBufferProgressEventMethod;
     static jmethodID m_SendDurationUpdateEventMethod;
     static jmethodID m_SendAudioSpectrumEventMethod;
+    static jmethodID m_SendEventBatchMethod;
+    static jclass    m_StringClass;
 
     static jobject CreateObject(JNIEnv *env, jmethodID *cid,
                                 const char* class_name, const char* signature,
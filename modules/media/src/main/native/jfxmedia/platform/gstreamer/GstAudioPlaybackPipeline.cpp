@@ -25,6 +25,7 @@
 
 #include "GstAudioPlaybackPipeline.h"
 #include "GstMediaManager.h"
+#include "GstPipelineFactory.h"
 #include <MediaManagement/MediaTypes.h>
 #include <PipelineManagement/AudioTrack.h>
 #include <PipelineManagement/PlayerEventDispatcher.h>
@@ -58,6 +59,7 @@ CGstAudioPlaybackPipeline::CGstAudioPlaybackPipeline(const GstElementContainer&
 
     m_bSeekInvoked = false;
     m_fRate = 1.0F;
+    m_audioSinkPadProbeHID = 0L;
     m_audioSourcePadProbeHID = 0L;
     m_ulLastStreamTime = (GstClockTime)0UL;
     m_pBusSource = NULL;
@@ -397,6 +399,10 @@ void CGstAudioPlaybackPipeline::Dispose()
             m_pBusSource = NULL;
         }
 
+        // Audio-only pipelines hand their audio bin back to the factory for reuse.
+        if (NULL == m_Elements[AV_DEMUXER] && NULL == m_Elements[VIDEO_BIN])
+            ReleaseAudioBin();
+
         gst_object_unref (m_Elements[PIPELINE]);
     }
 
@@ -416,6 +422,51 @@ void CGstAudioPlaybackPipeline::Dispose()
     }
 }
 
+static void RemoveBufferProbe(GstElement* pElement, const gchar* strPadName, gulong probeHID)
+{
+    if (NULL == pElement || 0L == probeHID)
+        return;
+
+    GstPad *pPad = gst_element_get_static_pad(pElement, strPadName);
+    if (NULL != pPad)
+    {
+        // Probes remove themselves once they got what they needed.
+        if (g_signal_handler_is_connected(pPad, probeHID))
+            gst_pad_remove_data_probe(pPad, probeHID);
+        gst_object_unref(pPad);
+    }
+}
+
+/**
+ * CGstAudioPlaybackPipeline::ReleaseAudioBin()
+ *
+ * Detaches this pipeline from its audio bin and returns the bin to the
+ * pipeline factory pool. Called from Dispose() with the pipeline in NULL state.
+ */
+void CGstAudioPlaybackPipeline::ReleaseAudioBin()
+{
+    CPipelineFactory* pFactory = NULL;
+    if (ERROR_NONE != CPipelineFactory::GetInstance(&pFactory) || NULL == pFactory)
+        return;
+
+    if (m_Elements[AUDIO_PARSER])
+    {
+        // The "pad-added" handler only disconnects itself once it fires, it
+        // must not be left behind for the next pipeline using this bin.
+        g_signal_handlers_disconnect_by_func(m_Elements[AUDIO_PARSER], (void*)OnParserSrcPadAdded, this);
+        RemoveBufferProbe(m_Elements[AUDIO_PARSER], "src", m_audioSourcePadProbeHID);
+    }
+    else
+    {
+        RemoveBufferProbe(m_Elements[AUDIO_DECODER], "sink", m_audioSinkPadProbeHID);
+        RemoveBufferProbe(m_Elements[AUDIO_DECODER], "src", m_audioSourcePadProbeHID);
+    }
+    m_audioSinkPadProbeHID = 0L;
+    m_audioSourcePadProbeHID = 0L;
+
+    ((CGstPipelineFactory*)pFactory)->ReleaseAudioBin(m_Elements);
+}
+
 /**
  * CGstAudioPlaybackPipeline::Play()
  *
@@ -162,6 +162,7 @@ private:
     static gboolean     AudioSinkPadProbe(GstPad* pPad, GstBuffer *pBuffer, CGstAudioPlaybackPipeline* pPipeline);
 
     void                SendTrackEvent();
+    void                ReleaseAudioBin();
     uint32_t            InternalPause();
     uint32_t            SeekPipeline(gint64 seek_time);
 
@@ -35,7 +35,10 @@
 #include <jfxmedia_errors.h>
 #include <gst/gstelement.h>
 #include <Utils/LowLevelPerf.h>
+#include <Utils/AutoLock.h>
+#include <jni/Logger.h>
 #include <algorithm>
+#include <stdlib.h>
 #if ENABLE_VIDEOCONVERT
 #include <gst/app/gstappsink.h>
 #endif
@@ -46,6 +49,12 @@
 #define HLS_VALUE_MIMETYPE_MP2T 1
 #define HLS_VALUE_MIMETYPE_MP3  2
 
+// Audio bin pool. Bins of disposed audio-only pipelines are kept in NULL state
+// and handed out again to new pipelines built from the same recipe.
+#define AUDIO_BIN_POOL_SIZE_ENV     "JFXMEDIA_AUDIO_BIN_POOL_SIZE"
+#define AUDIO_BIN_POOL_SIZE_DEFAULT 4
+#define AUDIO_BIN_POOL_KEY          "jfxmedia-audio-bin-pool-key"
+
 
 //*************************************************************************************************
 //********** class CGstPipelineFactory
@@ -65,13 +74,28 @@ CGstPipelineFactory::CGstPipelineFactory()
     m_ContentTypes.push_back(CONTENT_TYPE_M4V);
     m_ContentTypes.push_back(CONTENT_TYPE_M3U8);
     m_ContentTypes.push_back(CONTENT_TYPE_M3U);
+
+    m_AudioBinPoolSize = AUDIO_BIN_POOL_SIZE_DEFAULT;
+    const char* value = getenv(AUDIO_BIN_POOL_SIZE_ENV);
+    if (value)
+    {
+        int size = atoi(value);
+        m_AudioBinPoolSize = size > 0 ? (size_t)size : 0;
+    }
+
+    m_pAudioBinPoolLock = CJfxCriticalSection::Create();
+    m_AudioBinsCreated = 0;
+    m_AudioBinsReused = 0;
+    m_AudioBinCreationTime = 0;
 }
 
 // Here we can only delete local resources not dependent on other libraries such as GStreamer
 // because the destructor is called after the main exits and we possible don't have access
-// to library functions or the are incorrect.
+// to library functions or the are incorrect. Pooled audio bins are therefore left alone.
 CGstPipelineFactory::~CGstPipelineFactory()
-{}
+{
+    delete m_pAudioBinPoolLock;
+}
 
 bool CGstPipelineFactory::CanPlayContentType(string contentType)
 {
@@ -659,9 +683,28 @@ uint32_t CGstPipelineFactory::CreateAudioPipeline(GstElement* source, const char
     GstElementContainer elements;
     int flags = 0;
     GstElement* audiobin;
-    uRetCode = CreateAudioBin(strParserName, strDecoderName, bConvertFormat, &elements, &flags, &audiobin);
-    if (ERROR_NONE != uRetCode)
-        return uRetCode;
+
+    string poolKey = string(strParserName ? strParserName : "") + "!" +
+                     (strDecoderName ? strDecoderName : "") + "!" +
+                     (bConvertFormat ? "audioconvert" : "");
+    if (!AcquirePooledAudioBin(poolKey, &elements, &flags, &audiobin))
+    {
+        GTimeVal start, stop;
+        g_get_current_time(&start);
+
+        uRetCode = CreateAudioBin(strParserName, strDecoderName, bConvertFormat, &elements, &flags, &audiobin);
+        if (ERROR_NONE != uRetCode)
+            return uRetCode;
+
+        g_get_current_time(&stop);
+
+        // Only bins of audio-only pipelines are tagged and thus can be recycled.
+        g_object_set_data_full(G_OBJECT(audiobin), AUDIO_BIN_POOL_KEY, g_strdup(poolKey.c_str()), g_free);
+
+        CAutoLock lock(m_pAudioBinPoolLock);
+        m_AudioBinsCreated++;
+        m_AudioBinCreationTime += (guint64)(GST_TIMEVAL_TO_TIME(stop) - GST_TIMEVAL_TO_TIME(start)) / GST_USECOND;
+    }
 
     uRetCode = AttachToSource(GST_BIN (pipeline), source, audiobin);
     if (ERROR_NONE != uRetCode)
@@ -968,6 +1011,174 @@ uint32_t CGstPipelineFactory::CreateVideoBin(const char* strDecoderName, GstElem
     return ERROR_NONE;
 }
 
+/**
+ * Takes an audio bin built from the recipe identified by key out of the pool.
+ * The bin is handed out floating, exactly as if it had just been created by
+ * CreateAudioBin(), so callers do not need to know where it came from.
+ *
+ * @return true if a pooled bin was found.
+ */
+bool CGstPipelineFactory::AcquirePooledAudioBin(const string& key, GstElementContainer* elements,
+                                                int* pFlags, GstElement** ppAudiobin)
+{
+    PooledAudioBin entry;
+    guint64 created, reused, creationTime;
+    {
+        CAutoLock lock(m_pAudioBinPoolLock);
+
+        std::list<PooledAudioBin>::iterator it = m_AudioBinPool.begin();
+        while (it != m_AudioBinPool.end() && it->key != key)
+            ++it;
+        if (it == m_AudioBinPool.end())
+            return false;
+
+        entry = *it;
+        m_AudioBinPool.erase(it);
+
+        created = m_AudioBinsCreated;
+        reused = ++m_AudioBinsReused;
+        creationTime = m_AudioBinCreationTime;
+    }
+
+    GST_OBJECT_FLAG_SET(entry.bin, GST_OBJECT_FLOATING);
+    *ppAudiobin = entry.bin;
+
+    elements->add(AUDIO_BIN, entry.bin).
+        add(AUDIO_QUEUE, entry.queue).
+        add(AUDIO_EQUALIZER, entry.equalizer).
+        add(AUDIO_SPECTRUM, entry.spectrum).
+        add(AUDIO_BALANCE, entry.balance).
+        add(AUDIO_VOLUME, entry.volume).
+        add(AUDIO_SINK, entry.sink);
+
+    if (NULL != entry.parser)
+        elements->add(AUDIO_PARSER, entry.parser);
+
+    if (NULL != entry.decoder)
+    {
+        elements->add(AUDIO_DECODER, entry.decoder);
+        *pFlags |= AUDIO_DECODER_HAS_SOURCE_PROBE | AUDIO_DECODER_HAS_SINK_PROBE;
+    }
+
+#if ENABLE_LOGGING
+    if (created > 0)
+    {
+        char message[256];
+        guint64 avoided = reused * (creationTime / created);
+        g_snprintf(message, sizeof(message),
+                 "Reused pooled audio bin %s (created: %lu, reused: %lu, creation time avoided: %lu us)",
+                 key.c_str(), (unsigned long)created, (unsigned long)reused, (unsigned long)avoided);
+        LOGGER_LOGMSG(LOGGER_DEBUG, message);
+    }
+#endif // ENABLE_LOGGING
+
+    return true;
+}
+
+/**
+ * Returns the audio bin of a disposed audio-only pipeline to the pool. Must be
+ * called after the pipeline has been set to NULL state and before it is unref'd.
+ * Properties the player may have changed are reset to their defaults.
+ *
+ * @return true if the bin was taken by the pool, false if the caller still
+ *         owns it through the pipeline.
+ */
+bool CGstPipelineFactory::ReleaseAudioBin(const GstElementContainer& elements)
+{
+    GstElement* bin = elements[AUDIO_BIN];
+    if (NULL == bin || 0 == m_AudioBinPoolSize)
+        return false;
+
+    const gchar* key = (const gchar*)g_object_get_data(G_OBJECT(bin), AUDIO_BIN_POOL_KEY);
+    if (NULL == key)
+        return false;
+
+    // Bin which never made it into the pipeline is still owned by its creator.
+    GstObject* parent = gst_object_get_parent(GST_OBJECT(bin));
+    if (NULL == parent)
+        return false;
+
+    PooledAudioBin entry;
+    entry.key = key;
+    entry.bin = bin;
+    entry.parser = elements[AUDIO_PARSER];
+    entry.queue = elements[AUDIO_QUEUE];
+    entry.decoder = elements[AUDIO_DECODER];
+    entry.equalizer = elements[AUDIO_EQUALIZER];
+    entry.spectrum = elements[AUDIO_SPECTRUM];
+    entry.balance = elements[AUDIO_BALANCE];
+    entry.volume = elements[AUDIO_VOLUME];
+    entry.sink = elements[AUDIO_SINK];
+
+    {
+        CAutoLock lock(m_pAudioBinPoolLock);
+        if (m_AudioBinPool.size() >= m_AudioBinPoolSize)
+        {
+            gst_object_unref(parent);
+            return false;
+        }
+    }
+
+    // Keep the bin alive when it is removed from the pipeline being destroyed.
+    gst_object_ref(bin);
+    gst_bin_remove(GST_BIN(parent), bin);
+    gst_object_unref(parent);
+    gst_element_set_state(bin, GST_STATE_NULL);
+
+    if (NULL != entry.equalizer)
+    {
+        guint count = gst_child_proxy_get_children_count(GST_CHILD_PROXY(entry.equalizer));
+        for (guint i = 0; i < count; i++)
+        {
+            GstObject* band = gst_child_proxy_get_child_by_index(GST_CHILD_PROXY(entry.equalizer), i);
+            if (band)
+            {
+                g_object_set(band, "gain", 0.0, NULL);
+                gst_object_unref(band);
+            }
+        }
+    }
+
+    static const char* const spectrumProperties[] = { "bands", "threshold", "interval", "post-messages", NULL };
+    static const char* const balanceProperties[] = { "panorama", NULL };
+    static const char* const volumeProperties[] = { "volume", "mute", NULL };
+    static const char* const sinkProperties[] = { "ts-offset", NULL };
+
+    ResetElementProperties(entry.spectrum, spectrumProperties);
+    ResetElementProperties(entry.balance, balanceProperties);
+    ResetElementProperties(entry.volume, volumeProperties);
+    ResetElementProperties(entry.sink, sinkProperties);
+
+    CAutoLock lock(m_pAudioBinPoolLock);
+    if (m_AudioBinPool.size() >= m_AudioBinPoolSize)
+    {
+        gst_object_unref(bin); // Pool filled up meanwhile, the bin goes away now.
+        return true;
+    }
+    m_AudioBinPool.push_back(entry);
+
+    return true;
+}
+
+void CGstPipelineFactory::ResetElementProperties(GstElement* element, const char* const* names)
+{
+    if (NULL == element)
+        return;
+
+    for (; NULL != *names; names++)
+    {
+        GParamSpec* pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(element), *names);
+        if (NULL == pspec || !(pspec->flags & G_PARAM_WRITABLE))
+            continue;
+
+        GValue value = { 0, };
+        g_value_init(&value, G_PARAM_SPEC_VALUE_TYPE(pspec));
+        g_param_value_set_default(pspec, &value);
+        g_object_set_property(G_OBJECT(element), *names, &value);
+        g_value_unset(&value);
+    }
+}
+
 GstElement* CGstPipelineFactory::CreateElement(const char* strFactoryName)
 {
     return gst_element_factory_make (strFactoryName, NULL);
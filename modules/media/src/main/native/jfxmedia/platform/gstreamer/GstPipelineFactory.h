@@ -30,7 +30,9 @@
 #include <PipelineManagement/PipelineFactory.h>
 #include <PipelineManagement/PipelineOptions.h>
 #include <platform/gstreamer/GstElementContainer.h>
+#include <Utils/JfxCriticalSection.h>
 #include <gst/gst.h>
+#include <list>
 
 /**
  * class CGstPipelineFactory
@@ -46,6 +48,8 @@ public:
     uint32_t           CreatePlayerPipeline(CLocator* locator, CPipelineOptions *pOptions, CPipeline** ppPipeline);
     static GstElement* GetByFactoryName(GstElement* bin, const char* strFactoryName);
 
+    bool               ReleaseAudioBin(const GstElementContainer& elements);
+
     virtual ~CGstPipelineFactory();
 
 private:
@@ -82,6 +86,24 @@ private:
 
     GstElement* CreateElement(const char* strFactoryName);
 
+    // Audio bin pool
+    struct PooledAudioBin
+    {
+        string      key;
+        GstElement* bin;
+        GstElement* parser;
+        GstElement* queue;
+        GstElement* decoder;
+        GstElement* equalizer;
+        GstElement* spectrum;
+        GstElement* balance;
+        GstElement* volume;
+        GstElement* sink;
+    };
+
+    bool        AcquirePooledAudioBin(const string& key, GstElementContainer* elements, int* pFlags, GstElement** ppAudiobin);
+    static void ResetElementProperties(GstElement* element, const char* const* names);
+
     // progressbuffer on-pad-added
     static void OnBufferPadAdded(GstElement* element, GstPad* pad, GstElement* peer);
 
@@ -98,6 +120,13 @@ private:
 
 private:
     ContentTypesList m_ContentTypes;
+
+    std::list<PooledAudioBin> m_AudioBinPool;
+    size_t               m_AudioBinPoolSize;
+    CJfxCriticalSection* m_pAudioBinPoolLock;
+    guint64              m_AudioBinsCreated;
+    guint64              m_AudioBinsReused;
+    guint64              m_AudioBinCreationTime; // Total time spent creating audio bins, microseconds
 };
 
 #endif  //_GST_PIPELINE_FACTORY_H_
@@ -38,7 +38,20 @@ import com.sun.webkit.graphics.WCImageFrame;
 import java.io.ByteArrayInputStream;
 import java.io.IOException;
 import java.io.InputStream;
-import java.util.Arrays;
+import java.lang.ref.SoftReference;
+import java.nio.ByteBuffer;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Future;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 import javafx.concurrent.Service;
@@ -48,14 +61,45 @@ final class WCImageDecoderImpl extends WCImageDecoder {
 
     private final static Logger log;
 
+    /*
+     * Complete images are decoded on these threads as soon as their last
+     * data arrives, so that the frames are usually ready by the time
+     * WebKit asks for them. The frames are only softly held until then,
+     * so that images which are never drawn do not keep them alive.
+     * Images large enough to be subsampled are not decoded in advance,
+     * since the size they are drawn at is not known yet.
+     */
+    private static final ExecutorService decoderPool;
+
+    static {
+        int threads = Math.max(1, Math.min(4, Runtime.getRuntime().availableProcessors() - 1));
+        ThreadPoolExecutor pool = new ThreadPoolExecutor(
+                threads, threads,
+                10, TimeUnit.SECONDS,
+                new LinkedBlockingQueue<Runnable>(),
+                new DecoderThreadFactory());
+        pool.allowCoreThreadTimeOut(true);
+        decoderPool = pool;
+    }
+
+    /*
+     * WebKit does not subsample a frame below this area, see
+     * BitmapImage::determineMinimumSubsamplingLevel().
+     */
+    private static final long MINIMUM_SUBSAMPLED_IMAGE_AREA = 256 * 256;
+
     private Service<ImageFrame[]> loader;
+    private Future<SoftReference<ImageFrame[]>> decoder; // decodes at full size
+    private AtomicBoolean decoderStarted; // set once the decoder leaves the queue
 
-    private int imageWidth = 0;
-    private int imageHeight = 0;
+    private volatile int imageWidth = 0;
+    private volatile int imageHeight = 0;
+    private int probedDataSize = 0; // data size when the image size was last looked for
     private ImageFrame[] frames;
     private int frameCount = 0; // keeps frame count when decoded frames are temporarily destroyed
     private boolean fullDataReceived = false;
     private boolean framesDecoded = false; // guards frames from repeated decoding
+    private int framesSubsamplingLevel = 0; // subsampling level the frames are decoded at
     private PrismImage[] images;
     private volatile byte[] data;
     private volatile int dataSize = 0;
@@ -76,6 +120,7 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         }
 
         destroyLoader();
+        destroyDecoder();
         frames = null;
         images = null;
         framesDecoded = false;
@@ -92,29 +137,41 @@ final class WCImageDecoderImpl extends WCImageDecoder {
 
     @Override protected void addImageData(byte[] dataPortion) {
         if (dataPortion != null) {
-            fullDataReceived = false;
-            if (data == null) {
-                data = Arrays.copyOf(dataPortion, dataPortion.length * 2);
-                dataSize = dataPortion.length;
-            } else {
-                int newDataSize = dataSize + dataPortion.length;
-                if (newDataSize > data.length) {
-                    resizeDataArray(Math.max(newDataSize, data.length * 2));
-                }
-                System.arraycopy(dataPortion, 0, data, dataSize, dataPortion.length);
-                dataSize = newDataSize;
-            }
-            // Try to decode the partial data until we get image size.
-            if (!imageSizeAvilable()) {
-                loadFrames();
-            }
+            int offset = reserveData(dataPortion.length);
+            System.arraycopy(dataPortion, 0, data, offset, dataPortion.length);
         } else if (data != null && !fullDataReceived) {
             // null dataPortion means data completion
             if (data.length > dataSize) {
                 resizeDataArray(dataSize);
             }
             fullDataReceived = true;
+            readImageSize();
+            if (!canBeSubsampled()) {
+                startDecoder();
+            }
+        }
+    }
+
+    @Override protected void addImageData(ByteBuffer dataPortion) {
+        int length = dataPortion.remaining();
+        int offset = reserveData(length);
+        dataPortion.get(data, offset, length);
+    }
+
+    /*
+     * Makes room for a data portion of the given length at the end of
+     * the data array and returns its offset.
+     */
+    private int reserveData(int length) {
+        fullDataReceived = false;
+        int offset = dataSize;
+        if (data == null) {
+            data = new byte[length * 2];
+        } else if (offset + length > data.length) {
+            resizeDataArray(Math.max(offset + length, data.length * 2));
         }
+        dataSize = offset + length;
+        return offset;
     }
 
     private void destroyLoader() {
@@ -124,6 +181,27 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         }
     }
 
+    private void destroyDecoder() {
+        if (decoder != null) {
+            decoder.cancel(false);
+            decoder = null;
+            decoderStarted = null;
+        }
+    }
+
+    private void startDecoder() {
+        destroyLoader();
+        destroyDecoder();
+        final byte[] data = this.data;
+        final int dataSize = this.dataSize;
+        final AtomicBoolean started = new AtomicBoolean();
+        decoder = decoderPool.submit(() -> {
+            started.set(true);
+            return new SoftReference<ImageFrame[]>(loadFrames(data, dataSize, 0));
+        });
+        decoderStarted = started;
+    }
+
     private void startLoader() {
         if (this.loader == null) {
             this.loader = new Service<ImageFrame[]>() {
@@ -168,14 +246,19 @@ final class WCImageDecoderImpl extends WCImageDecoder {
             return;
         }
 
-        setFrames(loadFrames(in));
+        setFrames(loadFrames(in, 0, 0));
     }
 
-    private ImageFrame[] loadFrames(InputStream in) {
+    private ImageFrame[] loadFrames(InputStream in, int width, int height) {
         if (log.isLoggable(Level.FINE)) {
             log.fine(String.format("%X Decoding frames", hashCode()));
         }
         try {
+            if (width > 0 && height > 0) {
+                // Loaders that cannot decode at a reduced size
+                // scale the full size image down while loading.
+                return ImageStorage.loadAll(in, readerListener, width, height, false, 1.0f, true);
+            }
             return ImageStorage.loadAll(in, readerListener, 0, 0, true, 1.0f, false);
         } catch (ImageStorageException e) {
             return null; // consider image missing
@@ -189,7 +272,108 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     }
 
     private ImageFrame[] loadFrames() {
-        return loadFrames(new ByteArrayInputStream(this.data, 0, this.dataSize));
+        return loadFrames(this.data, this.dataSize, 0);
+    }
+
+    private ImageFrame[] loadFrames(byte[] data, int dataSize, int subsamplingLevel) {
+        int width = 0;
+        int height = 0;
+        if (subsamplingLevel > 0) {
+            int scale = 1 << subsamplingLevel;
+            width = (imageWidth + scale - 1) / scale;
+            height = (imageHeight + scale - 1) / scale;
+        }
+        long start = System.nanoTime();
+        ImageFrame[] frames = loadFrames(new ByteArrayInputStream(data, 0, dataSize), width, height);
+        DecodeStatistics.record(data, dataSize, System.nanoTime() - start, hashCode());
+        return frames;
+    }
+
+    /*
+     * Only complete images that cannot be animated are subsampled,
+     * so that all frames of an image always have the same size.
+     */
+    private boolean canSubsample() {
+        return fullDataReceived && imageSizeAvilable()
+                && !"GIF".equals(DecodeStatistics.formatOf(data, dataSize));
+    }
+
+    /*
+     * Whether WebKit may ask for the image at a subsampling level above 0.
+     */
+    private boolean canBeSubsampled() {
+        return canSubsample()
+                && (long) ((imageWidth + 1) / 2) * ((imageHeight + 1) / 2)
+                        >= MINIMUM_SUBSAMPLED_IMAGE_AREA;
+    }
+
+    /*
+     * Reads the image size from the PNG, GIF, BMP or JPEG header,
+     * without decoding the image.
+     */
+    private void readImageSize() {
+        if (imageSizeAvilable() || data == null) {
+            return;
+        }
+        final byte[] data = this.data;
+        final int dataSize = this.dataSize;
+        int width = 0;
+        int height = 0;
+        switch (DecodeStatistics.formatOf(data, dataSize)) {
+            case "PNG":
+                if (dataSize >= 24) {
+                    width = readInt(data, 16, 4, true);
+                    height = readInt(data, 20, 4, true);
+                }
+                break;
+            case "GIF":
+                if (dataSize >= 10) {
+                    width = readInt(data, 6, 2, false);
+                    height = readInt(data, 8, 2, false);
+                }
+                break;
+            case "BMP":
+                if (dataSize >= 26) {
+                    width = readInt(data, 18, 4, false);
+                    // Rows are stored top-down if the height is negative.
+                    height = Math.abs(readInt(data, 22, 4, false));
+                }
+                break;
+            case "JPEG":
+                for (int i = 2; i + 9 < dataSize; ) {
+                    if (data[i] != (byte) 0xFF) {
+                        return;
+                    }
+                    int marker = data[i + 1] & 0xFF;
+                    if (marker == 0xFF) {
+                        i++; // fill byte
+                    } else if (marker >= 0xD0 && marker <= 0xD7 || marker == 0x01) {
+                        i += 2; // marker without a segment
+                    } else if (marker >= 0xC0 && marker <= 0xCF
+                            && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+                        // Start of frame
+                        height = readInt(data, i + 5, 2, true);
+                        width = readInt(data, i + 7, 2, true);
+                        break;
+                    } else {
+                        i += 2 + readInt(data, i + 2, 2, true);
+                    }
+                }
+                break;
+        }
+        if (width > 0 && height > 0) {
+            imageWidth = width;
+            imageHeight = height;
+        }
+    }
+
+    private static int readInt(byte[] data, int offset, int length, boolean bigEndian) {
+        int value = 0;
+        for (int i = 0; i < length; i++) {
+            int b = data[offset + (bigEndian ? i : length - 1 - i)] & 0xFF;
+            value = (value << 8) | b;
+        }
+        return value;
     }
 
     private final ImageLoadListener readerListener = new ImageLoadListener() {
@@ -214,6 +398,23 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     };
 
     @Override protected void getImageSize(int[] size) {
+        // Read the size from the header, or else try to decode
+        // the partial data until we get image size.
+        if (!imageSizeAvilable() && data != null && dataSize > probedDataSize) {
+            probedDataSize = dataSize;
+            readImageSize();
+            if (!imageSizeAvilable()) {
+                if (decoderStarted != null && decoderStarted.get()) {
+                    // The background decoder reports the size while decoding
+                    // the complete data, so don't decode it a second time.
+                    // One still in the queue may wait behind the decoders of
+                    // many other images, so it is not waited for.
+                    getDecodedFrames();
+                } else {
+                    loadFrames();
+                }
+            }
+        }
         size[0] = imageWidth;
         size[1] = imageHeight;
         if (log.isLoggable(Level.FINE)) {
@@ -244,19 +445,31 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     }
 
     @Override protected int getFrameCount() {
+        // Images that cannot be animated have a single frame, which
+        // is decoded later at the size it is drawn at.
+        if (canSubsample()) {
+            return 1;
+        }
         // Initiate full decode to get frame count.
         // NOTE: This method will be called just before
         // rendering the given image, so there will not
         // be any performance degrade while initiating a
         // full decode.
         if (fullDataReceived) {
-            getImageFrame(0);
+            getImageFrame(0, 0);
         }
         return frameCount;
     }
 
     @Override protected WCImageFrame getFrame(int idx, int[] data) {
-        ImageFrame frame = getImageFrame(idx);
+        return getFrame(idx, 0, data);
+    }
+
+    @Override protected WCImageFrame getFrame(int idx, int subsamplingLevel, int[] data) {
+        if (!canSubsample()) {
+            subsamplingLevel = 0;
+        }
+        ImageFrame frame = getImageFrame(idx, subsamplingLevel);
         if (frame != null) {
             if (log.isLoggable(Level.FINE)) {
                 ImageStorage.ImageType type = frame.getImageType();
@@ -277,11 +490,15 @@ final class WCImageDecoderImpl extends WCImageDecoder {
                 data[2] = img.getHeight();
                 data[3] = dur;
                 data[4] = 1;  /// hasAlpha
+                if (data.length > 5) {
+                    data[5] = framesDecoded ? framesSubsamplingLevel : 0;
+                }
 
                 if (log.isLoggable(Level.FINE)) {
                     log.fine(String.format(
-                            "%X getFrame(%d): complete=%d, size=%dx%d, duration=%d, hasAlpha=%d",
-                            hashCode(), idx, data[0], data[1], data[2], data[3], data[4]));
+                            "%X getFrame(%d, %d): complete=%d, size=%dx%d, duration=%d, hasAlpha=%d",
+                            hashCode(), idx, subsamplingLevel,
+                            data[0], data[1], data[2], data[3], data[4]));
                 }
             }
             return new Frame(img);
@@ -292,12 +509,23 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         return null;
     }
 
-    private ImageFrame getImageFrame(int idx) {
+    private ImageFrame getImageFrame(int idx, int subsamplingLevel) {
         if (!fullDataReceived) {
             startLoader();
-        } else if (fullDataReceived && !framesDecoded) {
+        } else if (!framesDecoded || framesSubsamplingLevel != subsamplingLevel) {
             destroyLoader();
-            setFrames(loadFrames()); // re-decode frames if they have been destroyed
+            ImageFrame[] decodedFrames = null;
+            if (subsamplingLevel == 0) {
+                decodedFrames = getDecodedFrames();
+            }
+            destroyDecoder();
+            if (decodedFrames == null) {
+                // re-decode frames if they have been destroyed
+                // or are needed at another size
+                decodedFrames = loadFrames(data, dataSize, subsamplingLevel);
+            }
+            setFrames(decodedFrames);
+            framesSubsamplingLevel = subsamplingLevel;
             framesDecoded = true;
         }
         return (idx >= 0) && (this.frames != null) && (this.frames.length > idx)
@@ -305,6 +533,24 @@ final class WCImageDecoderImpl extends WCImageDecoder {
                 : null;
     }
 
+    /*
+     * Waits for the background decoder and returns its frames, or null
+     * if there is none, it failed, or its frames have been dropped.
+     */
+    private ImageFrame[] getDecodedFrames() {
+        if (decoder == null) {
+            return null;
+        }
+        try {
+            return decoder.get().get();
+        } catch (InterruptedException | ExecutionException e) {
+            if (log.isLoggable(Level.FINE)) {
+                log.log(Level.FINE, String.format("%X Background decoding failed", hashCode()), e);
+            }
+            return null;
+        }
+    }
+
     private PrismImage getPrismImage(int idx, ImageFrame frame) {
         if (this.images == null) {
             this.images = new PrismImage[this.frames.length];
@@ -314,4 +560,73 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         }
         return this.images[idx];
     }
+
+    /*
+     * Decode times per image format, logged at FINE level.
+     */
+    private static final class DecodeStatistics {
+        private static final Map<String, DecodeStatistics> byFormat =
+                new ConcurrentHashMap<>();
+
+        private final AtomicLong count = new AtomicLong();
+        private final AtomicLong totalNanos = new AtomicLong();
+
+        private static void record(byte[] data, int dataSize, long nanos, int decoderHash) {
+            if (!log.isLoggable(Level.FINE)) {
+                return;
+            }
+            String format = formatOf(data, dataSize);
+            DecodeStatistics statistics =
+                    byFormat.computeIfAbsent(format, f -> new DecodeStatistics());
+            long count = statistics.count.incrementAndGet();
+            long totalNanos = statistics.totalNanos.addAndGet(nanos);
+            log.fine(String.format(
+                    "%X Decoded %d bytes of %s in %.3f ms (%d %s images, %.3f ms on average)",
+                    decoderHash, dataSize, format, nanos / 1e6,
+                    count, format, totalNanos / 1e6 / count));
+        }
+
+        private static String formatOf(byte[] data, int dataSize) {
+            if (data == null) {
+                return "other";
+            }
+            if (dataSize >= 8 && data[0] == (byte) 0x89 && data[1] == 'P'
+                    && data[2] == 'N' && data[3] == 'G') {
+                return "PNG";
+            }
+            if (dataSize >= 3 && data[0] == (byte) 0xFF && data[1] == (byte) 0xD8
+                    && data[2] == (byte) 0xFF) {
+                return "JPEG";
+            }
+            if (dataSize >= 6 && data[0] == 'G' && data[1] == 'I' && data[2] == 'F') {
+                return "GIF";
+            }
+            if (dataSize >= 2 && data[0] == 'B' && data[1] == 'M') {
+                return "BMP";
+            }
+            return "other";
+        }
+    }
+
+    private static final class DecoderThreadFactory implements ThreadFactory {
+        private final ThreadGroup group;
+        private final AtomicInteger index = new AtomicInteger(1);
+
+        private DecoderThreadFactory() {
+            SecurityManager sm = System.getSecurityManager();
+            group = (sm != null) ? sm.getThreadGroup()
+                    : Thread.currentThread().getThreadGroup();
+        }
+
+        @Override
+        public Thread newThread(Runnable r) {
+            Thread t = new Thread(group, r, "WCImageDecoder-"
+                    + index.getAndIncrement());
+            t.setDaemon(true);
+            if (t.getPriority() != Thread.NORM_PRIORITY) {
+                t.setPriority(Thread.NORM_PRIORITY);
+            }
+            return t;
+        }
+    }
 }
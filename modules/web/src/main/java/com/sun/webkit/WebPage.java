@@ -2465,6 +2465,88 @@ public final class WebPage {
         return result;
     }
 
+    // ---- JAVASCRIPT PROFILING SUPPORT ---- //
+
+    /**
+     * Starts sampling the JavaScript stacks of all pages, taking one sample
+     * every {@code intervalMicros} microseconds (a non-positive value keeps
+     * the current interval). Returns {@code false} if this build does not
+     * include the sampling profiler.
+     */
+    public static boolean startJavaScriptSampling(int intervalMicros) {
+        Invoker.getInvoker().checkEventThread();
+        log.log(Level.FINE, "Starting JavaScript sampling profiler");
+        return twkStartJavaScriptSampling(intervalMicros);
+    }
+
+    /**
+     * Stops the JavaScript sampling profiler and returns the samples taken
+     * since it was started, in the folded format understood by flame graph
+     * tools: one {@code outermost;...;innermost count} line per distinct
+     * stack. Returns {@code null} if the profiler was never started.
+     */
+    public static String stopJavaScriptSampling(boolean includeBytecodeOffsets) {
+        Invoker.getInvoker().checkEventThread();
+        log.log(Level.FINE, "Stopping JavaScript sampling profiler");
+        return twkStopJavaScriptSampling(includeBytecodeOffsets);
+    }
+
+    // ---- JAVASCRIPT HEAP POLICY ---- //
+
+    /**
+     * Bounds the JavaScript heap. All pages share one heap, so the budget
+     * applies to them together. The heap is not collected before it reaches
+     * {@code targetHeapSize} bytes, and after a full collection it may grow
+     * to {@code growthFactor} times its live size before the next one. Once
+     * the live size approaches {@code hardLimit} bytes every collection is a
+     * full one, and if a full collection cannot get the heap back under it
+     * the running script gets an out of memory error. A non-positive value
+     * (or a growth factor of at most 1) keeps the default for that setting.
+     * Code compiled before the first hard limit is set does not check it.
+     */
+    public static void setJavaScriptHeapPolicy(long targetHeapSize,
+                                               double growthFactor,
+                                               long hardLimit)
+    {
+        Invoker.getInvoker().checkEventThread();
+        log.log(Level.FINE, "Setting JavaScript heap policy: target={0}, "
+                + "growth={1}, limit={2}",
+                new Object[] {targetHeapSize, growthFactor, hardLimit});
+        twkSetJavaScriptHeapPolicy(targetHeapSize, growthFactor, hardLimit);
+    }
+
+    /**
+     * Tells the JavaScript engine that the application expects to be idle
+     * for {@code idleMillis} milliseconds, so that it can run a collection
+     * that is expected to finish in that time. Returns {@code true} if it
+     * collected.
+     */
+    public static boolean collectJavaScriptGarbageWhenIdle(int idleMillis) {
+        Invoker.getInvoker().checkEventThread();
+        return twkCollectJavaScriptGarbageWhenIdle(idleMillis);
+    }
+
+    /**
+     * Returns {@code true} if the last full collection left the JavaScript
+     * heap over the hard limit set with {@link #setJavaScriptHeapPolicy}.
+     */
+    public static boolean hasJavaScriptHeapExceededLimit() {
+        Invoker.getInvoker().checkEventThread();
+        return twkHasJavaScriptHeapExceededLimit();
+    }
+
+    // ---- JAVA BRIDGE ---- //
+
+    /**
+     * Returns statistics on the cache of reflected classes of the Java
+     * objects exposed to JavaScript, as {@code {hits, misses, nanos}}: the
+     * number of objects whose class was found in the cache, the number whose
+     * class had to be reflected, and the reflection time the hits saved.
+     */
+    public static long[] getJavaClassCacheStatistics() {
+        return twkGetJavaClassCacheStatistics();
+    }
+
     // ---- DumpRenderTree support ---- //
 
     public static int getWorkerThreadCount() {
@@ -2646,4 +2728,12 @@ public final class WebPage {
     private native void twkDispatchInspectorMessageFromFrontend(long pPage,
                                                                 String message);
     private static native void twkDoJSCGarbageCollection();
+    private static native boolean twkStartJavaScriptSampling(int intervalMicros);
+    private static native String twkStopJavaScriptSampling(boolean includeBytecodeOffsets);
+    private static native void twkSetJavaScriptHeapPolicy(long targetHeapSize,
+                                                          double growthFactor,
+                                                          long hardLimit);
+    private static native boolean twkCollectJavaScriptGarbageWhenIdle(int idleMillis);
+    private static native boolean twkHasJavaScriptHeapExceededLimit();
+    private static native long[] twkGetJavaClassCacheStatistics();
 }
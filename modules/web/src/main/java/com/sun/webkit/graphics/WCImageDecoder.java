@@ -25,6 +25,7 @@
 
 package com.sun.webkit.graphics;
 
+import java.nio.ByteBuffer;
 
 public abstract class WCImageDecoder {
 
@@ -36,6 +37,19 @@ public abstract class WCImageDecoder {
      */
     protected abstract void addImageData(byte[] data);
 
+    /**
+     * Receives a portion of image data in a direct buffer that wraps
+     * native memory and is only valid for the duration of the call.
+     * The default implementation copies it into an array.
+     *
+     * @param data  a portion of image data
+     */
+    protected void addImageData(ByteBuffer data) {
+        byte[] array = new byte[data.remaining()];
+        data.get(array);
+        addImageData(array);
+    }
+
     /**
      * Returns image size.
      * @param size a buffer of size 2.
@@ -61,6 +75,21 @@ public abstract class WCImageDecoder {
      */
     protected abstract WCImageFrame getFrame(int idx, int[] data);
 
+    /*
+     * Returns image frame at the specified index, decoded at a reduced
+     * size when the subsampling level is positive: each level halves the
+     * frame width and height, rounding up. The [data] parameter is either
+     * null or an array of size 6, filled as described above and with the
+     * subsampling level the frame was actually decoded at. The default
+     * implementation always decodes frames at full size.
+     */
+    protected WCImageFrame getFrame(int idx, int subsamplingLevel, int[] data) {
+        if (data != null && data.length > 5) {
+            data[5] = 0;
+        }
+        return getFrame(idx, data);
+    }
+
     protected abstract void loadFromResource(String name);
 
     protected abstract void destroy();
@@ -0,0 +1,101 @@
+#!/usr/bin/python
+
+# Copyright (C) 2016 Apple Inc. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+# THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+# THE POSSIBILITY OF SUCH DAMAGE.
+
+# Converts a heap snapshot streamed by HeapSnapshotBuilder (one JSON value per
+# line, cells named by address) to the JSON format of HeapSnapshotBuilder::json()
+# that the Web Inspector loads. Nodes are numbered in the order they were
+# streamed, and edges to cells missing from the stream are dropped.
+#
+# Usage: convert-heap-snapshot-stream.py <streamed snapshot> [<output file>]
+
+import json
+import sys
+
+
+def convert(input, output):
+    header = json.loads(input.readline())
+    if header.get("version") != 1:
+        raise Exception("Unsupported heap snapshot version: %r" % header.get("version"))
+
+    nodeClassNames = []
+    cellToIdentifier = {}
+    edges = []
+    footer = None
+
+    output.write('{"version":1,"nodes":[[0,0,"<root>"]')
+    for line in input:
+        record = json.loads(line)
+        if isinstance(record, dict):
+            footer = record
+            break
+        if record[0] == "c":
+            index, className = record[1], record[2]
+            nodeClassNames.extend([None] * (index + 1 - len(nodeClassNames)))
+            nodeClassNames[index] = className
+        elif len(record) == 4:
+            cell, size, classNameIndex, internal = record
+            identifier = len(cellToIdentifier) + 1
+            cellToIdentifier[cell] = identifier
+            output.write(",[%d,%d,%d%s]" % (identifier, size, classNameIndex, ",1" if internal else ""))
+        else:
+            edges.append(record)
+
+    if footer is None:
+        raise Exception("Truncated heap snapshot: missing footer")
+    if footer["nodes"] != len(cellToIdentifier) or footer["edges"] != len(edges):
+        raise Exception("Truncated heap snapshot: expected %d nodes and %d edges" % (footer["nodes"], footer["edges"]))
+
+    output.write('],"nodeClassNames":')
+    output.write(json.dumps(nodeClassNames, separators=(",", ":")))
+    output.write(',"edges":[')
+    first = True
+    for fromCell, toCell, edgeType in edges:
+        fromIdentifier = cellToIdentifier.get(fromCell) if fromCell else 0
+        toIdentifier = cellToIdentifier.get(toCell)
+        if fromIdentifier is None or toIdentifier is None:
+            continue
+        output.write("%s[%d,%d,%d]" % ("" if first else ",", fromIdentifier, toIdentifier, edgeType))
+        first = False
+    output.write('],"edgeTypes":')
+    output.write(json.dumps(header["edgeTypes"], separators=(",", ":")))
+    output.write("}\n")
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        sys.stderr.write("Usage: %s <streamed snapshot> [<output file>]\n" % argv[0])
+        return 1
+
+    with open(argv[1], "r") as input:
+        if len(argv) == 3:
+            with open(argv[2], "w") as output:
+                convert(input, output)
+        else:
+            convert(input, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
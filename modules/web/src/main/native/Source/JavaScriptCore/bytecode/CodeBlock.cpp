@@ -49,6 +49,7 @@
 #include "JSFunction.h"
 #include "JSLexicalEnvironment.h"
 #include "JSModuleEnvironment.h"
+#include "LLIntCLoop.h"
 #include "LLIntEntrypoint.h"
 #include "LowLevelInterpreter.h"
 #include "JSCInlines.h"
@@ -2281,6 +2282,11 @@ void CodeBlock::finishCreation(VM& vm, ScriptExecutable* ownerExecutable, Unlink
     if (vm.controlFlowProfiler())
         insertBasicBlockBoundariesForControlFlowProfiler(instructions);
 
+#if !ENABLE(JIT) && ENABLE(COMPUTED_GOTO_OPCODES)
+    if (Options::useCLoopSuperinstructions())
+        CLoop::fuseSuperinstructions(*vm.interpreter, instructions);
+#endif
+
     m_instructions = WTFMove(instructions);
 
     // Perform bytecode liveness analysis to determine which locals are live and should be resumed when executing op_resume.
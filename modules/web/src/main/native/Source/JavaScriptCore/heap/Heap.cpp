@@ -49,6 +49,7 @@
 #include "TypeProfilerLog.h"
 #include "UnlinkedCodeBlock.h"
 #include "VM.h"
+#include "Watchdog.h"
 #include "WeakSetInlines.h"
 #include <algorithm>
 #include <wtf/CurrentTime.h>
@@ -345,6 +346,7 @@ Heap::Heap(VM* vm, HeapType heapType)
     // schedule the timer if we've never done a collection.
     , m_lastFullGCLength(0.01)
     , m_lastEdenGCLength(0.01)
+    , m_lastMarkingLength(0)
     , m_fullActivityCallback(GCActivityCallback::createFullTimer(this))
     , m_edenActivityCallback(GCActivityCallback::createEdenTimer(this))
 #if USE(CF)
@@ -1141,7 +1143,14 @@ NEVER_INLINE void Heap::collectImpl(HeapOperation collectionType, void* stackOri
     stopAllocation();
     flushWriteBarrierBuffer();
 
+    // FIXME: Marking still stops the mutator for the whole mark phase. Draining the mark
+    // stack concurrently with a short final remark needs visitChildren() to tolerate
+    // concurrent butterfly and structure changes, and new objects to be allocated black.
+    // m_lastMarkingLength and the HeapStatistics marking histograms measure what that
+    // would take out of the pause.
+    double markingStartTime = WTF::monotonicallyIncreasingTime();
     markRoots(gcStartTime, stackOrigin, stackTop, calleeSavedRegisters);
+    m_lastMarkingLength = WTF::monotonicallyIncreasingTime() - markingStartTime;
 
     if (m_verifier) {
         m_verifier->gatherLiveObjects(HeapVerifier::Phase::AfterMarking);
@@ -1163,6 +1172,7 @@ NEVER_INLINE void Heap::collectImpl(HeapOperation collectionType, void* stackOri
     removeDeadCompilerWorklistEntries();
     deleteUnmarkedCompiledCode();
     deleteSourceProviderCaches();
+    releaseRopeResolveBuffer();
     removeDeadHeapSnapshotNodes();
     notifyIncrementalSweeper();
     writeBarrierCurrentlyExecutingCodeBlocks();
@@ -1313,6 +1323,17 @@ void Heap::deleteSourceProviderCaches()
     m_vm->clearSourceProviderCaches();
 }
 
+void Heap::releaseRopeResolveBuffer()
+{
+    GCPHASE(ReleaseRopeResolveBuffer);
+    // A string that is being appended to in a loop keeps its buffer across eden collections,
+    // unless no string uses it any more. Full collections always let it go, so that spare
+    // capacity does not stay around once appending has stopped.
+    StringImpl* buffer = m_vm->ropeResolveBuffer.get();
+    if (buffer && (m_operationInProgress == FullCollection || buffer->hasOneRef()))
+        m_vm->releaseRopeResolveBuffer();
+}
+
 void Heap::notifyIncrementalSweeper()
 {
     GCPHASE(NotifyIncrementalSweeper);
@@ -1383,7 +1404,20 @@ void Heap::updateAllocationLimits()
         // To avoid pathological GC churn in very small and very large heaps, we set
         // the new allocation limit based on the current size of the heap, with a
         // fixed minimum.
-        m_maxHeapSize = max(minHeapSize(m_heapType, m_ramSize), proportionalHeapSize(currentHeapSize, m_ramSize));
+        size_t minimumHeapSize = m_policy.targetHeapSize ? m_policy.targetHeapSize : minHeapSize(m_heapType, m_ramSize);
+        size_t grownHeapSize = m_policy.growthFactor ? static_cast<size_t>(m_policy.growthFactor * currentHeapSize) : proportionalHeapSize(currentHeapSize, m_ramSize);
+        m_maxHeapSize = max(minimumHeapSize, grownHeapSize);
+        if (size_t hardLimit = m_policy.hardLimit) {
+            m_maxHeapSize = maxHeapSizeUnderHardLimit(m_maxHeapSize, currentHeapSize);
+            m_hasExceededHardLimit = currentHeapSize > hardLimit;
+            // Only the script that was running gets the error, VMEntryScope drops
+            // it if that script returns before it reaches a watchdog check.
+            m_hasPendingOutOfMemoryError = m_hasExceededHardLimit && m_vm->entryScope;
+            if (m_hasExceededHardLimit) {
+                if (Watchdog* watchdog = m_vm->watchdog())
+                    watchdog->interrupt();
+            }
+        }
         m_maxEdenSize = m_maxHeapSize - currentHeapSize;
         m_sizeAfterLastFullCollect = currentHeapSize;
         m_bytesAbandonedSinceLastFullCollect = 0;
@@ -1407,6 +1441,10 @@ void Heap::updateAllocationLimits()
         // This seems suspect at first, but what it does is ensure that the nursery size is fixed.
         m_maxHeapSize += currentHeapSize - m_sizeAfterLastCollect;
         m_maxEdenSize = m_maxHeapSize - currentHeapSize;
+        // Promoted objects may have pushed us past the hard limit, and only a full collection can
+        // tell whether they are still live.
+        if (m_policy.hardLimit && m_maxHeapSize > m_policy.hardLimit)
+            m_shouldDoFullCollection = true;
         if (m_fullActivityCallback) {
             ASSERT(currentHeapSize >= m_sizeAfterLastFullCollect);
             m_fullActivityCallback->didAllocate(currentHeapSize - m_sizeAfterLastFullCollect);
@@ -1432,6 +1470,7 @@ void Heap::didFinishCollection(double gcStartTime)
 
     if (Options::recordGCPauseTimes())
         HeapStatistics::recordGCPauseTime(gcStartTime, gcEndTime);
+    HeapStatistics::recordGCPause(operation, gcEndTime - gcStartTime, m_lastMarkingLength);
 
     if (Options::useZombieMode())
         zombifyDeadObjects();
@@ -1560,6 +1599,59 @@ void Heap::collectAllGarbageIfNotDoneRecently()
     collectAllGarbage();
 }
 
+bool Heap::collectDuringIdleTime(double idleSeconds)
+{
+    if (isDeferred() || !m_isSafeToCollect || m_operationInProgress != NoOperation)
+        return false;
+
+    // Prefer a full collection when there is garbage in the old generation, or when the
+    // last one left us over the hard limit, and we expect it to finish in time. Otherwise
+    // settle for collecting eden.
+    if ((m_sizeAfterLastCollect + m_bytesAllocatedThisCycle > m_sizeAfterLastFullCollect || m_hasExceededHardLimit)
+        && m_lastFullGCLength <= idleSeconds) {
+        collectAllGarbage();
+        return true;
+    }
+    if (m_bytesAllocatedThisCycle && m_lastEdenGCLength <= idleSeconds) {
+        collect(EdenCollection);
+        return true;
+    }
+    return false;
+}
+
+size_t Heap::maxHeapSizeUnderHardLimit(size_t maxHeapSize, size_t currentHeapSize) const
+{
+    // Leave eden an eighth of the hard limit when there is room for it, so that a heap that
+    // is mostly live objects does not collect on every allocation, but never grow past the
+    // limit to do so. Only a heap that is already at the limit gets a small eden beyond it,
+    // which is enough to reach the next polling check and report the error.
+    size_t hardLimit = m_policy.hardLimit;
+    maxHeapSize = min(max(maxHeapSize, currentHeapSize + hardLimit / 8), hardLimit);
+    return max(maxHeapSize, currentHeapSize + hardLimit / 64);
+}
+
+void Heap::setPolicy(const HeapPolicy& policy)
+{
+    m_policy = policy;
+
+    // Running out of room is reported to the script through the watchdog checks,
+    // which are only compiled in once the VM has a watchdog.
+    if (m_policy.hardLimit)
+        m_vm->ensureWatchdog();
+
+    // Apply the new limits right away rather than after the next full collection.
+    size_t currentHeapSize = m_sizeAfterLastCollect;
+    size_t minimumHeapSize = m_policy.targetHeapSize ? m_policy.targetHeapSize : minHeapSize(m_heapType, m_ramSize);
+    m_maxHeapSize = max(m_maxHeapSize, minimumHeapSize);
+    if (m_policy.hardLimit)
+        m_maxHeapSize = maxHeapSizeUnderHardLimit(m_maxHeapSize, currentHeapSize);
+    m_maxEdenSize = m_maxHeapSize - currentHeapSize;
+    if (!m_policy.hardLimit) {
+        m_hasExceededHardLimit = false;
+        m_hasPendingOutOfMemoryError = false;
+    }
+}
+
 class Zombify : public MarkedBlock::VoidFunctor {
 public:
     inline void visit(JSCell* cell)
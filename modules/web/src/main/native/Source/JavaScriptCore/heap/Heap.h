@@ -83,6 +83,20 @@ typedef HashCountedSet<const char*> TypeCountSet;
 
 enum HeapType { SmallHeap, LargeHeap };
 
+// Lets an embedder bound how large a VM's heap grows. Zero fields keep the
+// defaults derived from the HeapType and the amount of RAM.
+struct HeapPolicy {
+    // Allocation limit below which we never start a full collection.
+    size_t targetHeapSize { 0 };
+    // After a full collection the next one happens once the heap has grown
+    // to this multiple of its live size.
+    double growthFactor { 0 };
+    // Live size the heap may not keep after a full collection. We switch to
+    // full collections as the heap approaches it, and once a full collection
+    // cannot get back under it the running script gets an out of memory error.
+    size_t hardLimit { 0 };
+};
+
 class Heap {
     WTF_MAKE_NONCOPYABLE(Heap);
 public:
@@ -166,6 +180,9 @@ public:
     JS_EXPORT_PRIVATE bool isHeapSnapshotting() const;
 
     JS_EXPORT_PRIVATE void collectAllGarbageIfNotDoneRecently();
+    // Runs the collection that fits in the given idle time, if there is
+    // anything to collect. Returns true if it collected.
+    JS_EXPORT_PRIVATE bool collectDuringIdleTime(double idleSeconds);
     void collectAllGarbage() { collectAndSweep(FullCollection); }
     JS_EXPORT_PRIVATE void collectAndSweep(HeapOperation collectionType = AnyCollection);
     bool shouldCollect();
@@ -212,6 +229,7 @@ public:
 
     double lastFullGCLength() const { return m_lastFullGCLength; }
     double lastEdenGCLength() const { return m_lastEdenGCLength; }
+    double lastMarkingLength() const { return m_lastMarkingLength; }
     void increaseLastFullGCLength(double amount) { m_lastFullGCLength += amount; }
 
     size_t sizeBeforeLastEdenCollection() const { return m_sizeBeforeLastEdenCollect; }
@@ -219,6 +237,19 @@ public:
     size_t sizeBeforeLastFullCollection() const { return m_sizeBeforeLastFullCollect; }
     size_t sizeAfterLastFullCollection() const { return m_sizeAfterLastFullCollect; }
 
+    const HeapPolicy& policy() const { return m_policy; }
+    JS_EXPORT_PRIVATE void setPolicy(const HeapPolicy&);
+    bool hasExceededHardLimit() const { return m_hasExceededHardLimit; }
+    // Returns true once for every full collection that left the heap over the
+    // hard limit, so that the script that was running gets a single error.
+    bool takePendingOutOfMemoryError()
+    {
+        bool pending = m_hasPendingOutOfMemoryError;
+        m_hasPendingOutOfMemoryError = false;
+        return pending;
+    }
+    void clearPendingOutOfMemoryError() { m_hasPendingOutOfMemoryError = false; }
+
     void deleteAllCodeBlocks();
     void deleteAllUnlinkedCodeBlocks();
 
@@ -329,6 +360,7 @@ private:
     void sweepArrayBuffers();
     void snapshotMarkedSpace();
     void deleteSourceProviderCaches();
+    void releaseRopeResolveBuffer();
     void removeDeadHeapSnapshotNodes();
     void notifyIncrementalSweeper();
     void writeBarrierCurrentlyExecutingCodeBlocks();
@@ -340,6 +372,7 @@ private:
     void deleteUnmarkedCompiledCode();
     JS_EXPORT_PRIVATE void addToRememberedSet(const JSCell*);
     void updateAllocationLimits();
+    size_t maxHeapSizeUnderHardLimit(size_t maxHeapSize, size_t currentHeapSize) const;
     void didFinishCollection(double gcStartTime);
     void resumeCompilerThreads();
     void zombifyDeadObjects();
@@ -374,6 +407,9 @@ private:
     size_t m_maxEdenSize;
     size_t m_maxHeapSize;
     bool m_shouldDoFullCollection;
+    HeapPolicy m_policy;
+    bool m_hasExceededHardLimit { false };
+    bool m_hasPendingOutOfMemoryError { false };
     size_t m_totalBytesVisited;
     size_t m_totalBytesVisitedThisCycle;
     size_t m_totalBytesCopied;
@@ -417,6 +453,7 @@ private:
     VM* m_vm;
     double m_lastFullGCLength;
     double m_lastEdenGCLength;
+    double m_lastMarkingLength;
 
     Vector<ExecutableBase*> m_executables;
 
@@ -33,8 +33,15 @@
 #include "JSCInlines.h"
 #include "JSCell.h"
 #include "VM.h"
+#include <errno.h>
 #include <wtf/text/StringBuilder.h>
 
+#if OS(WINDOWS)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace JSC {
 
 unsigned HeapSnapshotBuilder::nextAvailableObjectIdentifier = 1;
@@ -45,12 +52,56 @@ HeapSnapshotBuilder::HeapSnapshotBuilder(HeapProfiler& profiler)
 {
 }
 
+// Streamed snapshots are written whenever this much is buffered.
+static const size_t streamFlushSize = 64 * KB;
+
+HeapSnapshotBuilder::HeapSnapshotBuilder(HeapProfiler& profiler, int outputFileDescriptor)
+    : m_profiler(profiler)
+    , m_outputFileDescriptor(outputFileDescriptor)
+{
+    ASSERT(outputFileDescriptor >= 0);
+    m_streamBuffer.reserveInitialCapacity(streamFlushSize * 2);
+}
+
 HeapSnapshotBuilder::~HeapSnapshotBuilder()
 {
 }
 
+static void appendToStream(Vector<char>& buffer, const char* characters)
+{
+    buffer.append(characters, strlen(characters));
+}
+
+static void appendNumberToStream(Vector<char>& buffer, uint64_t number)
+{
+    char digits[20];
+    unsigned length = 0;
+    do {
+        digits[length++] = '0' + number % 10;
+        number /= 10;
+    } while (number);
+    while (length)
+        buffer.append(digits[--length]);
+}
+
 void HeapSnapshotBuilder::buildSnapshot()
 {
+    if (isStreaming()) {
+        appendToStream(m_streamBuffer, "{\"version\":1,\"edgeTypes\":[\"Internal\",\"Property\",\"Index\",\"Variable\"]}\n");
+        {
+            m_profiler.setActiveSnapshotBuilder(this);
+            m_profiler.vm().heap.collectAllGarbage();
+            m_profiler.setActiveSnapshotBuilder(nullptr);
+        }
+        appendToStream(m_streamBuffer, "{\"nodes\":");
+        appendNumberToStream(m_streamBuffer, m_streamedNodeCount);
+        appendToStream(m_streamBuffer, ",\"edges\":");
+        appendNumberToStream(m_streamBuffer, m_streamedEdgeCount);
+        appendToStream(m_streamBuffer, "}\n");
+        flushStream();
+        return;
+    }
+
     m_snapshot = std::make_unique<HeapSnapshot>(m_profiler.mostRecentSnapshot());
     {
         m_profiler.setActiveSnapshotBuilder(this);
@@ -67,6 +118,11 @@ void HeapSnapshotBuilder::appendNode(JSCell* cell)
     ASSERT(m_profiler.activeSnapshotBuilder() == this);
     ASSERT(Heap::isMarked(cell));
 
+    if (isStreaming()) {
+        appendStreamedNode(cell);
+        return;
+    }
+
     if (hasExistingNodeForCell(cell))
         return;
 
@@ -84,6 +140,11 @@ void HeapSnapshotBuilder::appendEdge(JSCell* from, JSCell* to)
     if (from == to)
         return;
 
+    if (isStreaming()) {
+        appendStreamedEdge(from, to);
+        return;
+    }
+
     std::lock_guard<Lock> lock(m_appendingEdgeMutex);
 
     m_edges.append(HeapSnapshotEdge(from, to));
@@ -97,6 +158,101 @@ bool HeapSnapshotBuilder::hasExistingNodeForCell(JSCell* cell)
     return !!m_snapshot->previous()->nodeForCell(cell);
 }
 
+// Streamed Heap Snapshot Format:
+//
+//   One JSON value per line. A header, then records in the order the collector
+//   visited the cells, then a footer with the record counts:
+//
+//      {"version":1,"edgeTypes":["Internal","Property","Index","Variable"]}
+//      ["c",<nodeClassNameIndex>,"<className>"]                 class name, before its first use
+//      [<cellAddress>,<sizeInBytes>,<nodeClassNameIndex>,<internal>]   node
+//      [<fromCellAddress>,<toCellAddress>,<edgeTypeIndex>]        edge, from 0 for roots
+//      {"nodes":<nodeCount>,"edges":<edgeCount>}
+//
+//   Cells are named by address because an edge is usually recorded before the
+//   cell it points to. Scripts/convert-heap-snapshot-stream.py numbers the nodes
+//   and writes the JSON format below.
+
+void HeapSnapshotBuilder::appendStreamedNode(JSCell* cell)
+{
+    const char* className = cell->classInfo()->className;
+    size_t sizeInBytes = cell->estimatedSizeInBytes();
+    bool isInternal = false;
+    if (!cell->isString()) {
+        Structure* structure = cell->structure(m_profiler.vm());
+        isInternal = !structure || !structure->globalObject();
+    }
+
+    std::lock_guard<Lock> lock(m_streamMutex);
+
+    unsigned nextClassNameIndex = m_streamedClassNames.size();
+    auto result = m_streamedClassNames.add(className, nextClassNameIndex);
+    if (result.isNewEntry) {
+        StringBuilder quotedClassName;
+        quotedClassName.appendQuotedJSONString(className);
+        CString utf8 = quotedClassName.toString().utf8();
+        appendToStream(m_streamBuffer, "[\"c\",");
+        appendNumberToStream(m_streamBuffer, nextClassNameIndex);
+        m_streamBuffer.append(',');
+        m_streamBuffer.append(utf8.data(), utf8.length());
+        appendToStream(m_streamBuffer, "]\n");
+    }
+
+    m_streamBuffer.append('[');
+    appendNumberToStream(m_streamBuffer, reinterpret_cast<uintptr_t>(cell));
+    m_streamBuffer.append(',');
+    appendNumberToStream(m_streamBuffer, sizeInBytes);
+    m_streamBuffer.append(',');
+    appendNumberToStream(m_streamBuffer, result.iterator->value);
+    appendToStream(m_streamBuffer, isInternal ? ",1]\n" : ",0]\n");
+    m_streamedNodeCount++;
+
+    flushStreamIfNeeded();
+}
+
+void HeapSnapshotBuilder::appendStreamedEdge(JSCell* from, JSCell* to)
+{
+    std::lock_guard<Lock> lock(m_streamMutex);
+
+    m_streamBuffer.append('[');
+    appendNumberToStream(m_streamBuffer, reinterpret_cast<uintptr_t>(from));
+    m_streamBuffer.append(',');
+    appendNumberToStream(m_streamBuffer, reinterpret_cast<uintptr_t>(to));
+    m_streamBuffer.append(',');
+    appendNumberToStream(m_streamBuffer, static_cast<uint8_t>(EdgeType::Internal));
+    appendToStream(m_streamBuffer, "]\n");
+    m_streamedEdgeCount++;
+
+    flushStreamIfNeeded();
+}
+
+void HeapSnapshotBuilder::flushStreamIfNeeded()
+{
+    if (m_streamBuffer.size() >= streamFlushSize)
+        flushStream();
+}
+
+void HeapSnapshotBuilder::flushStream()
+{
+    const char* data = m_streamBuffer.data();
+    size_t remaining = m_streamBuffer.size();
+    while (remaining && !m_streamFailed) {
+#if OS(WINDOWS)
+        int written = _write(m_outputFileDescriptor, data, remaining);
+#else
+        ssize_t written = write(m_outputFileDescriptor, data, remaining);
+#endif
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            m_streamFailed = true;
+            break;
+        }
+        data += written;
+        remaining -= written;
+    }
+    m_streamBuffer.shrink(0);
+}
 
 // Heap Snapshot JSON Format:
 //
@@ -148,6 +304,8 @@ String HeapSnapshotBuilder::json()
 
 String HeapSnapshotBuilder::json(std::function<bool (const HeapSnapshotNode&)> allowNodeCallback)
 {
+    ASSERT(!isStreaming());
+
     VM& vm = m_profiler.vm();
     DeferGCForAWhile deferGC(vm.heap);
 
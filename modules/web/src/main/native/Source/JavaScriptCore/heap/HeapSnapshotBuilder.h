@@ -27,6 +27,7 @@
 #define HeapSnapshotBuilder_h
 
 #include <functional>
+#include <wtf/HashMap.h>
 #include <wtf/Lock.h>
 #include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
@@ -71,6 +72,10 @@ class JS_EXPORT_PRIVATE HeapSnapshotBuilder {
     WTF_MAKE_FAST_ALLOCATED;
 public:
     HeapSnapshotBuilder(HeapProfiler&);
+    // Writes the snapshot to the file descriptor in chunks while the collector
+    // marks, instead of keeping it in memory. The snapshot is not added to the
+    // profiler and json() is not available.
+    HeapSnapshotBuilder(HeapProfiler&, int outputFileDescriptor);
     ~HeapSnapshotBuilder();
 
     static unsigned nextAvailableObjectIdentifier;
@@ -88,7 +93,16 @@ public:
     String json();
     String json(std::function<bool (const HeapSnapshotNode&)> allowNodeCallback);
 
+    bool isStreaming() const { return m_outputFileDescriptor != -1; }
+    // False if writing a streamed snapshot to its file descriptor failed.
+    bool didStreamSuccessfully() const { return !m_streamFailed; }
+
 private:
+    void appendStreamedNode(JSCell*);
+    void appendStreamedEdge(JSCell* from, JSCell* to);
+    void flushStreamIfNeeded();
+    void flushStream();
+
     // Finalized snapshots are not modified during building. So searching them
     // for an existing node can be done concurrently without a lock.
     bool hasExistingNodeForCell(JSCell*);
@@ -100,6 +114,16 @@ private:
     std::unique_ptr<HeapSnapshot> m_snapshot;
     Lock m_appendingEdgeMutex;
     Vector<HeapSnapshotEdge> m_edges;
+
+    // Streaming state, guarded by m_streamMutex. Only the class name table
+    // grows with the heap, so memory use is bounded by the number of classes.
+    int m_outputFileDescriptor { -1 };
+    Lock m_streamMutex;
+    Vector<char> m_streamBuffer;
+    HashMap<const char*, unsigned> m_streamedClassNames;
+    size_t m_streamedNodeCount { 0 };
+    size_t m_streamedEdgeCount { 0 };
+    bool m_streamFailed { false };
 };
 
 } // namespace JSC
@@ -34,6 +34,8 @@
 #include <stdlib.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/DataLog.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
 #include <wtf/StdLibExtras.h>
 
 #if OS(UNIX)
@@ -99,6 +101,8 @@ void HeapStatistics::logStatistics()
         }
         dataLogF("], \"start_time\": %f, \"end_time\": %f", s_startTime, s_endTime);
     }
+    dataLogF(", \"pause_histograms\": ");
+    dumpPauseHistograms(WTF::dataFile());
     dataLogF("}\n");
 }
 
@@ -142,6 +146,105 @@ void HeapStatistics::reportSuccess()
 
 #endif // OS(UNIX)
 
+void GCPauseHistogram::add(double milliseconds)
+{
+    unsigned index = 0;
+    while (index < numberOfBuckets - 1 && milliseconds >= bucketUpperBound(index))
+        ++index;
+    ++m_buckets[index];
+    ++m_count;
+    m_totalMilliseconds += milliseconds;
+    m_maxMilliseconds = std::max(m_maxMilliseconds, milliseconds);
+}
+
+double GCPauseHistogram::bucketUpperBound(unsigned index)
+{
+    if (index >= numberOfBuckets - 1)
+        return std::numeric_limits<double>::infinity();
+    return static_cast<double>(1u << index);
+}
+
+double GCPauseHistogram::percentile(double fraction) const
+{
+    unsigned seen = 0;
+    for (unsigned index = 0; index < numberOfBuckets; ++index) {
+        seen += m_buckets[index];
+        if (seen && seen >= fraction * m_count)
+            return std::min(bucketUpperBound(index), m_maxMilliseconds);
+    }
+    return m_maxMilliseconds;
+}
+
+void GCPauseHistogram::dump(PrintStream& out) const
+{
+    out.printf("{\"count\": %u, \"total_ms\": %.3f, \"max_ms\": %.3f, \"p50_ms\": %.3f, \"p99_ms\": %.3f, \"buckets\": [",
+        m_count, m_totalMilliseconds, m_maxMilliseconds, percentile(0.5), percentile(0.99));
+    for (unsigned index = 0; index < numberOfBuckets; ++index)
+        out.printf(index ? ", %u" : "%u", m_buckets[index]);
+    out.printf("]}");
+}
+
+namespace {
+
+struct PauseHistograms {
+    Lock lock;
+    GCPauseHistogram edenPauses;
+    GCPauseHistogram fullPauses;
+    GCPauseHistogram edenMarking;
+    GCPauseHistogram fullMarking;
+};
+
+PauseHistograms& pauseHistograms()
+{
+    static NeverDestroyed<PauseHistograms> histograms;
+    return histograms;
+}
+
+} // anonymous namespace
+
+void HeapStatistics::recordGCPause(HeapOperation operation, double pauseSeconds, double markingSeconds)
+{
+    ASSERT(operation == EdenCollection || operation == FullCollection);
+    PauseHistograms& histograms = pauseHistograms();
+    LockHolder locker(histograms.lock);
+    if (operation == FullCollection) {
+        histograms.fullPauses.add(pauseSeconds * 1000);
+        histograms.fullMarking.add(markingSeconds * 1000);
+    } else {
+        histograms.edenPauses.add(pauseSeconds * 1000);
+        histograms.edenMarking.add(markingSeconds * 1000);
+    }
+}
+
+GCPauseHistogram HeapStatistics::pauseHistogram(HeapOperation operation)
+{
+    PauseHistograms& histograms = pauseHistograms();
+    LockHolder locker(histograms.lock);
+    return operation == FullCollection ? histograms.fullPauses : histograms.edenPauses;
+}
+
+GCPauseHistogram HeapStatistics::markingHistogram(HeapOperation operation)
+{
+    PauseHistograms& histograms = pauseHistograms();
+    LockHolder locker(histograms.lock);
+    return operation == FullCollection ? histograms.fullMarking : histograms.edenMarking;
+}
+
+void HeapStatistics::dumpPauseHistograms(PrintStream& out)
+{
+    PauseHistograms& histograms = pauseHistograms();
+    LockHolder locker(histograms.lock);
+    out.print("{\"eden_pauses\": ");
+    histograms.edenPauses.dump(out);
+    out.print(", \"eden_marking\": ");
+    histograms.edenMarking.dump(out);
+    out.print(", \"full_pauses\": ");
+    histograms.fullPauses.dump(out);
+    out.print(", \"full_marking\": ");
+    histograms.fullMarking.dump(out);
+    out.print("}");
+}
+
 class StorageStatistics : public MarkedBlock::VoidFunctor {
 public:
     StorageStatistics();
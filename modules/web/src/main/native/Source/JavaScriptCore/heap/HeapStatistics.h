@@ -26,13 +26,42 @@
 #ifndef HeapStatistics_h
 #define HeapStatistics_h
 
+#include "HeapOperation.h"
 #include "JSExportMacros.h"
+#include <array>
+#include <wtf/PrintStream.h>
 #include <wtf/Vector.h>
 
 namespace JSC {
 
 class Heap;
 
+// Counts GC pauses by length. Bucket 0 holds pauses shorter than 1ms, bucket i
+// holds pauses of [2^(i-1), 2^i) ms and the last bucket holds everything longer.
+class GCPauseHistogram {
+public:
+    static const unsigned numberOfBuckets = 16;
+
+    void add(double milliseconds);
+
+    unsigned count() const { return m_count; }
+    unsigned bucket(unsigned index) const { return m_buckets[index]; }
+    double totalMilliseconds() const { return m_totalMilliseconds; }
+    double maxMilliseconds() const { return m_maxMilliseconds; }
+    static double bucketUpperBound(unsigned index);
+
+    // An upper bound on the pause length that the given fraction of pauses stay under.
+    double percentile(double fraction) const;
+
+    void dump(PrintStream&) const;
+
+private:
+    std::array<unsigned, numberOfBuckets> m_buckets {{ }};
+    unsigned m_count { 0 };
+    double m_totalMilliseconds { 0 };
+    double m_maxMilliseconds { 0 };
+};
+
 class HeapStatistics {
 public:
     NO_RETURN static void exitWithFailure();
@@ -41,6 +70,13 @@ public:
     static void initialize();
     static void recordGCPauseTime(double start, double end);
 
+    // Every collection of every heap in the process is recorded, both for the whole
+    // pause and for the marking part of it.
+    static void recordGCPause(HeapOperation, double pauseSeconds, double markingSeconds);
+    JS_EXPORT_PRIVATE static GCPauseHistogram pauseHistogram(HeapOperation);
+    JS_EXPORT_PRIVATE static GCPauseHistogram markingHistogram(HeapOperation);
+    JS_EXPORT_PRIVATE static void dumpPauseHistograms(PrintStream&);
+
     static void dumpObjectStatistics(Heap*);
 
 private:
@@ -313,6 +313,12 @@ void Interpreter::initialize()
     m_opcodeTable = LLInt::opcodeMap();
     for (int i = 0; i < numOpcodeIDs; ++i)
         m_opcodeIDTable.add(m_opcodeTable[i], static_cast<OpcodeID>(i));
+#if !ENABLE(JIT)
+#define MAP_CLOOP_SUPERINSTRUCTION(superinstruction, opcode) \
+    m_opcodeIDTable.set(m_opcodeTable[superinstruction], opcode);
+    FOR_EACH_CLOOP_SUPERINSTRUCTION(MAP_CLOOP_SUPERINSTRUCTION)
+#undef MAP_CLOOP_SUPERINSTRUCTION
+#endif
 #endif
 
 #if !ASSERT_DISABLED
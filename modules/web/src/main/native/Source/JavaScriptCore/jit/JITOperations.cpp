@@ -1049,6 +1049,8 @@ UnusedPtr JIT_OPERATION operationHandleWatchdogTimer(ExecState* exec)
 
     if (UNLIKELY(vm.shouldTriggerTermination(exec)))
         vm.throwException(exec, createTerminatedExecutionException(&vm));
+    else if (UNLIKELY(vm.heap.takePendingOutOfMemoryError()))
+        vm.throwException(exec, createOutOfMemoryError(exec));
 
     return nullptr;
 }
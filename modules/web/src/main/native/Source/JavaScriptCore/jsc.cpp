@@ -49,6 +49,7 @@
 #include "JSProxy.h"
 #include "JSString.h"
 #include "JSWASMModule.h"
+#include "ObjectConstructor.h"
 #include "ProfilerDatabase.h"
 #include "SamplingProfiler.h"
 #include "SamplingTool.h"
@@ -571,6 +572,7 @@ static EncodedJSValue JSC_HOST_CALL functionFullGC(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionEdenGC(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionForceGCSlowPaths(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionHeapSize(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionGCPauseHistogram(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionAddressOf(ExecState*);
 #ifndef NDEBUG
 static EncodedJSValue JSC_HOST_CALL functionDumpCallFrame(ExecState*);
@@ -616,6 +618,7 @@ static EncodedJSValue JSC_HOST_CALL functionLoadModule(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionCheckModuleSyntax(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionPlatformSupportsSamplingProfiler(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionGenerateHeapSnapshot(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionGenerateStreamedHeapSnapshot(ExecState*);
 #if ENABLE(SAMPLING_PROFILER)
 static EncodedJSValue JSC_HOST_CALL functionStartSamplingProfiler(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionSamplingProfilerStackTraces(ExecState*);
@@ -740,6 +743,7 @@ protected:
         addFunction(vm, "edenGC", functionEdenGC, 0);
         addFunction(vm, "forceGCSlowPaths", functionForceGCSlowPaths, 0);
         addFunction(vm, "gcHeapSize", functionHeapSize, 0);
+        addFunction(vm, "gcPauseHistogram", functionGCPauseHistogram, 2);
         addFunction(vm, "addressOf", functionAddressOf, 1);
 #ifndef NDEBUG
         addFunction(vm, "dumpCallFrame", functionDumpCallFrame, 0);
@@ -813,6 +817,7 @@ protected:
 
         addFunction(vm, "platformSupportsSamplingProfiler", functionPlatformSupportsSamplingProfiler, 0);
         addFunction(vm, "generateHeapSnapshot", functionGenerateHeapSnapshot, 0);
+        addFunction(vm, "generateStreamedHeapSnapshot", functionGenerateStreamedHeapSnapshot, 0);
 #if ENABLE(SAMPLING_PROFILER)
         addFunction(vm, "startSamplingProfiler", functionStartSamplingProfiler, 0);
         addFunction(vm, "samplingProfilerStackTraces", functionSamplingProfilerStackTraces, 0);
@@ -1309,6 +1314,32 @@ EncodedJSValue JSC_HOST_CALL functionHeapSize(ExecState* exec)
     return JSValue::encode(jsNumber(exec->heap()->size()));
 }
 
+// gcPauseHistogram(kind, phase) with kind "eden" or "full" and phase "pause" or "marking".
+EncodedJSValue JSC_HOST_CALL functionGCPauseHistogram(ExecState* exec)
+{
+    JSLockHolder lock(exec);
+    String kind = exec->argument(0).toWTFString(exec);
+    String phase = exec->argument(1).toWTFString(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+
+    HeapOperation operation = kind == "full" ? FullCollection : EdenCollection;
+    GCPauseHistogram histogram = phase == "marking" ? HeapStatistics::markingHistogram(operation) : HeapStatistics::pauseHistogram(operation);
+
+    JSArray* buckets = constructEmptyArray(exec, 0);
+    for (unsigned i = 0; i < GCPauseHistogram::numberOfBuckets; ++i)
+        buckets->putDirectIndex(exec, i, jsNumber(histogram.bucket(i)));
+
+    JSObject* result = constructEmptyObject(exec);
+    result->putDirect(exec->vm(), Identifier::fromString(exec, "count"), jsNumber(histogram.count()));
+    result->putDirect(exec->vm(), Identifier::fromString(exec, "totalMilliseconds"), jsNumber(histogram.totalMilliseconds()));
+    result->putDirect(exec->vm(), Identifier::fromString(exec, "maxMilliseconds"), jsNumber(histogram.maxMilliseconds()));
+    result->putDirect(exec->vm(), Identifier::fromString(exec, "p50Milliseconds"), jsNumber(histogram.percentile(0.5)));
+    result->putDirect(exec->vm(), Identifier::fromString(exec, "p99Milliseconds"), jsNumber(histogram.percentile(0.99)));
+    result->putDirect(exec->vm(), Identifier::fromString(exec, "buckets"), buckets);
+    return JSValue::encode(result);
+}
+
 // This function is not generally very helpful in 64-bit code as the tag and payload
 // share a register. But in 32-bit JITed code the tag may not be checked if an
 // optimization removes type checking requirements, such as in ===.
@@ -1747,6 +1778,26 @@ EncodedJSValue JSC_HOST_CALL functionGenerateHeapSnapshot(ExecState* exec)
     return result;
 }
 
+EncodedJSValue JSC_HOST_CALL functionGenerateStreamedHeapSnapshot(ExecState* exec)
+{
+    JSLockHolder lock(exec);
+
+    FILE* file = tmpfile();
+    if (!file)
+        return JSValue::encode(exec->vm().throwException(exec, createError(exec, ASCIILiteral("Could not create a temporary file."))));
+
+    HeapSnapshotBuilder snapshotBuilder(exec->vm().ensureHeapProfiler(), fileno(file));
+    snapshotBuilder.buildSnapshot();
+
+    Vector<char> lines;
+    bool success = snapshotBuilder.didStreamSuccessfully() && fillBufferWithContentsOfFile(file, lines);
+    fclose(file);
+    if (!success)
+        return JSValue::encode(exec->vm().throwException(exec, createError(exec, ASCIILiteral("Could not write the heap snapshot."))));
+
+    return JSValue::encode(jsString(exec, stringFromUTF(lines)));
+}
+
 #if ENABLE(SAMPLING_PROFILER)
 EncodedJSValue JSC_HOST_CALL functionStartSamplingProfiler(ExecState* exec)
 {
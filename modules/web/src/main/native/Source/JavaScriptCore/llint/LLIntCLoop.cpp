@@ -28,6 +28,8 @@
 
 #if !ENABLE(JIT)
 
+#include "Instruction.h"
+#include "Interpreter.h"
 #include "LLIntData.h"
 
 namespace JSC {
@@ -38,6 +40,67 @@ void CLoop::initialize()
     execute(llint_entry, 0, 0, 0, true);
 }
 
+#if ENABLE(COMPUTED_GOTO_OPCODES)
+void CLoop::fuseSuperinstructions(Interpreter& interpreter, RefCountedArray<Instruction>& instructions)
+{
+    size_t instructionCount = instructions.size();
+    auto opcodeIDAt = [&] (size_t index) -> OpcodeID {
+        return interpreter.getOpcodeID(instructions[index].u.opcode);
+    };
+    auto jumpsToLoopHint = [&] (size_t index, int offset) -> bool {
+        size_t target = index + offset;
+        return target < instructionCount && opcodeIDAt(target) == op_loop_hint;
+    };
+
+    for (size_t i = 0; i < instructionCount; ) {
+        OpcodeID opcodeID = opcodeIDAt(i);
+        size_t next = i + opcodeLength(opcodeID);
+        OpcodeID superinstruction = opcodeID;
+
+        switch (opcodeID) {
+        case op_mov:
+            if (next < instructionCount && opcodeIDAt(next) == op_mov)
+                superinstruction = llint_cloop_op_mov_mov;
+            break;
+        case op_get_by_id:
+            if (next < instructionCount && opcodeIDAt(next) == op_call)
+                superinstruction = llint_cloop_op_get_by_id_call;
+            break;
+        case op_put_by_id:
+            if (next < instructionCount && opcodeIDAt(next) == op_put_by_id)
+                superinstruction = llint_cloop_op_put_by_id_put_by_id;
+            break;
+        case op_jless:
+            if (jumpsToLoopHint(i, instructions[i + 3].u.operand))
+                superinstruction = llint_cloop_op_jless_loop_hint;
+            break;
+        case op_jlesseq:
+            if (jumpsToLoopHint(i, instructions[i + 3].u.operand))
+                superinstruction = llint_cloop_op_jlesseq_loop_hint;
+            break;
+        case op_jgreater:
+            if (jumpsToLoopHint(i, instructions[i + 3].u.operand))
+                superinstruction = llint_cloop_op_jgreater_loop_hint;
+            break;
+        case op_jgreatereq:
+            if (jumpsToLoopHint(i, instructions[i + 3].u.operand))
+                superinstruction = llint_cloop_op_jgreatereq_loop_hint;
+            break;
+        case op_jmp:
+            if (jumpsToLoopHint(i, instructions[i + 1].u.operand))
+                superinstruction = llint_cloop_op_jmp_loop_hint;
+            break;
+        default:
+            break;
+        }
+
+        if (superinstruction != opcodeID)
+            instructions[i].u.opcode = getOpcode(superinstruction);
+        i = next;
+    }
+}
+#endif // ENABLE(COMPUTED_GOTO_OPCODES)
+
 } // namespace LLInt
 } // namespace JSC
 
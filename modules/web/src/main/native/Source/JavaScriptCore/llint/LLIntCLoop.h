@@ -32,14 +32,39 @@
 #include "JSCJSValue.h"
 #include "Opcode.h"
 #include "ProtoCallFrame.h"
+#include <wtf/RefCountedArray.h>
+
+#if ENABLE(COMPUTED_GOTO_OPCODES)
+// A superinstruction replaces the opcode of the first instruction of a frequent
+// pair: two consecutive instructions, or a loop back-edge and the op_loop_hint it
+// jumps to. The operands of both instructions stay as they are, so jumping into
+// the middle of a pair still works, and Interpreter::getOpcodeID() reports the
+// replaced opcode so bytecode analyses never see a superinstruction.
+#define FOR_EACH_CLOOP_SUPERINSTRUCTION(macro) \
+    macro(llint_cloop_op_mov_mov, op_mov) \
+    macro(llint_cloop_op_get_by_id_call, op_get_by_id) \
+    macro(llint_cloop_op_put_by_id_put_by_id, op_put_by_id) \
+    macro(llint_cloop_op_jless_loop_hint, op_jless) \
+    macro(llint_cloop_op_jlesseq_loop_hint, op_jlesseq) \
+    macro(llint_cloop_op_jgreater_loop_hint, op_jgreater) \
+    macro(llint_cloop_op_jgreatereq_loop_hint, op_jgreatereq) \
+    macro(llint_cloop_op_jmp_loop_hint, op_jmp)
+#endif
 
 namespace JSC {
+
+class Interpreter;
+struct Instruction;
+
 namespace LLInt {
 
 class CLoop {
 public:
     static void initialize();
     static JSValue execute(OpcodeID entryOpcodeID, void* executableAddress, VM*, ProtoCallFrame*, bool isInitializationPass = false);
+#if ENABLE(COMPUTED_GOTO_OPCODES)
+    static void fuseSuperinstructions(Interpreter&, RefCountedArray<Instruction>&);
+#endif
 };
 
 } } // namespace JSC::LLInt
@@ -566,8 +566,10 @@ LLINT_SLOW_PATH_DECL(slow_path_get_by_id)
         JSCell* baseCell = baseValue.asCell();
         Structure* structure = baseCell->structure();
 
-        // Start out by clearing out the old cache.
-        pc[0].u.opcode = LLInt::getOpcode(op_get_by_id);
+        // Start out by clearing out the old cache. Anything other than op_get_array_length
+        // is already op_get_by_id, or a C loop superinstruction standing in for it.
+        if (pc[0].u.opcode == LLInt::getOpcode(op_get_array_length))
+            pc[0].u.opcode = LLInt::getOpcode(op_get_by_id);
         pc[4].u.pointer = nullptr; // old structure
         pc[5].u.pointer = nullptr; // offset
 
@@ -1367,6 +1369,8 @@ LLINT_SLOW_PATH_DECL(slow_path_handle_watchdog_timer)
     ASSERT(vm.watchdog());
     if (UNLIKELY(vm.shouldTriggerTermination(exec)))
         LLINT_THROW(createTerminatedExecutionException(&vm));
+    if (UNLIKELY(vm.heap.takePendingOutOfMemoryError()))
+        LLINT_THROW(createOutOfMemoryError(exec));
     LLINT_RETURN_TWO(0, exec);
 }
 
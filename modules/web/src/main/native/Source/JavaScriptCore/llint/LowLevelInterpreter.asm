@@ -915,6 +915,10 @@ macro prologue(codeBlockGetter, codeBlockSetter, osrSlowPath, traceSlowPath)
         loadp CodeBlock::m_instructions[t1], PC
     end
 
+    if C_LOOP
+        cloopPublishExecutionState
+    end
+
     # Get new sp in t0 and check stack height.
     getFrameRegisterSizeForCodeBlock(t1, t0)
     subp cfr, t0, t0
@@ -1435,6 +1439,9 @@ _llint_op_jngreatereq:
 
 _llint_op_loop_hint:
     traceExecution()
+    if C_LOOP
+        cloopPublishExecutionState
+    end
     checkSwitchToJITForLoop()
     dispatch(1)
 
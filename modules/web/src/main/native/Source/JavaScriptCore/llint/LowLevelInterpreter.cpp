@@ -349,6 +349,45 @@ JSValue CLoop::execute(OpcodeID entryOpcodeID, void* executableAddress, VM* vm,
     tagMask.i = 0xFFFF000000000002;
 #endif // USE(JSVALUE64)
 
+#if ENABLE(SAMPLING_PROFILER)
+    // Let the SamplingProfiler find the current frame and PC while this thread is
+    // suspended. CLOOP_PUBLISH_EXECUTION_STATE() copies them at calls, returns, slow
+    // paths and loop hints, so what the profiler reads may lag the registers by a
+    // few instructions. That is fine because it validates every frame it walks.
+    class ExecutionStateScope {
+    public:
+        ExecutionStateScope(VM& vm, VM::CLoopExecutionState& state)
+            : m_vm(vm)
+            , m_state(state)
+        {
+            m_state.previous = m_vm.cloopExecutionState;
+            m_vm.cloopExecutionState = &m_state;
+        }
+
+        ~ExecutionStateScope()
+        {
+            m_vm.cloopExecutionState = m_state.previous;
+        }
+
+    private:
+        VM& m_vm;
+        VM::CLoopExecutionState& m_state;
+    };
+
+    VM::CLoopExecutionState executionState;
+    executionState.callFrame.store(nullptr, std::memory_order_relaxed);
+    executionState.pc.store(nullptr, std::memory_order_relaxed);
+    ExecutionStateScope executionStateScope(*vm, executionState);
+
+#define CLOOP_PUBLISH_EXECUTION_STATE() \
+    do { \
+        executionState.callFrame.store(cfr.callFrame, std::memory_order_relaxed); \
+        executionState.pc.store(pc.vp, std::memory_order_relaxed); \
+    } while (false)
+#else
+#define CLOOP_PUBLISH_EXECUTION_STATE()
+#endif
+
     // Interpreter variables for value passing between opcodes and/or helpers:
     NativeFunction nativeFunc = 0;
     JSValue functionReturnValue;
@@ -384,6 +423,10 @@ JSValue CLoop::execute(OpcodeID entryOpcodeID, void* executableAddress, VM* vm,
         DISPATCH_OPCODE();       \
     } while (false)
 
+#if COMPILER(GCC_OR_CLANG) && !ENABLE(COMPUTED_GOTO_OPCODES)
+#error "The C loop must use computed goto dispatch when built with GCC or Clang"
+#endif
+
 #if ENABLE(COMPUTED_GOTO_OPCODES)
 
     //========================================================================
@@ -452,6 +495,114 @@ JSValue CLoop::execute(OpcodeID entryOpcodeID, void* executableAddress, VM* vm,
             DISPATCH_OPCODE();
         }
 
+        // Superinstructions installed by CLoop::fuseSuperinstructions(). Each one
+        // handles the common case of its pair inline and otherwise continues in the
+        // handler of the opcode it replaced, which still finds all of its operands.
+#if USE(JSVALUE64)
+        #define CLOOP_INSTRUCTION() (bitwise_cast<Instruction*>(pcBase.i8p) + pc.i)
+        #define CLOOP_ADVANCE_PC(count) (pc.i += (count))
+#else
+        #define CLOOP_INSTRUCTION() (reinterpret_cast<Instruction*>(pc.vp))
+        #define CLOOP_ADVANCE_PC(count) (pc.vp = reinterpret_cast<Instruction*>(pc.vp) + (count))
+#endif
+        #define CLOOP_DISPATCH_INSTRUCTION() \
+            do { \
+                opcode = CLOOP_INSTRUCTION()->u.opcode; \
+                DISPATCH_OPCODE(); \
+            } while (false)
+
+        OFFLINE_ASM_GLUE_LABEL(llint_cloop_op_mov_mov)
+        {
+            Instruction* instruction = CLOOP_INSTRUCTION();
+            ExecState* exec = cfr.execState;
+            exec->uncheckedR(instruction[1].u.operand) = exec->r(instruction[2].u.operand).jsValue();
+            instruction += OPCODE_LENGTH(op_mov);
+            exec->uncheckedR(instruction[1].u.operand) = exec->r(instruction[2].u.operand).jsValue();
+            CLOOP_ADVANCE_PC(2 * OPCODE_LENGTH(op_mov));
+            CLOOP_DISPATCH_INSTRUCTION();
+        }
+
+        OFFLINE_ASM_GLUE_LABEL(llint_cloop_op_get_by_id_call)
+        {
+            // Same inline cache check as op_get_by_id; a miss takes its slow path.
+            Instruction* instruction = CLOOP_INSTRUCTION();
+            ExecState* exec = cfr.execState;
+            JSValue baseValue = exec->r(instruction[2].u.operand).jsValue();
+            if (!baseValue.isCell() || baseValue.asCell()->structureID() != instruction[4].u.structureID)
+                goto op_get_by_id;
+            JSValue result = asObject(baseValue.asCell())->getDirect(instruction[5].u.operand);
+            exec->uncheckedR(instruction[1].u.operand) = result;
+            instruction[OPCODE_LENGTH(op_get_by_id) - 1].u.profile->m_buckets[0] = JSValue::encode(result);
+            CLOOP_ADVANCE_PC(OPCODE_LENGTH(op_get_by_id));
+            goto op_call;
+        }
+
+        OFFLINE_ASM_GLUE_LABEL(llint_cloop_op_put_by_id_put_by_id)
+        {
+            // Inline cache hit of op_put_by_id that replaces an existing property whose
+            // inferred type needs no check or only a number check. Transitions, other
+            // type checks and misses take op_put_by_id's own path.
+            Instruction* instruction = CLOOP_INSTRUCTION();
+            ExecState* exec = cfr.execState;
+            JSValue baseValue = exec->r(instruction[1].u.operand).jsValue();
+            if (!baseValue.isCell() || baseValue.asCell()->structureID() != instruction[4].u.structureID || instruction[6].u.structureID)
+                goto op_put_by_id;
+            JSValue value = exec->r(instruction[3].u.operand).jsValue();
+            PutByIdFlags flags = instruction[8].u.putByIdFlags;
+            if (flags & PutByIdPrimaryTypeMask)
+                goto op_put_by_id;
+            switch (flags & PutByIdSecondaryTypeMask) {
+            case PutByIdSecondaryTypeTop:
+                break;
+            case PutByIdSecondaryTypeNumber:
+                if (!value.isNumber())
+                    goto op_put_by_id;
+                break;
+            case PutByIdSecondaryTypeInt32:
+                if (!value.isInt32())
+                    goto op_put_by_id;
+                break;
+            default:
+                goto op_put_by_id;
+            }
+            asObject(baseValue.asCell())->putDirect(*vm, instruction[5].u.operand, value);
+            CLOOP_ADVANCE_PC(OPCODE_LENGTH(op_put_by_id));
+            goto op_put_by_id;
+        }
+
+        #define CLOOP_COMPARE_AND_JUMP_TO_LOOP_HINT(__opcode, relationalOperator) \
+            OFFLINE_ASM_GLUE_LABEL(llint_cloop_##__opcode##_loop_hint) \
+            { \
+                Instruction* instruction = CLOOP_INSTRUCTION(); \
+                ExecState* exec = cfr.execState; \
+                JSValue left = exec->r(instruction[1].u.operand).jsValue(); \
+                JSValue right = exec->r(instruction[2].u.operand).jsValue(); \
+                if (!left.isInt32() || !right.isInt32()) \
+                    goto __opcode; \
+                if (left.asInt32() relationalOperator right.asInt32()) { \
+                    CLOOP_ADVANCE_PC(instruction[3].u.operand); \
+                    goto op_loop_hint; \
+                } \
+                CLOOP_ADVANCE_PC(OPCODE_LENGTH(__opcode)); \
+                CLOOP_DISPATCH_INSTRUCTION(); \
+            }
+
+        CLOOP_COMPARE_AND_JUMP_TO_LOOP_HINT(op_jless, <)
+        CLOOP_COMPARE_AND_JUMP_TO_LOOP_HINT(op_jlesseq, <=)
+        CLOOP_COMPARE_AND_JUMP_TO_LOOP_HINT(op_jgreater, >)
+        CLOOP_COMPARE_AND_JUMP_TO_LOOP_HINT(op_jgreatereq, >=)
+        #undef CLOOP_COMPARE_AND_JUMP_TO_LOOP_HINT
+
+        OFFLINE_ASM_GLUE_LABEL(llint_cloop_op_jmp_loop_hint)
+        {
+            CLOOP_ADVANCE_PC(CLOOP_INSTRUCTION()[1].u.operand);
+            goto op_loop_hint;
+        }
+
+        #undef CLOOP_DISPATCH_INSTRUCTION
+        #undef CLOOP_ADVANCE_PC
+        #undef CLOOP_INSTRUCTION
+
 #if !ENABLE(COMPUTED_GOTO_OPCODES)
     default:
         ASSERT(false);
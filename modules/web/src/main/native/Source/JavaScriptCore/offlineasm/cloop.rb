@@ -542,6 +542,7 @@ end
 
 # operands: callTarget, currentFrame, currentPC
 def cloopEmitCallSlowPath(operands)
+    $asm.putc "CLOOP_PUBLISH_EXECUTION_STATE();"
     $asm.putc "{"
     $asm.putc "    SlowPathReturnType result = #{operands[0].cLabel}(#{operands[1].clDump}, #{operands[2].clDump});"
     $asm.putc "    decodeResult(result, t0.vp, t1.vp);"
@@ -549,6 +550,7 @@ def cloopEmitCallSlowPath(operands)
 end
 
 def cloopEmitCallSlowPathVoid(operands)
+    $asm.putc "CLOOP_PUBLISH_EXECUTION_STATE();"
     $asm.putc "#{operands[0].cLabel}(#{operands[1].clDump}, #{operands[2].clDump});"
 end
 
@@ -1120,11 +1122,13 @@ class Instruction
             $asm.putc "opcode = #{operands[0].clValue(:opcode)};"
             $asm.putc "DISPATCH_OPCODE();"
             $asm.putsLabel("llint_cloop_did_return_from_js_#{@@didReturnFromJSLabelCounter}", false)
+            $asm.putc "CLOOP_PUBLISH_EXECUTION_STATE();"
 
         # We can't do generic function calls with an arbitrary set of args, but
         # fortunately we don't have to here. All native function calls always
         # have a fixed prototype of 1 args: the passed ExecState.
         when "cloopCallNative"
+            $asm.putc "CLOOP_PUBLISH_EXECUTION_STATE();"
             $asm.putc "nativeFunc = #{operands[0].clValue(:nativeFunc)};"
             $asm.putc "functionReturnValue = JSValue::decode(nativeFunc(t0.execState));"
             $asm.putc "#if USE(JSVALUE32_64)"
@@ -1143,6 +1147,11 @@ class Instruction
         when "cloopCallSlowPathVoid"
             cloopEmitCallSlowPathVoid(operands)
 
+        # Lets the SamplingProfiler see the current frame and PC. See
+        # CLOOP_PUBLISH_EXECUTION_STATE() in LowLevelInterpreter.cpp.
+        when "cloopPublishExecutionState"
+            $asm.putc "CLOOP_PUBLISH_EXECUTION_STATE();"
+
         # For debugging only. This is used to insert instrumentation into the
         # generated LLIntAssembly.h during llint development only. Do not use
         # for production code.
@@ -314,6 +314,7 @@ CXX_INSTRUCTIONS =
      "cloopCallNative",         # operands: callee
      "cloopCallSlowPath",       # operands: callTarget, currentFrame, currentPC
      "cloopCallSlowPathVoid",   # operands: callTarget, currentFrame, currentPC
+     "cloopPublishExecutionState", # no operands
 
      # For debugging only:
      # Takes no operands but simply emits whatever follows in // comments as
@@ -198,6 +198,7 @@ Parser<LexerType>::Parser(
     ConstructorKind defaultConstructorKind, ThisTDZMode thisTDZMode)
     : m_vm(vm)
     , m_source(&source)
+    , m_parserArena(&vm->parserArenaPoolCache())
     , m_hasStackOverflow(false)
     , m_allowsIn(true)
     , m_syntaxAlreadyValidated(source.provider()->isValid())
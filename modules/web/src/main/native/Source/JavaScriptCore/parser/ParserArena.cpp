@@ -31,9 +31,49 @@
 
 namespace JSC {
 
-ParserArena::ParserArena()
+ParserArenaPoolCache::~ParserArenaPoolCache()
+{
+    if (Options::logParserArenaStatistics()) {
+        dataLog("Parser arenas: ", m_statistics.arenas, " arenas, ", m_statistics.bytesAllocated, " bytes");
+        if (m_statistics.arenas)
+            dataLog(" (", m_statistics.bytesAllocated / m_statistics.arenas, " average, ", m_statistics.largestArena, " largest)");
+        dataLog(", ", m_statistics.poolsAllocated, " pools allocated, ", m_statistics.poolsReused, " pools reused\n");
+    }
+
+    for (void* pool : m_pools)
+        fastFree(pool);
+}
+
+void* ParserArenaPoolCache::takePool()
+{
+    if (!m_pools.isEmpty()) {
+        m_statistics.poolsReused++;
+        return m_pools.takeLast();
+    }
+    m_statistics.poolsAllocated++;
+    return fastMalloc(ParserArena::freeablePoolSize);
+}
+
+void ParserArenaPoolCache::returnPool(void* pool)
+{
+    if (m_pools.size() < maximumCachedPools) {
+        m_pools.uncheckedAppend(pool);
+        return;
+    }
+    fastFree(pool);
+}
+
+void ParserArenaPoolCache::didDestroyArena(size_t bytesAllocated)
+{
+    m_statistics.arenas++;
+    m_statistics.bytesAllocated += bytesAllocated;
+    m_statistics.largestArena = std::max(m_statistics.largestArena, bytesAllocated);
+}
+
+ParserArena::ParserArena(ParserArenaPoolCache* poolCache)
     : m_freeableMemory(0)
     , m_freeablePoolEnd(0)
+    , m_poolCache(poolCache)
 {
 }
 
@@ -49,12 +89,22 @@ inline void ParserArena::deallocateObjects()
     for (size_t i = 0; i < size; ++i)
         m_deletableObjects[i]->~ParserArenaDeletable();
 
-    if (m_freeablePoolEnd)
-        fastFree(freeablePool());
+    if (!m_poolCache) {
+        if (m_freeablePoolEnd)
+            fastFree(freeablePool());
+        for (void* pool : m_freeablePools)
+            fastFree(pool);
+        return;
+    }
 
-    size = m_freeablePools.size();
-    for (size_t i = 0; i < size; ++i)
-        fastFree(m_freeablePools[i]);
+    size_t bytesAllocated = m_freeablePools.size() * freeablePoolSize;
+    if (m_freeablePoolEnd) {
+        bytesAllocated += m_freeableMemory - static_cast<char*>(freeablePool());
+        m_poolCache->returnPool(freeablePool());
+    }
+    for (void* pool : m_freeablePools)
+        m_poolCache->returnPool(pool);
+    m_poolCache->didDestroyArena(bytesAllocated);
 }
 
 ParserArena::~ParserArena()
@@ -67,7 +117,7 @@ void ParserArena::allocateFreeablePool()
     if (m_freeablePoolEnd)
         m_freeablePools.append(freeablePool());
 
-    char* pool = static_cast<char*>(fastMalloc(freeablePoolSize));
+    char* pool = static_cast<char*>(m_poolCache ? m_poolCache->takePool() : fastMalloc(freeablePoolSize));
     m_freeableMemory = pool;
     m_freeablePoolEnd = pool + freeablePoolSize;
     ASSERT(freeablePool() == pool);
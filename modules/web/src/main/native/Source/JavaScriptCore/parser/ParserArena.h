@@ -126,16 +126,49 @@ namespace JSC {
         return m_identifiers.last();
     }
 
+    // Keeps the pools of destroyed ParserArenas so the next parse on the same
+    // VM reuses them instead of going back to malloc.
+    class ParserArenaPoolCache {
+        WTF_MAKE_NONCOPYABLE(ParserArenaPoolCache);
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        struct Statistics {
+            uint64_t arenas { 0 };
+            uint64_t bytesAllocated { 0 };
+            size_t largestArena { 0 };
+            uint64_t poolsAllocated { 0 };
+            uint64_t poolsReused { 0 };
+        };
+
+        ParserArenaPoolCache() { }
+        ~ParserArenaPoolCache();
+
+        void* takePool();
+        void returnPool(void*);
+        void didDestroyArena(size_t bytesAllocated);
+
+        const Statistics& statistics() const { return m_statistics; }
+
+    private:
+        static const size_t maximumCachedPools = 64;
+
+        Vector<void*, maximumCachedPools> m_pools;
+        Statistics m_statistics;
+    };
+
     class ParserArena {
         WTF_MAKE_NONCOPYABLE(ParserArena);
     public:
-        ParserArena();
+        static const size_t freeablePoolSize = 8000;
+
+        explicit ParserArena(ParserArenaPoolCache* = nullptr);
         ~ParserArena();
 
         void swap(ParserArena& otherArena)
         {
             std::swap(m_freeableMemory, otherArena.m_freeableMemory);
             std::swap(m_freeablePoolEnd, otherArena.m_freeablePoolEnd);
+            std::swap(m_poolCache, otherArena.m_poolCache);
             m_identifierArena.swap(otherArena.m_identifierArena);
             m_freeablePools.swap(otherArena.m_freeablePools);
             m_deletableObjects.swap(otherArena.m_deletableObjects);
@@ -169,8 +202,6 @@ namespace JSC {
         }
 
     private:
-        static const size_t freeablePoolSize = 8000;
-
         static size_t alignSize(size_t size)
         {
             return (size + sizeof(WTF::AllocAlignmentInteger) - 1) & ~(sizeof(WTF::AllocAlignmentInteger) - 1);
@@ -182,6 +213,7 @@ namespace JSC {
 
         char* m_freeableMemory;
         char* m_freeablePoolEnd;
+        ParserArenaPoolCache* m_poolCache;
 
         std::unique_ptr<IdentifierArena> m_identifierArena;
         Vector<void*> m_freeablePools;
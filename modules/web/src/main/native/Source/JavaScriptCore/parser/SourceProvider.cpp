@@ -37,6 +37,8 @@ SourceProvider::SourceProvider(const String& url, const TextPosition& startPosit
     , m_startPosition(startPosition)
     , m_validated(false)
     , m_id(0)
+    , m_hasCacheStoreKey(false)
+    , m_hasRestoredCache(false)
 {
 }
 
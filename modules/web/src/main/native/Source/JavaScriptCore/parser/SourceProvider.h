@@ -71,6 +71,7 @@ namespace JSC {
 
     private:
         template <typename T> friend class Parser;
+        friend class SourceProviderCache;
 
         void setSourceURLDirective(const String& sourceURL) { m_sourceURLDirective = sourceURL; }
         void setSourceMappingURLDirective(const String& sourceMappingURL) { m_sourceMappingURLDirective = sourceMappingURL; }
@@ -83,6 +84,12 @@ namespace JSC {
         TextPosition m_startPosition;
         bool m_validated : 1;
         uintptr_t m_id : sizeof(uintptr_t) * 8 - 1;
+
+        // Kept for SourceProviderCache, so that the source is hashed and its
+        // stored items restored once rather than after every collection.
+        String m_cacheStoreKey;
+        bool m_hasCacheStoreKey;
+        bool m_hasRestoredCache;
     };
 
     class StringSourceProvider : public SourceProvider {
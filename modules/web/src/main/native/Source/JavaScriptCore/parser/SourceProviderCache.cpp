@@ -26,12 +26,259 @@
 #include "config.h"
 #include "SourceProviderCache.h"
 
+#include "Identifier.h"
 #include "JSCInlines.h"
+#include "Options.h"
+#include "SourceProvider.h"
+#include <wtf/HashSet.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/SHA1.h>
+#include <wtf/text/StringBuilder.h>
 
 namespace JSC {
 
+// Short scripts are parsed quickly enough that hashing them would not pay off.
+static const unsigned minimumSourceLengthToStore = 1024;
+
+static String storeKeyForSource(SourceProvider& provider)
+{
+    // Eval code has no URL and may be parsed in a strict or sloppy context,
+    // so only scripts that were loaded from somewhere are kept.
+    if (!Options::sourceProviderCacheStoreSize() || provider.url().isEmpty())
+        return String();
+
+    StringView source = provider.source();
+    if (source.length() < minimumSourceLengthToStore)
+        return String();
+
+    SHA1 sha1;
+    if (source.is8Bit())
+        sha1.addBytes(source.characters8(), source.length());
+    else
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(source.characters16()), source.length() * sizeof(UChar));
+    SHA1::Digest digest;
+    sha1.computeHash(digest);
+
+    // Items record absolute line numbers, so the position of the script in
+    // its document is part of the key.
+    StringBuilder key;
+    key.append(provider.url());
+    key.append(' ');
+    key.appendNumber(provider.startPosition().m_line.zeroBasedInt());
+    key.append(':');
+    key.appendNumber(provider.startPosition().m_column.zeroBasedInt());
+    key.append(' ');
+    key.append(SHA1::hexDigest(digest).data());
+    return key.toString();
+}
+
+static void encodeUnsigned(Vector<uint8_t>& buffer, unsigned value)
+{
+    buffer.append(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+static bool decodeUnsigned(const uint8_t*& cursor, const uint8_t* end, unsigned& value)
+{
+    if (static_cast<size_t>(end - cursor) < sizeof(value))
+        return false;
+    memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);
+    return true;
+}
+
+static bool canEncode(const SourceProviderCacheItem& item)
+{
+    // Private names of builtins only mean something in the VM that made them.
+    for (unsigned i = 0; i < item.usedVariablesCount + item.writtenVariablesCount; ++i) {
+        if (item.usedVariables()[i]->isSymbol())
+            return false;
+    }
+    return true;
+}
+
+static void encodeVariable(Vector<uint8_t>& buffer, UniquedStringImpl* variable)
+{
+    encodeUnsigned(buffer, variable->length());
+    buffer.append(static_cast<uint8_t>(variable->is8Bit()));
+    if (variable->is8Bit())
+        buffer.append(variable->characters8(), variable->length());
+    else
+        buffer.append(reinterpret_cast<const uint8_t*>(variable->characters16()), variable->length() * sizeof(UChar));
+}
+
+static bool decodeVariable(VM& vm, const uint8_t*& cursor, const uint8_t* end, Vector<RefPtr<UniquedStringImpl>>& variables)
+{
+    unsigned length;
+    if (!decodeUnsigned(cursor, end, length) || cursor == end)
+        return false;
+    bool is8Bit = *cursor++;
+    size_t size = is8Bit ? length : length * sizeof(UChar);
+    if (static_cast<size_t>(end - cursor) < size)
+        return false;
+
+    Identifier identifier;
+    if (is8Bit)
+        identifier = Identifier::fromString(&vm, cursor, length);
+    else {
+        Vector<UChar> characters(length);
+        memcpy(characters.data(), cursor, size);
+        identifier = Identifier::fromString(&vm, characters.data(), length);
+    }
+    cursor += size;
+    variables.append(identifier.impl());
+    return true;
+}
+
+static void encodeItem(Vector<uint8_t>& buffer, int sourcePosition, const SourceProviderCacheItem& item)
+{
+    encodeUnsigned(buffer, sourcePosition);
+    encodeUnsigned(buffer, item.functionNameStart);
+    encodeUnsigned(buffer, item.endFunctionOffset);
+    encodeUnsigned(buffer, item.lastTockenLine);
+    encodeUnsigned(buffer, item.lastTockenStartOffset);
+    encodeUnsigned(buffer, item.lastTockenEndOffset);
+    encodeUnsigned(buffer, item.lastTockenLineStartOffset);
+    encodeUnsigned(buffer, item.parameterCount);
+    encodeUnsigned(buffer, item.tokenType);
+    buffer.append(static_cast<uint8_t>(item.needsFullActivation));
+    buffer.append(static_cast<uint8_t>(item.usesEval));
+    buffer.append(static_cast<uint8_t>(item.strictMode));
+    buffer.append(static_cast<uint8_t>(item.isBodyArrowExpression));
+    buffer.append(item.innerArrowFunctionFeatures);
+    encodeUnsigned(buffer, item.usedVariablesCount);
+    encodeUnsigned(buffer, item.writtenVariablesCount);
+    for (unsigned i = 0; i < item.usedVariablesCount; ++i)
+        encodeVariable(buffer, item.usedVariables()[i]);
+    for (unsigned i = 0; i < item.writtenVariablesCount; ++i)
+        encodeVariable(buffer, item.writtenVariables()[i]);
+}
+
+static std::unique_ptr<SourceProviderCacheItem> decodeItem(VM& vm, const uint8_t*& cursor, const uint8_t* end, int& sourcePosition)
+{
+    SourceProviderCacheItemCreationParameters parameters;
+    unsigned position;
+    unsigned tokenType;
+    if (!decodeUnsigned(cursor, end, position)
+        || !decodeUnsigned(cursor, end, parameters.functionNameStart)
+        || !decodeUnsigned(cursor, end, parameters.endFunctionOffset)
+        || !decodeUnsigned(cursor, end, parameters.lastTockenLine)
+        || !decodeUnsigned(cursor, end, parameters.lastTockenStartOffset)
+        || !decodeUnsigned(cursor, end, parameters.lastTockenEndOffset)
+        || !decodeUnsigned(cursor, end, parameters.lastTockenLineStartOffset)
+        || !decodeUnsigned(cursor, end, parameters.parameterCount)
+        || !decodeUnsigned(cursor, end, tokenType))
+        return nullptr;
+
+    if (end - cursor < 5)
+        return nullptr;
+    parameters.needsFullActivation = *cursor++;
+    parameters.usesEval = *cursor++;
+    parameters.strictMode = *cursor++;
+    parameters.isBodyArrowExpression = *cursor++;
+    parameters.innerArrowFunctionFeatures = *cursor++;
+    parameters.tokenType = static_cast<JSTokenType>(tokenType);
+
+    unsigned usedVariablesCount;
+    unsigned writtenVariablesCount;
+    if (!decodeUnsigned(cursor, end, usedVariablesCount) || !decodeUnsigned(cursor, end, writtenVariablesCount))
+        return nullptr;
+    for (unsigned i = 0; i < usedVariablesCount; ++i) {
+        if (!decodeVariable(vm, cursor, end, parameters.usedVariables))
+            return nullptr;
+    }
+    for (unsigned i = 0; i < writtenVariablesCount; ++i) {
+        if (!decodeVariable(vm, cursor, end, parameters.writtenVariables))
+            return nullptr;
+    }
+
+    sourcePosition = position;
+    return SourceProviderCacheItem::create(parameters);
+}
+
+namespace {
+
+// Encoded items of scripts that were parsed before, kept after their
+// SourceProviders and VMs are gone so a reloaded script only syntax checks
+// functions that have not been seen. The least recently used scripts are
+// dropped first once Options::sourceProviderCacheStoreSize() is exceeded.
+class SourceProviderCacheStore {
+public:
+    Vector<uint8_t> find(const String& key)
+    {
+        auto iterator = m_records.find(key);
+        if (iterator == m_records.end())
+            return Vector<uint8_t>();
+        m_order.appendOrMoveToLast(key);
+        return iterator->value.encodedItems;
+    }
+
+    // Adds the items the store does not have yet. Caches made after a
+    // collection start empty, so they may add items stored before.
+    void add(const String& key, const Vector<std::pair<int, const SourceProviderCacheItem*>>& items)
+    {
+        size_t maximumSize = Options::sourceProviderCacheStoreSize();
+        Records& records = m_records.add(key, Records()).iterator->value;
+        size_t oldSize = records.size();
+        for (auto& item : items) {
+            if (records.sourcePositions.add(item.first).isNewEntry)
+                encodeItem(records.encodedItems, item.first, *item.second);
+        }
+        m_size += records.size() - oldSize;
+        m_order.appendOrMoveToLast(key);
+
+        while (m_size > maximumSize) {
+            String oldest = m_order.takeFirst();
+            m_size -= m_records.take(oldest).size();
+        }
+    }
+
+private:
+    struct Records {
+        size_t size() const { return encodedItems.size() + sourcePositions.size() * sizeof(int); }
+
+        Vector<uint8_t> encodedItems;
+        HashSet<int, WTF::IntHash<int>, WTF::UnsignedWithZeroKeyHashTraits<int>> sourcePositions;
+    };
+
+    HashMap<String, Records> m_records;
+    ListHashSet<String> m_order;
+    size_t m_size { 0 };
+};
+
+} // anonymous namespace
+
+static StaticLock storeLock;
+
+static SourceProviderCacheStore& sourceProviderCacheStore()
+{
+    static NeverDestroyed<SourceProviderCacheStore> store;
+    return store;
+}
+
+Ref<SourceProviderCache> SourceProviderCache::create(VM& vm, SourceProvider& provider)
+{
+    Ref<SourceProviderCache> cache = adoptRef(*new SourceProviderCache);
+
+    // Every collection throws the caches away, so the source is hashed and its
+    // stored items restored only for the first cache of a provider. Later
+    // caches start empty, as they did before items were stored.
+    if (!provider.m_hasCacheStoreKey) {
+        provider.m_cacheStoreKey = storeKeyForSource(provider);
+        provider.m_hasCacheStoreKey = true;
+    }
+    cache->m_storeKey = provider.m_cacheStoreKey;
+    if (!cache->m_storeKey.isNull() && !provider.m_hasRestoredCache) {
+        provider.m_hasRestoredCache = true;
+        cache->restore(vm);
+    }
+    return cache;
+}
+
 SourceProviderCache::~SourceProviderCache()
 {
+    store();
     clear();
 }
 
@@ -42,7 +289,49 @@ void SourceProviderCache::clear()
 
 void SourceProviderCache::add(int sourcePosition, std::unique_ptr<SourceProviderCacheItem> item)
 {
-    m_map.add(sourcePosition, WTFMove(item));
+    auto addResult = m_map.add(sourcePosition, WTFMove(item));
+    if (addResult.isNewEntry && !m_storeKey.isNull())
+        m_unstoredSourcePositions.append(sourcePosition);
+}
+
+void SourceProviderCache::restore(VM& vm)
+{
+    Vector<uint8_t> records;
+    {
+        LockHolder locker(storeLock);
+        records = sourceProviderCacheStore().find(m_storeKey);
+    }
+
+    const uint8_t* cursor = records.data();
+    const uint8_t* end = cursor + records.size();
+    while (cursor < end) {
+        int sourcePosition;
+        std::unique_ptr<SourceProviderCacheItem> item = decodeItem(vm, cursor, end, sourcePosition);
+        if (!item) {
+            // Records are only written by encodeItem(), so this means the store is out of sync.
+            ASSERT_NOT_REACHED();
+            m_map.clear();
+            return;
+        }
+        m_map.add(sourcePosition, WTFMove(item));
+    }
+}
+
+void SourceProviderCache::store()
+{
+    if (m_unstoredSourcePositions.isEmpty())
+        return;
+
+    Vector<std::pair<int, const SourceProviderCacheItem*>> items;
+    for (int sourcePosition : m_unstoredSourcePositions) {
+        const SourceProviderCacheItem* item = m_map.get(sourcePosition);
+        if (item && canEncode(*item))
+            items.append(std::make_pair(sourcePosition, item));
+    }
+    m_unstoredSourcePositions.clear();
+
+    LockHolder locker(storeLock);
+    sourceProviderCacheStore().add(m_storeKey, items);
 }
 
 }
@@ -29,13 +29,17 @@
 #include "SourceProviderCacheItem.h"
 #include <wtf/HashMap.h>
 #include <wtf/RefCounted.h>
+#include <wtf/text/WTFString.h>
 
 namespace JSC {
 
+class SourceProvider;
+class VM;
+
 class SourceProviderCache : public RefCounted<SourceProviderCache> {
     WTF_MAKE_FAST_ALLOCATED;
 public:
-    SourceProviderCache() { }
+    static Ref<SourceProviderCache> create(VM&, SourceProvider&);
     JS_EXPORT_PRIVATE ~SourceProviderCache();
 
     JS_EXPORT_PRIVATE void clear();
@@ -43,7 +47,18 @@ public:
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
 
 private:
+    SourceProviderCache() { }
+
+    void restore(VM&);
+    void store();
+
     HashMap<int, std::unique_ptr<SourceProviderCacheItem>, WTF::IntHash<int>, WTF::UnsignedWithZeroKeyHashTraits<int>> m_map;
+
+    // Identifies the source text in the process-wide store that keeps the
+    // items after this cache is gone. Null if the source is not kept.
+    String m_storeKey;
+    // Items added since this cache was created, which the store may not have.
+    Vector<int> m_unstoredSourcePositions;
 };
 
 }
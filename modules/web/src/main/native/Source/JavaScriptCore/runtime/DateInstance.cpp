@@ -65,6 +65,7 @@ const GregorianDateTime* DateInstance::calculateGregorianDateTime(ExecState* exe
         return 0;
 
     VM& vm = exec->vm();
+    vm.resetDateCacheIfTimeZoneChanged();
     if (!m_data)
         m_data = vm.dateInstanceCache.add(milli);
 
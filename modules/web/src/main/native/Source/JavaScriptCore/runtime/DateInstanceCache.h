@@ -76,7 +76,8 @@ public:
     }
 
 private:
-    static const size_t cacheSize = 16;
+    // Direct mapped, and large enough for the distinct dates a table or list view formats at once.
+    static const size_t cacheSize = 1024;
 
     struct CacheEntry {
         double key;
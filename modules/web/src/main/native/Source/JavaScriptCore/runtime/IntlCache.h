@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IntlCache_h
+#define IntlCache_h
+
+#if ENABLE(INTL)
+
+#include <unicode/ucol.h>
+#include <unicode/udat.h>
+#include <unicode/unum.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+// Opening an ICU collator or formatter loads and parses locale data, which costs far more than
+// cloning an open one. Number.prototype.toLocaleString and friends construct a new Intl object
+// for every call, so the VM keeps the most recently used ICU objects, keyed by everything they
+// were opened with, and hands out clones of them. Clones are never shared, since ICU objects
+// are not safe to use from more than one place at a time.
+template<typename Traits>
+class IntlObjectCache {
+    WTF_MAKE_NONCOPYABLE(IntlObjectCache);
+public:
+    typedef typename Traits::Type Type;
+
+    static const size_t capacity = 16;
+
+    IntlObjectCache() { }
+
+    ~IntlObjectCache()
+    {
+        for (auto& entry : m_entries)
+            Traits::close(entry.object);
+    }
+
+    // Returns a clone of the object cached under key, which the caller owns, or null.
+    Type* copy(const String& key)
+    {
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            if (m_entries[i].key != key)
+                continue;
+            if (i) {
+                Entry entry = m_entries[i];
+                m_entries.remove(i);
+                m_entries.insert(0, entry);
+            }
+            return clone(m_entries[0].object);
+        }
+        return nullptr;
+    }
+
+    // Caches a clone of object under key. The caller keeps owning object.
+    void add(const String& key, const Type* object)
+    {
+        Type* cachedObject = clone(object);
+        if (!cachedObject)
+            return;
+        if (m_entries.size() == capacity) {
+            Traits::close(m_entries.last().object);
+            m_entries.removeLast();
+        }
+        m_entries.insert(0, Entry { key, cachedObject });
+    }
+
+private:
+    struct Entry {
+        String key;
+        Type* object;
+    };
+
+    static Type* clone(const Type* object)
+    {
+        UErrorCode status = U_ZERO_ERROR;
+        Type* result = Traits::clone(object, &status);
+        if (U_FAILURE(status)) {
+            if (result)
+                Traits::close(result);
+            return nullptr;
+        }
+        return result;
+    }
+
+    // Most recently used first.
+    Vector<Entry, capacity> m_entries;
+};
+
+struct IntlCollatorCacheTraits {
+    typedef UCollator Type;
+    static UCollator* clone(const UCollator* collator, UErrorCode* status) { return ucol_safeClone(collator, nullptr, nullptr, status); }
+    static void close(UCollator* collator) { ucol_close(collator); }
+};
+
+struct IntlNumberFormatCacheTraits {
+    typedef UNumberFormat Type;
+    static UNumberFormat* clone(const UNumberFormat* numberFormat, UErrorCode* status) { return unum_clone(numberFormat, status); }
+    static void close(UNumberFormat* numberFormat) { unum_close(numberFormat); }
+};
+
+struct IntlDateFormatCacheTraits {
+    typedef UDateFormat Type;
+    static UDateFormat* clone(const UDateFormat* dateFormat, UErrorCode* status) { return udat_clone(dateFormat, status); }
+    static void close(UDateFormat* dateFormat) { udat_close(dateFormat); }
+};
+
+class IntlCache {
+    WTF_MAKE_NONCOPYABLE(IntlCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    IntlCache() { }
+
+    IntlObjectCache<IntlCollatorCacheTraits> collators;
+    IntlObjectCache<IntlNumberFormatCacheTraits> numberFormats;
+    IntlObjectCache<IntlDateFormatCacheTraits> dateFormats;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(INTL)
+
+#endif // IntlCache_h
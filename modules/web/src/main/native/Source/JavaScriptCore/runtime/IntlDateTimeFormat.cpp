@@ -30,6 +30,7 @@
 
 #include "DateInstance.h"
 #include "Error.h"
+#include "IntlCache.h"
 #include "IntlDateTimeFormatConstructor.h"
 #include "IntlObject.h"
 #include "JSBoundFunction.h"
@@ -643,24 +644,39 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
 
     // Always use ICU date format generator, rather than our own pattern list and matcher.
     // Covers steps 28-36.
-    UErrorCode status = U_ZERO_ERROR;
-    UDateTimePatternGenerator* generator = udatpg_open(dataLocale.utf8().data(), &status);
-    if (U_FAILURE(status)) {
-        throwTypeError(&exec, ASCIILiteral("failed to initialize DateTimeFormat"));
-        return;
-    }
-
+    // Opening the pattern generator is expensive, so formats opened before with the same locale,
+    // time zone and skeleton are cloned from the VM's cache, and their pattern read back.
     String skeleton = skeletonBuilder.toString();
-    StringView skeletonView(skeleton);
+    String cacheKey = makeString(m_locale, ' ', dataLocale, ' ', m_timeZone, ' ', skeleton);
+    IntlObjectCache<IntlDateFormatCacheTraits>& cache = exec.vm().intlCache().dateFormats;
+    m_dateFormat = std::unique_ptr<UDateFormat, UDateFormatDeleter>(cache.copy(cacheKey));
+
+    UErrorCode status = U_ZERO_ERROR;
     Vector<UChar, 32> patternBuffer(32);
-    status = U_ZERO_ERROR;
-    auto patternLength = udatpg_getBestPattern(generator, skeletonView.upconvertedCharacters(), skeletonView.length(), patternBuffer.data(), patternBuffer.size(), &status);
-    if (status == U_BUFFER_OVERFLOW_ERROR) {
-        status = U_ZERO_ERROR;
-        patternBuffer.grow(patternLength);
-        udatpg_getBestPattern(generator, skeletonView.upconvertedCharacters(), skeletonView.length(), patternBuffer.data(), patternLength, &status);
+    int32_t patternLength;
+    if (m_dateFormat) {
+        patternLength = udat_toPattern(m_dateFormat.get(), false, patternBuffer.data(), patternBuffer.size(), &status);
+        if (status == U_BUFFER_OVERFLOW_ERROR) {
+            status = U_ZERO_ERROR;
+            patternBuffer.grow(patternLength);
+            udat_toPattern(m_dateFormat.get(), false, patternBuffer.data(), patternLength, &status);
+        }
+    } else {
+        UDateTimePatternGenerator* generator = udatpg_open(dataLocale.utf8().data(), &status);
+        if (U_FAILURE(status)) {
+            throwTypeError(&exec, ASCIILiteral("failed to initialize DateTimeFormat"));
+            return;
+        }
+
+        StringView skeletonView(skeleton);
+        patternLength = udatpg_getBestPattern(generator, skeletonView.upconvertedCharacters(), skeletonView.length(), patternBuffer.data(), patternBuffer.size(), &status);
+        if (status == U_BUFFER_OVERFLOW_ERROR) {
+            status = U_ZERO_ERROR;
+            patternBuffer.grow(patternLength);
+            udatpg_getBestPattern(generator, skeletonView.upconvertedCharacters(), skeletonView.length(), patternBuffer.data(), patternLength, &status);
+        }
+        udatpg_close(generator);
     }
-    udatpg_close(generator);
     if (U_FAILURE(status)) {
         throwTypeError(&exec, ASCIILiteral("failed to initialize DateTimeFormat"));
         return;
@@ -669,12 +685,15 @@ void IntlDateTimeFormat::initializeDateTimeFormat(ExecState& exec, JSValue local
     StringView pattern(patternBuffer.data(), patternLength);
     setFormatsFromPattern(pattern);
 
-    status = U_ZERO_ERROR;
-    StringView timeZoneView(m_timeZone);
-    m_dateFormat = std::unique_ptr<UDateFormat, UDateFormatDeleter>(udat_open(UDAT_PATTERN, UDAT_PATTERN, m_locale.utf8().data(), timeZoneView.upconvertedCharacters(), timeZoneView.length(), pattern.upconvertedCharacters(), pattern.length(), &status));
-    if (U_FAILURE(status)) {
-        throwTypeError(&exec, ASCIILiteral("failed to initialize DateTimeFormat"));
-        return;
+    if (!m_dateFormat) {
+        status = U_ZERO_ERROR;
+        StringView timeZoneView(m_timeZone);
+        m_dateFormat = std::unique_ptr<UDateFormat, UDateFormatDeleter>(udat_open(UDAT_PATTERN, UDAT_PATTERN, m_locale.utf8().data(), timeZoneView.upconvertedCharacters(), timeZoneView.length(), pattern.upconvertedCharacters(), pattern.length(), &status));
+        if (U_FAILURE(status)) {
+            throwTypeError(&exec, ASCIILiteral("failed to initialize DateTimeFormat"));
+            return;
+        }
+        cache.add(cacheKey, m_dateFormat.get());
     }
 
     // 37. Set dateTimeFormat.[[boundFormat]] to undefined.
@@ -31,6 +31,7 @@
 
 #include "Error.h"
 #include "IdentifierInlines.h"
+#include "IntlCache.h"
 #include "IntlNumberFormatConstructor.h"
 #include "IntlObject.h"
 #include "JSBoundFunction.h"
@@ -39,6 +40,7 @@
 #include "ObjectConstructor.h"
 #include "SlotVisitorInlines.h"
 #include "StructureInlines.h"
+#include <wtf/text/StringBuilder.h>
 
 namespace JSC {
 
@@ -397,6 +399,29 @@ void IntlNumberFormat::createNumberFormat(ExecState& state)
         ASSERT_NOT_REACHED();
     }
 
+    StringBuilder cacheKey;
+    cacheKey.append(m_locale);
+    cacheKey.append(' ');
+    cacheKey.append(styleString(m_style));
+    if (m_style == Style::Currency) {
+        cacheKey.append(' ');
+        cacheKey.append(m_currency);
+        cacheKey.append(' ');
+        cacheKey.append(currencyDisplayString(m_currencyDisplay));
+    }
+    for (unsigned digits : { m_minimumIntegerDigits, m_minimumFractionDigits, m_maximumFractionDigits, m_minimumSignificantDigits, m_maximumSignificantDigits }) {
+        cacheKey.append(' ');
+        cacheKey.appendNumber(digits);
+    }
+    if (m_useGrouping)
+        cacheKey.appendLiteral(" grouping");
+
+    IntlObjectCache<IntlNumberFormatCacheTraits>& cache = state.vm().intlCache().numberFormats;
+    if (UNumberFormat* cachedNumberFormat = cache.copy(cacheKey.toString())) {
+        m_numberFormat = std::unique_ptr<UNumberFormat, UNumberFormatDeleter>(cachedNumberFormat);
+        return;
+    }
+
     UErrorCode status = U_ZERO_ERROR;
     auto numberFormat = std::unique_ptr<UNumberFormat, UNumberFormatDeleter>(unum_open(style, nullptr, 0, m_locale.utf8().data(), nullptr, &status));
     if (U_FAILURE(status))
@@ -418,6 +443,7 @@ void IntlNumberFormat::createNumberFormat(ExecState& state)
     if (U_FAILURE(status))
         return;
 
+    cache.add(cacheKey.toString(), numberFormat.get());
     m_numberFormat = WTFMove(numberFormat);
 }
 
@@ -127,66 +127,100 @@ static inline int msToWeekDay(double ms)
     return wd;
 }
 
+// Narrows down, to the millisecond, where the offset changes between a time that has the given
+// offset and one that does not, and returns the time closest to the change that still has it.
+static double findLocalTimeOffsetChange(double matching, double differing, LocalTimeOffset offset, WTF::TimeType timeType)
+{
+    while (std::abs(differing - matching) > 1) {
+        double middle = (matching + differing) / 2;
+        if (calculateLocalTimeOffset(middle, timeType) == offset)
+            matching = middle;
+        else
+            differing = middle;
+    }
+    return matching;
+}
+
+// How far the search for the ends of a period goes in each direction, in months.
+static const unsigned maxMonthsToProbeForOffsetChange = 12;
+
 // Get the combined UTC + DST offset for the time passed in.
 //
+// Offsets are computed for the whole period around the time over which they don't change, and
+// kept in a table that later times are looked up in with a binary search.
+//
 // NOTE: The implementation relies on the fact that no time zones have
 // more than one daylight savings offset change per month.
-// If this function is called with NaN it returns NaN.
 static LocalTimeOffset localTimeOffset(VM& vm, double ms, WTF::TimeType inputTimeType = WTF::UTCTime)
 {
-    LocalTimeOffsetCache& cache = vm.localTimeOffsetCache;
-    double start = cache.start;
-    double end = cache.end;
-    WTF::TimeType cachedTimeType = cache.timeType;
-
-    if (cachedTimeType == inputTimeType && start <= ms) {
-        // If the time fits in the cached interval, return the cached offset.
-        if (ms <= end) return cache.offset;
-
-        // Compute a possible new interval end.
-        double newEnd = end + cache.increment;
-
-        if (ms <= newEnd) {
-            LocalTimeOffset endOffset = calculateLocalTimeOffset(newEnd, inputTimeType);
-            if (cache.offset == endOffset) {
-                // If the offset at the end of the new interval still matches
-                // the offset in the cache, we grow the cached time interval
-                // and return the offset.
-                cache.end = newEnd;
-                cache.increment = msPerMonth;
-                return endOffset;
-            }
-            LocalTimeOffset offset = calculateLocalTimeOffset(ms, inputTimeType);
-            if (offset == endOffset) {
-                // The offset at the given time is equal to the offset at the
-                // new end of the interval, so that means that we've just skipped
-                // the point in time where the DST offset change occurred. Updated
-                // the interval to reflect this and reset the increment.
-                cache.start = ms;
-                cache.end = newEnd;
-                cache.increment = msPerMonth;
-            } else {
-                // The interval contains a DST offset change and the given time is
-                // before it. Adjust the increment to avoid a linear search for
-                // the offset change point and change the end of the interval.
-                cache.increment /= 3;
-                cache.end = ms;
-            }
-            // Update the offset in the cache and return it.
-            cache.offset = offset;
-            return offset;
+    if (!std::isfinite(ms))
+        return calculateLocalTimeOffset(ms, inputTimeType);
+
+    vm.resetDateCacheIfTimeZoneChanged();
+    Vector<LocalTimeOffsetCache::Period>& periods = vm.localTimeOffsetCache.periods[inputTimeType];
+    auto following = std::upper_bound(periods.begin(), periods.end(), ms, [] (double ms, const LocalTimeOffsetCache::Period& period) {
+        return ms < period.start;
+    });
+    size_t index = following - periods.begin();
+    if (index && ms <= periods[index - 1].end)
+        return periods[index - 1].offset;
+
+    LocalTimeOffsetCache::Period* previousPeriod = index ? &periods[index - 1] : nullptr;
+    LocalTimeOffsetCache::Period* followingPeriod = index < periods.size() ? &periods[index] : nullptr;
+    LocalTimeOffset offset = calculateLocalTimeOffset(ms, inputTimeType);
+
+    // Step away from the time a month at a time until the offset changes or a neighbouring period
+    // is reached, then find the exact time of the change.
+    double start = ms;
+    bool extendsPreviousPeriod = false;
+    for (unsigned i = 0; i < maxMonthsToProbeForOffsetChange; ++i) {
+        double probe = start - msPerMonth;
+        if (previousPeriod && probe <= previousPeriod->end) {
+            if (previousPeriod->offset == offset)
+                extendsPreviousPeriod = true;
+            else
+                start = findLocalTimeOffsetChange(start, previousPeriod->end, offset, inputTimeType);
+            break;
+        }
+        if (calculateLocalTimeOffset(probe, inputTimeType) != offset) {
+            start = findLocalTimeOffsetChange(start, probe, offset, inputTimeType);
+            break;
         }
+        start = probe;
     }
 
-    // Compute the DST offset for the time and shrink the cache interval
-    // to only contain the time. This allows fast repeated DST offset
-    // computations for the same time.
-    LocalTimeOffset offset = calculateLocalTimeOffset(ms, inputTimeType);
-    cache.offset = offset;
-    cache.start = ms;
-    cache.end = ms;
-    cache.increment = msPerMonth;
-    cache.timeType = inputTimeType;
+    double end = ms;
+    bool extendsFollowingPeriod = false;
+    for (unsigned i = 0; i < maxMonthsToProbeForOffsetChange; ++i) {
+        double probe = end + msPerMonth;
+        if (followingPeriod && probe >= followingPeriod->start) {
+            if (followingPeriod->offset == offset)
+                extendsFollowingPeriod = true;
+            else
+                end = findLocalTimeOffsetChange(end, followingPeriod->start, offset, inputTimeType);
+            break;
+        }
+        if (calculateLocalTimeOffset(probe, inputTimeType) != offset) {
+            end = findLocalTimeOffsetChange(end, probe, offset, inputTimeType);
+            break;
+        }
+        end = probe;
+    }
+
+    if (extendsPreviousPeriod && extendsFollowingPeriod) {
+        previousPeriod->end = followingPeriod->end;
+        periods.remove(index);
+    } else if (extendsPreviousPeriod)
+        previousPeriod->end = end;
+    else if (extendsFollowingPeriod)
+        followingPeriod->start = start;
+    else {
+        if (periods.size() == LocalTimeOffsetCache::maxPeriods) {
+            periods.clear();
+            index = 0;
+        }
+        periods.insert(index, LocalTimeOffsetCache::Period { start, end, offset });
+    }
     return offset;
 }
 
@@ -240,6 +274,7 @@ double parseDateFromNullTerminatedCharacters(VM& vm, const char* dateString)
 
 double parseDate(VM& vm, const String& date)
 {
+    vm.resetDateCacheIfTimeZoneChanged();
     if (date == vm.cachedDateString)
         return vm.cachedDateStringValue;
     double value = parseES5DateFromNullTerminatedCharacters(date.utf8().data());
@@ -178,6 +178,15 @@ public:
 
     static ElementType toAdaptorNativeFromValue(ExecState* exec, JSValue jsValue) { return toNativeFromValue<Adaptor>(exec, jsValue); }
 
+    // Like toAdaptorNativeFromValue, but returns false if the number does not survive the
+    // conversion, since then no element can be strictly equal to it.
+    static bool toAdaptorNativeFromValueExactly(ExecState* exec, JSValue jsValue, ElementType& result)
+    {
+        double number = jsValue.toNumber(exec);
+        result = Adaptor::toNativeFromDouble(number);
+        return static_cast<double>(result) == number;
+    }
+
     bool setRangeToValue(ExecState* exec, unsigned start, unsigned end, JSValue jsValue)
     {
         ASSERT(0 <= start && start <= end && end <= m_length);
@@ -186,8 +195,12 @@ public:
         if (exec->hadException())
             return false;
 
-        // We might want to do something faster here (e.g. SIMD) if this is too slow.
         typename Adaptor::Type* array = typedVector();
+        typename Adaptor::Type zero = 0;
+        if (sizeof(value) == 1 || !memcmp(&value, &zero, sizeof(value))) {
+            memset(array + start, *reinterpret_cast<uint8_t*>(&value), (end - start) * sizeof(value));
+            return true;
+        }
         for (unsigned i = start; i < end; ++i)
             array[i] = value;
 
@@ -203,12 +216,10 @@ public:
         case TypeFloat64:
             sortFloat<int64_t>();
             break;
-        default: {
-            ElementType* array = typedVector();
-            std::sort(array, array + m_length);
+        default:
+            sortIntegral(std::is_integral<ElementType>());
             break;
         }
-        }
     }
 
     bool canAccessRangeQuickly(unsigned offset, unsigned length)
@@ -353,8 +364,81 @@ private:
         purifyArray();
 
         IntegralType* array = reinterpret_cast_ptr<IntegralType*>(typedVector());
-        std::sort(array, array + m_length, sortComparison<IntegralType>);
+        if (m_length < minLengthForRadixSort || !radixSort<IntegralType, true>(array))
+            std::sort(array, array + m_length, sortComparison<IntegralType>);
+    }
+
+    void sortIntegral(std::false_type) { RELEASE_ASSERT_NOT_REACHED(); }
+
+    void sortIntegral(std::true_type)
+    {
+        ElementType* array = typedVector();
+        if (m_length < minLengthForRadixSort || !radixSort<ElementType, false>(array))
+            std::sort(array, array + m_length);
+    }
+
+    // Below this, std::sort beats the fixed cost of counting every byte of the elements.
+    static const unsigned minLengthForRadixSort = 256;
+
+    // Sorts the elements a byte at a time by their bits, mapped to unsigned keys that order the
+    // same way as the elements. For floats, negative numbers have all their bits flipped so that
+    // larger magnitudes come first, which gives the same order as sortComparison. Returns false,
+    // without touching the array, if there is no memory for the scratch buffer.
+    template<typename IntegralType, bool isFloat>
+    bool radixSort(IntegralType* array)
+    {
+        typedef typename std::make_unsigned<IntegralType>::type Key;
+        const Key signBit = static_cast<Key>(1) << (sizeof(Key) * 8 - 1);
+        const bool isSigned = std::is_signed<IntegralType>::value;
+
+        Vector<Key> buffer;
+        if (!buffer.tryReserveCapacity(m_length))
+            return false;
+        buffer.grow(m_length);
+
+        Key* keys = reinterpret_cast_ptr<Key*>(array);
+        unsigned counts[sizeof(Key)][256];
+        memset(counts, 0, sizeof(counts));
+        for (unsigned i = 0; i < m_length; ++i) {
+            Key key = keys[i];
+            if (isFloat)
+                key = (key & signBit) ? ~key : key ^ signBit;
+            else if (isSigned)
+                key ^= signBit;
+            keys[i] = key;
+            for (unsigned digit = 0; digit < sizeof(Key); ++digit)
+                ++counts[digit][(key >> (digit * 8)) & 0xff];
+        }
+
+        Key* from = keys;
+        Key* to = buffer.data();
+        for (unsigned digit = 0; digit < sizeof(Key); ++digit) {
+            unsigned* digitCounts = counts[digit];
+            // Every key has the same byte here, so this pass would not move anything.
+            if (digitCounts[(from[0] >> (digit * 8)) & 0xff] == m_length)
+                continue;
+            unsigned offset = 0;
+            for (unsigned value = 0; value < 256; ++value) {
+                unsigned count = digitCounts[value];
+                digitCounts[value] = offset;
+                offset += count;
+            }
+            for (unsigned i = 0; i < m_length; ++i) {
+                Key key = from[i];
+                to[digitCounts[(key >> (digit * 8)) & 0xff]++] = key;
+            }
+            std::swap(from, to);
+        }
 
+        for (unsigned i = 0; i < m_length; ++i) {
+            Key key = from[i];
+            if (isFloat)
+                key = (key & signBit) ? key ^ signBit : ~key;
+            else if (isSigned)
+                key ^= signBit;
+            keys[i] = key;
+        }
+        return true;
     }
 
 };
@@ -182,37 +182,33 @@ bool JSGenericTypedArrayView<Adaptor>::setWithSpecificType(
 
     unsigned otherElementSize = sizeof(typename OtherAdaptor::Type);
 
+    // The loops below go through raw pointers so that the compiler does not reload the vectors
+    // after every store, which it must do when storing bytes, and can vectorize conversions.
+    typename Adaptor::Type* to = typedVector() + offset;
+    const typename OtherAdaptor::Type* from = other->typedVector() + otherOffset;
+
     // Handle cases (1) and (2A).
     if (!hasArrayBuffer() || !other->hasArrayBuffer()
         || existingBuffer() != other->existingBuffer()
         || (elementSize == otherElementSize && vector() <= other->vector())
         || type == CopyType::LeftToRight) {
-        for (unsigned i = 0; i < length; ++i) {
-            setIndexQuicklyToNativeValue(
-                offset + i, OtherAdaptor::template convertTo<Adaptor>(
-                    other->getIndexQuicklyAsNativeValue(i + otherOffset)));
-        }
+        for (unsigned i = 0; i < length; ++i)
+            to[i] = OtherAdaptor::template convertTo<Adaptor>(from[i]);
         return true;
     }
 
     // Now we either have (2B) or (3) - so first we try to cover (2B).
     if (elementSize == otherElementSize) {
-        for (unsigned i = length; i--;) {
-            setIndexQuicklyToNativeValue(
-                offset + i, OtherAdaptor::template convertTo<Adaptor>(
-                    other->getIndexQuicklyAsNativeValue(i + otherOffset)));
-        }
+        for (unsigned i = length; i--;)
+            to[i] = OtherAdaptor::template convertTo<Adaptor>(from[i]);
         return true;
     }
 
     // Fail: we need an intermediate transfer buffer (i.e. case (3)).
     Vector<typename Adaptor::Type, 32> transferBuffer(length);
-    for (unsigned i = length; i--;) {
-        transferBuffer[i] = OtherAdaptor::template convertTo<Adaptor>(
-            other->getIndexQuicklyAsNativeValue(i + otherOffset));
-    }
     for (unsigned i = length; i--;)
-        setIndexQuicklyToNativeValue(offset + i, transferBuffer[i]);
+        transferBuffer[i] = OtherAdaptor::template convertTo<Adaptor>(from[i]);
+    memcpy(to, transferBuffer.data(), length * elementSize);
 
     return true;
 }
@@ -220,9 +220,19 @@ EncodedJSValue JSC_HOST_CALL genericTypedArrayViewProtoFuncIndexOf(ExecState* ex
     unsigned index = argumentClampedIndexFromStartOrEnd(exec, 1, length);
 
     typename ViewClass::ElementType* array = thisObject->typedVector();
-    typename ViewClass::ElementType target = ViewClass::toAdaptorNativeFromValue(exec, valueToFind);
+    typename ViewClass::ElementType target;
+    bool canBeFound = ViewClass::toAdaptorNativeFromValueExactly(exec, valueToFind, target);
     if (exec->hadException())
         return JSValue::encode(jsUndefined());
+    if (!canBeFound || index >= length)
+        return JSValue::encode(jsNumber(-1));
+
+    if (sizeof(target) == 1) {
+        const void* result = memchr(array + index, *reinterpret_cast<uint8_t*>(&target), length - index);
+        if (!result)
+            return JSValue::encode(jsNumber(-1));
+        return JSValue::encode(jsNumber(static_cast<const typename ViewClass::ElementType*>(result) - array));
+    }
 
     for (; index < length; ++index) {
         if (array[index] == target)
@@ -307,9 +317,12 @@ EncodedJSValue JSC_HOST_CALL genericTypedArrayViewProtoFuncLastIndexOf(ExecState
     }
 
     typename ViewClass::ElementType* array = thisObject->typedVector();
-    typename ViewClass::ElementType target = ViewClass::toAdaptorNativeFromValue(exec, valueToFind);
+    typename ViewClass::ElementType target;
+    bool canBeFound = ViewClass::toAdaptorNativeFromValueExactly(exec, valueToFind, target);
     if (exec->hadException())
         return JSValue::encode(jsUndefined());
+    if (!canBeFound)
+        return JSValue::encode(jsNumber(-1));
 
     for (; index >= 0; --index) {
         if (array[index] == target)
@@ -46,7 +46,7 @@ void JSMap::destroy(JSCell* cell)
 size_t JSMap::estimatedSize(JSCell* cell)
 {
     JSMap* thisObject = jsCast<JSMap*>(cell);
-    size_t mapDataSize = thisObject->m_mapData.capacityInBytes();
+    size_t mapDataSize = thisObject->m_mapData.capacityInBytes() + thisObject->m_mapData.indexCapacityInBytes();
     return Base::estimatedSize(cell) + mapDataSize;
 }
 
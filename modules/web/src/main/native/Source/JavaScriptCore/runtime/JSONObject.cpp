@@ -38,6 +38,8 @@
 #include "ObjectConstructor.h"
 #include "JSCInlines.h"
 #include "PropertyNameArray.h"
+#include "StrongInlines.h"
+#include <wtf/HashMap.h>
 #include <wtf/MathExtras.h>
 #include <wtf/text/StringBuilder.h>
 
@@ -90,6 +92,23 @@ public:
     void visitAggregate(SlotVisitor&);
 
 private:
+    // The enumerable keys of a plain object, already quoted for output, along with
+    // where each one lives. Arrays of records mostly share a few structures, so the
+    // keys are enumerated and quoted once per structure rather than once per object.
+    struct CachedKey {
+        Identifier name;
+        PropertyOffset offset;
+        String quotedName;
+    };
+    struct CachedKeys {
+        // Keeps the structure alive, so another structure cannot reuse its address while cached.
+        Strong<Structure> structure;
+        Vector<CachedKey> keys;
+    };
+    static const unsigned maximumCachedStructures = 64;
+
+    const CachedKeys* cachedKeysFor(JSObject*);
+
     class Holder {
     public:
         Holder(VM&, JSObject*);
@@ -105,6 +124,7 @@ private:
         unsigned m_index;
         unsigned m_size;
         RefPtr<PropertyNameArrayData> m_propertyNames;
+        const CachedKeys* m_cachedKeys;
     };
 
     friend class Holder;
@@ -131,6 +151,7 @@ private:
     Vector<Holder, 16, UnsafeVectorOverflow> m_holderStack;
     String m_repeatedGap;
     String m_indent;
+    HashMap<Structure*, std::unique_ptr<CachedKeys>> m_cachedKeys;
 };
 
 // ------------------------------ helper functions --------------------------------
@@ -167,7 +188,7 @@ static inline String gap(ExecState* exec, JSValue space)
             count = 0;
         else
             count = static_cast<int>(spaceCount);
-        UChar spaces[maxGapLength];
+        LChar spaces[maxGapLength];
         for (int i = 0; i < count; ++i)
             spaces[i] = ' ';
         return String(spaces, count);
@@ -379,6 +400,47 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
     return StringifySucceeded;
 }
 
+const Stringifier::CachedKeys* Stringifier::cachedKeysFor(JSObject* object)
+{
+    VM& vm = m_exec->vm();
+    Structure* structure = object->structure(vm);
+
+    auto iterator = m_cachedKeys.find(structure);
+    if (iterator != m_cachedKeys.end())
+        return iterator->value.get();
+
+    // Only plain objects whose properties are all plain values in the structure qualify.
+    if (structure->typeInfo().type() != FinalObjectType
+        || structure->isDictionary()
+        || structure->hasGetterSetterProperties()
+        || structure->hasCustomGetterSetterProperties()
+        || hasIndexedProperties(structure->indexingType())
+        || m_cachedKeys.size() >= maximumCachedStructures)
+        return nullptr;
+
+    PropertyNameArray propertyNames(m_exec, PropertyNameMode::Strings);
+    object->methodTable(vm)->getOwnPropertyNames(object, m_exec, propertyNames, EnumerationMode());
+
+    auto cachedKeys = std::make_unique<CachedKeys>();
+    cachedKeys->keys.reserveInitialCapacity(propertyNames.size());
+    for (const Identifier& name : propertyNames) {
+        unsigned attributes;
+        PropertyOffset offset = structure->get(vm, name, attributes);
+        if (!isValidOffset(offset) || (attributes & (Accessor | CustomAccessor)))
+            return nullptr;
+
+        StringBuilder quotedName;
+        quotedName.appendQuotedJSONString(name.string());
+        quotedName.append(':');
+        cachedKeys->keys.uncheckedAppend(CachedKey { name, offset, quotedName.toString() });
+    }
+    cachedKeys->structure.set(vm, structure);
+
+    const CachedKeys* result = cachedKeys.get();
+    m_cachedKeys.add(structure, WTFMove(cachedKeys));
+    return result;
+}
+
 inline bool Stringifier::willIndent() const
 {
     return !m_gap.isEmpty();
@@ -415,6 +477,7 @@ inline Stringifier::Holder::Holder(VM& vm, JSObject* object)
 #ifndef NDEBUG
     , m_size(0)
 #endif
+    , m_cachedKeys(nullptr)
 {
 }
 
@@ -434,14 +497,17 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
                 m_size = m_object->get(exec, exec->vm().propertyNames->length).toUInt32(exec);
             builder.append('[');
         } else {
-            if (stringifier.m_usingArrayReplacer)
+            if (stringifier.m_usingArrayReplacer) {
                 m_propertyNames = stringifier.m_arrayReplacerPropertyNames.data();
+                m_size = m_propertyNames->propertyNameVector().size();
+            } else if ((m_cachedKeys = stringifier.cachedKeysFor(m_object.get())))
+                m_size = m_cachedKeys->keys.size();
             else {
                 PropertyNameArray objectPropertyNames(exec, PropertyNameMode::Strings);
                 m_object->methodTable()->getOwnPropertyNames(m_object.get(), exec, objectPropertyNames, EnumerationMode());
                 m_propertyNames = objectPropertyNames.releaseData();
+                m_size = m_propertyNames->propertyNameVector().size();
             }
-            m_size = m_propertyNames->propertyNameVector().size();
             builder.append('{');
         }
         stringifier.indent();
@@ -482,6 +548,36 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
 
         // Append the stringified value.
         stringifyResult = stringifier.appendStringifiedValue(builder, value, m_object.get(), index);
+    } else if (m_cachedKeys) {
+        // Get the value, straight from its slot unless a toJSON or replacer function
+        // changed the object's shape while stringifying an earlier property.
+        const CachedKey& key = m_cachedKeys->keys[index];
+        JSValue value;
+        if (m_object->structure(exec->vm()) == m_cachedKeys->structure.get())
+            value = m_object->getDirect(key.offset);
+        else {
+            PropertySlot slot(m_object.get(), PropertySlot::InternalMethodType::Get);
+            if (!m_object->methodTable()->getOwnPropertySlot(m_object.get(), exec, key.name, slot))
+                return true;
+            value = slot.getValue(exec, key.name);
+            if (exec->hadException())
+                return false;
+        }
+
+        rollBackPoint = builder.length();
+
+        // Append the separator string.
+        if (builder[rollBackPoint - 1] != '{')
+            builder.append(',');
+        stringifier.startNewLine(builder);
+
+        // Append the property name, which is already quoted and followed by the colon.
+        builder.append(key.quotedName);
+        if (stringifier.willIndent())
+            builder.append(' ');
+
+        // Append the stringified value.
+        stringifyResult = stringifier.appendStringifiedValue(builder, value, m_object.get(), key.name);
     } else {
         // Get the value.
         PropertySlot slot(m_object.get(), PropertySlot::InternalMethodType::Get);
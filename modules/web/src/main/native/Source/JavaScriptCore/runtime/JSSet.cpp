@@ -46,7 +46,7 @@ void JSSet::destroy(JSCell* cell)
 size_t JSSet::estimatedSize(JSCell* cell)
 {
     JSSet* thisObject = jsCast<JSSet*>(cell);
-    size_t setDataSize = thisObject->m_setData.capacityInBytes();
+    size_t setDataSize = thisObject->m_setData.capacityInBytes() + thisObject->m_setData.indexCapacityInBytes();
     return Base::estimatedSize(cell) + setDataSize;
 }
 
@@ -105,6 +105,8 @@ void JSRopeString::visitFibers(SlotVisitor& visitor)
 }
 
 static const unsigned maxLengthForOnStackResolve = 2048;
+static const unsigned minLengthForExtensibleResolve = 256;
+static const unsigned maxSpareCapacityForExtensibleResolve = 1 << 22;
 
 void JSRopeString::resolveRopeInternal8(LChar* buffer) const
 {
@@ -239,6 +241,47 @@ RefPtr<AtomicStringImpl> JSRopeString::resolveRopeToExistingAtomicString(ExecSta
     return nullptr;
 }
 
+const JSString* JSRopeString::leftmostFiber(const JSString* string)
+{
+    while (string && string->isRope() && !string->isSubstring())
+        string = static_cast<const JSRopeString*>(string)->fiber(0).get();
+    return string;
+}
+
+// Appending to a string in a loop builds ropes whose leftmost fiber is the string's previous,
+// already resolved value. If that value lives at the start of vm.ropeResolveBuffer, only the
+// characters appended since then need to be copied; nothing else can see the part of the
+// buffer past ropeResolveBufferLength.
+bool JSRopeString::resolveRopeByAppending(VM& vm) const
+{
+    StringImpl* buffer = vm.ropeResolveBuffer.get();
+    if (!buffer || buffer->is8Bit() != is8Bit() || m_length > buffer->length())
+        return false;
+
+    const JSString* leftmost = leftmostFiber(this);
+    if (!leftmost || leftmost->isRope())
+        return false;
+    StringImpl* prefix = leftmost->m_value.impl();
+    unsigned prefixLength = vm.ropeResolveBufferLength;
+    if (prefix->length() != prefixLength || prefix->is8Bit() != buffer->is8Bit())
+        return false;
+
+    if (is8Bit()) {
+        if (prefix->characters8() != buffer->characters8())
+            return false;
+        resolveRopeSlowCase8(const_cast<LChar*>(buffer->characters8()), prefixLength);
+    } else {
+        if (prefix->characters16() != buffer->characters16())
+            return false;
+        resolveRopeSlowCase(const_cast<UChar*>(buffer->characters16()), prefixLength);
+    }
+
+    m_value = StringImpl::createSubstringSharingImpl(buffer, 0, m_length);
+    vm.ropeResolveBufferLength = m_length;
+    vm.lastResolvedRope = this;
+    return true;
+}
+
 void JSRopeString::resolveRope(ExecState* exec) const
 {
     ASSERT(isRope());
@@ -250,31 +293,50 @@ void JSRopeString::resolveRope(ExecState* exec) const
         return;
     }
 
-    if (is8Bit()) {
-        LChar* buffer;
-        if (RefPtr<StringImpl> newImpl = StringImpl::tryCreateUninitialized(m_length, buffer)) {
-            Heap::heap(this)->reportExtraMemoryAllocated(newImpl->cost());
-            m_value = newImpl.release();
-        } else {
-            outOfMemory(exec);
-            return;
-        }
-        resolveRopeInternal8NoSubstring(buffer);
+    VM& vm = *Heap::heap(this)->vm();
+    if (resolveRopeByAppending(vm)) {
         clearFibers();
         ASSERT(!isRope());
         return;
     }
 
-    UChar* buffer;
-    if (RefPtr<StringImpl> newImpl = StringImpl::tryCreateUninitialized(m_length, buffer)) {
-        Heap::heap(this)->reportExtraMemoryAllocated(newImpl->cost());
-        m_value = newImpl.release();
+    // A rope built on top of the previous long rope we resolved is being appended to in a loop,
+    // so give it room to grow in place. Ropes that are resolved once get no spare capacity, as
+    // nothing can shrink their buffer later while the string is alive.
+    unsigned capacity = m_length;
+    if (m_length >= minLengthForExtensibleResolve) {
+        if (leftmostFiber(this) == vm.lastResolvedRope && fiber(0)->length() >= m_length / 2) {
+            unsigned spareCapacity = std::min(m_length / 2, maxSpareCapacityForExtensibleResolve);
+            capacity = std::min<unsigned>(m_length + spareCapacity, std::numeric_limits<int32_t>::max());
+        }
+        vm.lastResolvedRope = this;
+    }
+
+    RefPtr<StringImpl> newImpl;
+    if (is8Bit()) {
+        LChar* buffer;
+        newImpl = StringImpl::tryCreateUninitialized(capacity, buffer);
+        if (newImpl)
+            resolveRopeInternal8NoSubstring(buffer);
     } else {
+        UChar* buffer;
+        newImpl = StringImpl::tryCreateUninitialized(capacity, buffer);
+        if (newImpl)
+            resolveRopeInternal16NoSubstring(buffer);
+    }
+    if (!newImpl) {
         outOfMemory(exec);
         return;
     }
 
-    resolveRopeInternal16NoSubstring(buffer);
+    Heap::heap(this)->reportExtraMemoryAllocated(newImpl->cost());
+    if (capacity == m_length)
+        m_value = newImpl.release();
+    else {
+        m_value = StringImpl::createSubstringSharingImpl(newImpl, 0, m_length);
+        vm.ropeResolveBuffer = newImpl.release();
+        vm.ropeResolveBufferLength = m_length;
+    }
     clearFibers();
     ASSERT(!isRope());
 }
@@ -289,15 +351,16 @@ void JSRopeString::resolveRope(ExecState* exec) const
 // Vector before performing any concatenation, but by working backwards we likely
 // only fill the queue with the number of substrings at any given level in a
 // rope-of-ropes.)
-void JSRopeString::resolveRopeSlowCase8(LChar* buffer) const
+void JSRopeString::resolveRopeSlowCase8(LChar* buffer, unsigned prefixLength) const
 {
     LChar* position = buffer + m_length; // We will be working backwards over the rope.
+    LChar* end = buffer + prefixLength; // The leftmost prefixLength characters are already in place.
     Vector<JSString*, 32, UnsafeVectorOverflow> workQueue; // Putting strings into a Vector is only OK because there are no GC points in this method.
 
     for (size_t i = 0; i < s_maxInternalRopeLength && fiber(i); ++i)
         workQueue.append(fiber(i).get());
 
-    while (!workQueue.isEmpty()) {
+    while (position != end) {
         JSString* currentFiber = workQueue.last();
         workQueue.removeLast();
 
@@ -322,18 +385,19 @@ void JSRopeString::resolveRopeSlowCase8(LChar* buffer) const
         StringImpl::copyChars(position, characters, length);
     }
 
-    ASSERT(buffer == position);
+    ASSERT(end == position);
 }
 
-void JSRopeString::resolveRopeSlowCase(UChar* buffer) const
+void JSRopeString::resolveRopeSlowCase(UChar* buffer, unsigned prefixLength) const
 {
     UChar* position = buffer + m_length; // We will be working backwards over the rope.
+    UChar* end = buffer + prefixLength; // The leftmost prefixLength characters are already in place.
     Vector<JSString*, 32, UnsafeVectorOverflow> workQueue; // These strings are kept alive by the parent rope, so using a Vector is OK.
 
     for (size_t i = 0; i < s_maxInternalRopeLength && fiber(i); ++i)
         workQueue.append(fiber(i).get());
 
-    while (!workQueue.isEmpty()) {
+    while (position != end) {
         JSString* currentFiber = workQueue.last();
         workQueue.removeLast();
 
@@ -366,7 +430,7 @@ void JSRopeString::resolveRopeSlowCase(UChar* buffer) const
             StringImpl::copyChars(position, string->characters16(), length);
     }
 
-    ASSERT(buffer == position);
+    ASSERT(end == position);
 }
 
 void JSRopeString::outOfMemory(ExecState* exec) const
@@ -358,8 +358,11 @@ public:
 
     static JSString* create(ExecState& exec, JSString& base, unsigned offset, unsigned length)
     {
+        JSString& narrowedBase = narrowSubstringBase(base, offset, length);
+        if (!offset && length == narrowedBase.length())
+            return &narrowedBase;
         JSRopeString* newString = new (NotNull, allocateCell<JSRopeString>(exec.vm().heap)) JSRopeString(exec.vm());
-        newString->finishCreation(exec, base, offset, length);
+        newString->finishCreation(exec, narrowedBase, offset, length);
         return newString;
     }
 
@@ -376,8 +379,10 @@ private:
     JS_EXPORT_PRIVATE void resolveRope(ExecState*) const;
     JS_EXPORT_PRIVATE void resolveRopeToAtomicString(ExecState*) const;
     JS_EXPORT_PRIVATE RefPtr<AtomicStringImpl> resolveRopeToExistingAtomicString(ExecState*) const;
-    void resolveRopeSlowCase8(LChar*) const;
-    void resolveRopeSlowCase(UChar*) const;
+    static const JSString* leftmostFiber(const JSString*);
+    bool resolveRopeByAppending(VM&) const;
+    void resolveRopeSlowCase8(LChar*, unsigned prefixLength = 0) const;
+    void resolveRopeSlowCase(UChar*, unsigned prefixLength = 0) const;
     void outOfMemory(ExecState*) const;
     void resolveRopeInternal8(LChar*) const;
     void resolveRopeInternal8NoSubstring(LChar*) const;
@@ -394,6 +399,32 @@ private:
         return u[i].string;
     }
 
+    // Descends into the fibers of a rope base for as long as one of them holds the whole
+    // range, so that taking a substring doesn't force the entire base to be resolved.
+    static JSString& narrowSubstringBase(JSString& base, unsigned& offset, unsigned length)
+    {
+        JSString* current = &base;
+        while (current->isRope() && !current->isSubstring()) {
+            JSRopeString* rope = static_cast<JSRopeString*>(current);
+            unsigned fiberOffset = offset;
+            JSString* next = nullptr;
+            for (size_t i = 0; i < s_maxInternalRopeLength && rope->fiber(i); ++i) {
+                JSString* fiber = rope->fiber(i).get();
+                if (fiberOffset < fiber->length()) {
+                    if (fiberOffset + length <= fiber->length())
+                        next = fiber;
+                    break;
+                }
+                fiberOffset -= fiber->length();
+            }
+            if (!next)
+                break;
+            current = next;
+            offset = fiberOffset;
+        }
+        return *current;
+    }
+
     WriteBarrierBase<JSString>& substringBase() const
     {
         return u[1].string;
@@ -38,6 +38,7 @@
 #include "StrongInlines.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/dtoa.h>
+#include <wtf/text/ASCIIFastPath.h>
 #include <wtf/text/StringBuilder.h>
 
 namespace JSC {
@@ -131,43 +132,27 @@ bool LiteralParser<CharType>::tryJSONPParse(Vector<JSONPData>& results, bool nee
 }
 
 template <typename CharType>
-ALWAYS_INLINE const Identifier LiteralParser<CharType>::makeIdentifier(const LChar* characters, size_t length)
+template <typename IdentifierCharType>
+ALWAYS_INLINE const Identifier LiteralParser<CharType>::makeIdentifier(const IdentifierCharType* characters, size_t length)
 {
     if (!length)
         return m_exec->vm().propertyNames->emptyIdentifier;
-    if (characters[0] >= MaximumCachableCharacter)
-        return Identifier::fromString(&m_exec->vm(), characters, length);
 
-    if (length == 1) {
+    if (length == 1 && characters[0] < MaximumCachableCharacter) {
         if (!m_shortIdentifiers[characters[0]].isNull())
             return m_shortIdentifiers[characters[0]];
         m_shortIdentifiers[characters[0]] = Identifier::fromString(&m_exec->vm(), characters, length);
         return m_shortIdentifiers[characters[0]];
     }
-    if (!m_recentIdentifiers[characters[0]].isNull() && Identifier::equal(m_recentIdentifiers[characters[0]].impl(), characters, length))
-        return m_recentIdentifiers[characters[0]];
-    m_recentIdentifiers[characters[0]] = Identifier::fromString(&m_exec->vm(), characters, length);
-    return m_recentIdentifiers[characters[0]];
-}
 
-template <typename CharType>
-ALWAYS_INLINE const Identifier LiteralParser<CharType>::makeIdentifier(const UChar* characters, size_t length)
-{
-    if (!length)
-        return m_exec->vm().propertyNames->emptyIdentifier;
-    if (characters[0] >= MaximumCachableCharacter)
-        return Identifier::fromString(&m_exec->vm(), characters, length);
-
-    if (length == 1) {
-        if (!m_shortIdentifiers[characters[0]].isNull())
-            return m_shortIdentifiers[characters[0]];
-        m_shortIdentifiers[characters[0]] = Identifier::fromString(&m_exec->vm(), characters, length);
-        return m_shortIdentifiers[characters[0]];
-    }
-    if (!m_recentIdentifiers[characters[0]].isNull() && Identifier::equal(m_recentIdentifiers[characters[0]].impl(), characters, length))
-        return m_recentIdentifiers[characters[0]];
-    m_recentIdentifiers[characters[0]] = Identifier::fromString(&m_exec->vm(), characters, length);
-    return m_recentIdentifiers[characters[0]];
+    // The keys of objects in an array repeat, and often share their first character
+    // ("id", "index", "items"), so pick the slot using the last character and the length too.
+    unsigned slot = (characters[0] + characters[length - 1] * 7 + static_cast<unsigned>(length) * 31) % RecentIdentifierCacheSize;
+    Identifier& recent = m_recentIdentifiers[slot];
+    if (!recent.isNull() && Identifier::equal(recent.impl(), characters, length))
+        return recent;
+    recent = Identifier::fromString(&m_exec->vm(), characters, length);
+    return recent;
 }
 
 template <typename CharType>
@@ -354,6 +339,8 @@ template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParse
     StringBuilder builder;
     do {
         runStart = m_ptr;
+        if (mode == StrictJSON && terminator == '"')
+            m_ptr = WTF::skipCharactersNotNeedingJSONEscape(m_ptr, m_end);
         while (m_ptr < m_end && isSafeStringCharacter<mode, CharType, terminator>(*m_ptr))
             ++m_ptr;
         if (builder.length())
@@ -452,6 +439,16 @@ template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParse
     return TokString;
 }
 
+// Powers of ten that are exactly representable as doubles.
+static const double exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int maximumExactPowerOfTen = WTF_ARRAY_LENGTH(exactPowersOfTen) - 1;
+
+// Doubles hold every integer with up to 15 decimal digits exactly.
+static const unsigned maximumExactSignificandDigits = 15;
+
 template <typename CharType>
 TokenType LiteralParser<CharType>::Lexer::lexNumber(LiteralParserToken<CharType>& token)
 {
@@ -468,18 +465,32 @@ TokenType LiteralParser<CharType>::Lexer::lexNumber(LiteralParserToken<CharType>
     //     digit digits?
     //
     // -?(0 | [1-9][0-9]*) ('.' [0-9]+)? ([eE][+-]? [0-9]+)?
+    //
+    // The digits are accumulated while scanning. When the significand and the
+    // power of ten are both exact doubles, a single multiplication or division
+    // rounds correctly, so only longer numbers need the general parseDouble().
 
-    if (m_ptr < m_end && *m_ptr == '-') // -?
+    bool negative = false;
+    if (m_ptr < m_end && *m_ptr == '-') { // -?
+        negative = true;
         ++m_ptr;
+    }
+
+    uint64_t significand = 0;
+    unsigned digitCount = 0;
+    int exponent = 0;
 
     // (0 | [1-9][0-9]*)
     if (m_ptr < m_end && *m_ptr == '0') // 0
         ++m_ptr;
     else if (m_ptr < m_end && *m_ptr >= '1' && *m_ptr <= '9') { // [1-9]
-        ++m_ptr;
         // [0-9]*
-        while (m_ptr < m_end && isASCIIDigit(*m_ptr))
+        do {
+            if (digitCount < maximumExactSignificandDigits)
+                significand = significand * 10 + (*m_ptr - '0');
+            ++digitCount;
             ++m_ptr;
+        } while (m_ptr < m_end && isASCIIDigit(*m_ptr));
     } else {
         m_lexErrorMessage = ASCIILiteral("Invalid number");
         return TokError;
@@ -494,25 +505,16 @@ TokenType LiteralParser<CharType>::Lexer::lexNumber(LiteralParserToken<CharType>
             return TokError;
         }
 
-        ++m_ptr;
-        while (m_ptr < m_end && isASCIIDigit(*m_ptr))
+        do {
+            // Leading zeros of a fraction like 0.001 are not significant.
+            if (digitCount || *m_ptr != '0') {
+                if (digitCount < maximumExactSignificandDigits)
+                    significand = significand * 10 + (*m_ptr - '0');
+                ++digitCount;
+            }
+            --exponent;
             ++m_ptr;
-    } else if (m_ptr < m_end && (*m_ptr != 'e' && *m_ptr != 'E') && (m_ptr - token.start) < 10) {
-        double result = 0;
-        token.type = TokNumber;
-        token.end = m_ptr;
-        const CharType* digit = token.start;
-        int negative = 1;
-        if (*digit == '-') {
-            negative = -1;
-            digit++;
-        }
-
-        while (digit < m_ptr)
-            result = result * 10 + (*digit++) - '0';
-        result *= negative;
-        token.numberToken = result;
-        return TokNumber;
+        } while (m_ptr < m_end && isASCIIDigit(*m_ptr));
     }
 
     //  ([eE][+-]? [0-9]+)?
@@ -520,8 +522,11 @@ TokenType LiteralParser<CharType>::Lexer::lexNumber(LiteralParserToken<CharType>
         ++m_ptr;
 
         // [-+]?
-        if (m_ptr < m_end && (*m_ptr == '-' || *m_ptr == '+'))
+        bool negativeExponent = false;
+        if (m_ptr < m_end && (*m_ptr == '-' || *m_ptr == '+')) {
+            negativeExponent = *m_ptr == '-';
             ++m_ptr;
+        }
 
         // [0-9]+
         if (m_ptr >= m_end || !isASCIIDigit(*m_ptr)) {
@@ -529,13 +534,29 @@ TokenType LiteralParser<CharType>::Lexer::lexNumber(LiteralParserToken<CharType>
             return TokError;
         }
 
-        ++m_ptr;
-        while (m_ptr < m_end && isASCIIDigit(*m_ptr))
+        int explicitExponent = 0;
+        do {
+            // Anything this large is out of the fast path's range anyway.
+            if (explicitExponent < 10000)
+                explicitExponent = explicitExponent * 10 + (*m_ptr - '0');
             ++m_ptr;
+        } while (m_ptr < m_end && isASCIIDigit(*m_ptr));
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
     }
 
     token.type = TokNumber;
     token.end = m_ptr;
+
+    if (digitCount <= maximumExactSignificandDigits && exponent >= -maximumExactPowerOfTen && exponent <= maximumExactPowerOfTen) {
+        double result = static_cast<double>(significand);
+        if (exponent >= 0)
+            result *= exactPowersOfTen[exponent];
+        else
+            result /= exactPowersOfTen[-exponent];
+        token.numberToken = negative ? -result : result;
+        return TokNumber;
+    }
+
     size_t parsedLength;
     token.numberToken = parseDouble(token.start, token.end - token.start, parsedLength);
     return TokNumber;
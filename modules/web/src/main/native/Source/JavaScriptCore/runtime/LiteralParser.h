@@ -156,10 +156,10 @@ private:
     ParserMode m_mode;
     String m_parseErrorMessage;
     static unsigned const MaximumCachableCharacter = 128;
+    static unsigned const RecentIdentifierCacheSize = 256;
     std::array<Identifier, MaximumCachableCharacter> m_shortIdentifiers;
-    std::array<Identifier, MaximumCachableCharacter> m_recentIdentifiers;
-    ALWAYS_INLINE const Identifier makeIdentifier(const LChar* characters, size_t length);
-    ALWAYS_INLINE const Identifier makeIdentifier(const UChar* characters, size_t length);
+    std::array<Identifier, RecentIdentifierCacheSize> m_recentIdentifiers;
+    template <typename IdentifierCharType> ALWAYS_INLINE const Identifier makeIdentifier(const IdentifierCharType* characters, size_t length);
     };
 
 }
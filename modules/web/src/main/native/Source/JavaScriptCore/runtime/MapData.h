@@ -30,7 +30,6 @@
 #include "JSCell.h"
 #include "WeakGCMapInlines.h"
 #include <wtf/HashFunctions.h>
-#include <wtf/HashMap.h>
 #include <wtf/MathExtras.h>
 #include <wtf/RefCounted.h>
 #include <wtf/RefPtr.h>
@@ -112,18 +111,40 @@ public:
     void copyBackingStore(CopyVisitor&, CopyToken);
 
     size_t capacityInBytes() const { return m_capacity * sizeof(Entry); }
+    size_t indexCapacityInBytes() const { return m_index.capacity() * sizeof(IndexSlot); }
 
 private:
-    typedef WTF::UnsignedWithZeroKeyHashTraits<int32_t> IndexTraits;
+    // Keys of every kind share one open addressing table of indexes into
+    // m_entries, probed linearly. Each slot caches the hash of its key, so
+    // probing and rehashing only read an entry once the hashes match.
+    struct IndexSlot {
+        int32_t entryIndex;
+        unsigned hash;
+    };
 
-    typedef HashMap<JSCell*, int32_t, typename WTF::DefaultHash<JSCell*>::Hash, WTF::HashTraits<JSCell*>, IndexTraits> CellKeyedMap;
-    typedef HashMap<EncodedJSValue, int32_t, EncodedJSValueHash, EncodedJSValueHashTraits, IndexTraits> ValueKeyedMap;
-    typedef HashMap<StringImpl*, int32_t, typename WTF::DefaultHash<StringImpl*>::Hash, WTF::HashTraits<StringImpl*>, IndexTraits> StringKeyedMap;
-    typedef HashMap<SymbolImpl*, int32_t, typename WTF::PtrHash<SymbolImpl*>, WTF::HashTraits<SymbolImpl*>, IndexTraits> SymbolKeyedMap;
+    enum : int32_t {
+        emptyEntryIndex = -1,
+        deletedEntryIndex = -2,
+        minimumIndexSize = 16
+    };
+
+    // A key with its string contents resolved, so that equal strings in
+    // different JSStrings hash and compare the same.
+    struct LookupKey {
+        JSValue value;
+        const StringImpl* impl;
+        unsigned hash;
+    };
+
+    ALWAYS_INLINE LookupKey lookupKey(ExecState*, KeyType);
+    ALWAYS_INLINE bool keyMatches(const LookupKey&, JSValue entryKey) const;
+    ALWAYS_INLINE IndexSlot* findSlot(const LookupKey&);
 
     ALWAYS_INLINE Entry* find(ExecState*, KeyType);
     ALWAYS_INLINE Entry* add(ExecState*, JSCell* owner, KeyType);
-    template <typename Map, typename Key> ALWAYS_INLINE Entry* add(ExecState*, JSCell* owner, Map&, Key, KeyType);
+
+    void ensureIndexSpaceForAppend();
+    void rehashIndex(unsigned newSize);
 
     ALWAYS_INLINE bool shouldPack() const { return m_deletedCount; }
     CheckedBoolean ensureSpaceForAppend(ExecState*, JSCell* owner);
@@ -131,10 +152,8 @@ private:
     ALWAYS_INLINE void replaceAndPackBackingStore(Entry* destination, int32_t newSize);
     ALWAYS_INLINE void replaceBackingStore(Entry* destination, int32_t newSize);
 
-    CellKeyedMap m_cellKeyedTable;
-    ValueKeyedMap m_valueKeyedTable;
-    StringKeyedMap m_stringKeyedTable;
-    SymbolKeyedMap m_symbolKeyedTable;
+    Vector<IndexSlot> m_index;
+    unsigned m_indexDeletedCount;
     int32_t m_capacity;
     int32_t m_size;
     int32_t m_deletedCount;
@@ -145,7 +164,8 @@ private:
 
 template<typename Entry, typename JSIterator>
 ALWAYS_INLINE MapDataImpl<Entry, JSIterator>::MapDataImpl(VM& vm, JSCell* owner)
-    : m_capacity(0)
+    : m_indexDeletedCount(0)
+    , m_capacity(0)
     , m_size(0)
     , m_deletedCount(0)
     , m_owner(owner)
@@ -162,7 +182,9 @@ ALWAYS_INLINE MapDataImpl<Entry, JSIterator>::KeyType::KeyType(JSValue v)
     }
     double d = v.asDouble();
     if (std::isnan(d)) {
-        value = v;
+        // Keys are hashed and compared by their encoding, and arithmetic in the
+        // interpreter can produce NaNs other than the canonical one.
+        value = jsNaN();
         return;
     }
 
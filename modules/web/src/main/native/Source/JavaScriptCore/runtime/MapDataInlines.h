@@ -40,10 +40,8 @@ namespace JSC {
 template<typename Entry, typename JSIterator>
 inline void MapDataImpl<Entry, JSIterator>::clear()
 {
-    m_cellKeyedTable.clear();
-    m_valueKeyedTable.clear();
-    m_stringKeyedTable.clear();
-    m_symbolKeyedTable.clear();
+    m_index.clear();
+    m_indexDeletedCount = 0;
     m_capacity = 0;
     m_size = 0;
     m_deletedCount = 0;
@@ -54,56 +52,68 @@ inline void MapDataImpl<Entry, JSIterator>::clear()
 }
 
 template<typename Entry, typename JSIterator>
-inline Entry* MapDataImpl<Entry, JSIterator>::find(ExecState* exec, KeyType key)
+inline auto MapDataImpl<Entry, JSIterator>::lookupKey(ExecState* exec, KeyType key) -> LookupKey
 {
+    LookupKey result;
+    result.value = key.value;
+    result.impl = nullptr;
     if (key.value.isString()) {
-        auto iter = m_stringKeyedTable.find(asString(key.value)->value(exec).impl());
-        if (iter == m_stringKeyedTable.end())
-            return 0;
-        return &m_entries.get(m_owner)[iter->value];
-    }
-    if (key.value.isSymbol()) {
-        auto iter = m_symbolKeyedTable.find(asSymbol(key.value)->privateName().uid());
-        if (iter == m_symbolKeyedTable.end())
-            return 0;
-        return &m_entries.get(m_owner)[iter->value];
-    }
-    if (key.value.isCell()) {
-        auto iter = m_cellKeyedTable.find(key.value.asCell());
-        if (iter == m_cellKeyedTable.end())
-            return 0;
-        return &m_entries.get(m_owner)[iter->value];
-    }
-
-    auto iter = m_valueKeyedTable.find(JSValue::encode(key.value));
-    if (iter == m_valueKeyedTable.end())
-        return 0;
-    return &m_entries.get(m_owner)[iter->value];
+        result.impl = asString(key.value)->value(exec).impl();
+        // Resolving a rope can fail on OOM, leaving an exception and no contents to hash.
+        result.hash = result.impl ? result.impl->hash() : 0;
+    } else if (key.value.isSymbol()) {
+        result.impl = asSymbol(key.value)->privateName().uid();
+        result.hash = WTF::PtrHash<const StringImpl*>::hash(result.impl);
+    } else if (key.value.isCell())
+        result.hash = WTF::PtrHash<JSCell*>::hash(key.value.asCell());
+    else
+        result.hash = EncodedJSValueHash::hash(JSValue::encode(key.value));
+    return result;
 }
 
 template<typename Entry, typename JSIterator>
-inline bool MapDataImpl<Entry, JSIterator>::contains(ExecState* exec, KeyType key)
+inline bool MapDataImpl<Entry, JSIterator>::keyMatches(const LookupKey& key, JSValue entryKey) const
 {
-    return find(exec, key);
+    if (entryKey == key.value)
+        return true;
+    if (!key.impl || !entryKey.isCell())
+        return false;
+    // Strings are resolved when they are added, so an entry's string key always has its contents.
+    if (key.value.isString())
+        return entryKey.isString() && WTF::equal(asString(entryKey)->tryGetValueImpl(), key.impl);
+    return entryKey.isSymbol() && asSymbol(entryKey)->privateName().uid() == key.impl;
 }
 
 template<typename Entry, typename JSIterator>
-template <typename Map, typename Key>
-inline Entry* MapDataImpl<Entry, JSIterator>::add(ExecState* exec, JSCell* owner, Map& map, Key key, KeyType keyValue)
+inline auto MapDataImpl<Entry, JSIterator>::findSlot(const LookupKey& key) -> IndexSlot*
 {
-    typename Map::iterator location = map.find(key);
-    if (location != map.end())
-        return &m_entries.get(m_owner)[location->value];
+    if (m_index.isEmpty())
+        return nullptr;
 
-    if (!ensureSpaceForAppend(exec, owner))
+    Entry* entries = m_entries.get(m_owner);
+    unsigned mask = m_index.size() - 1;
+    for (unsigned i = key.hash & mask; ; i = (i + 1) & mask) {
+        IndexSlot& slot = m_index[i];
+        if (slot.entryIndex == emptyEntryIndex)
+            return nullptr;
+        if (slot.hash == key.hash && slot.entryIndex >= 0 && keyMatches(key, entries[slot.entryIndex].key().get()))
+            return &slot;
+    }
+}
+
+template<typename Entry, typename JSIterator>
+inline Entry* MapDataImpl<Entry, JSIterator>::find(ExecState* exec, KeyType key)
+{
+    IndexSlot* slot = findSlot(lookupKey(exec, key));
+    if (!slot)
         return 0;
+    return &m_entries.get(m_owner)[slot->entryIndex];
+}
 
-    auto result = map.add(key, m_size);
-    RELEASE_ASSERT(result.isNewEntry);
-    Entry* entry = &m_entries.get(m_owner)[m_size++];
-    new (entry) Entry();
-    entry->setKey(exec->vm(), owner, keyValue.value);
-    return entry;
+template<typename Entry, typename JSIterator>
+inline bool MapDataImpl<Entry, JSIterator>::contains(ExecState* exec, KeyType key)
+{
+    return find(exec, key);
 }
 
 template<typename Entry, typename JSIterator>
@@ -118,13 +128,30 @@ inline void MapDataImpl<Entry, JSIterator>::set(ExecState* exec, JSCell* owner,
 template<typename Entry, typename JSIterator>
 inline Entry* MapDataImpl<Entry, JSIterator>::add(ExecState* exec, JSCell* owner, KeyType key)
 {
-    if (key.value.isString())
-        return add(exec, owner, m_stringKeyedTable, asString(key.value)->value(exec).impl(), key);
-    if (key.value.isSymbol())
-        return add(exec, owner, m_symbolKeyedTable, asSymbol(key.value)->privateName().uid(), key);
-    if (key.value.isCell())
-        return add(exec, owner, m_cellKeyedTable, key.value.asCell(), key);
-    return add(exec, owner, m_valueKeyedTable, JSValue::encode(key.value), key);
+    LookupKey lookup = lookupKey(exec, key);
+    if (UNLIKELY(exec->hadException()))
+        return 0;
+    if (IndexSlot* slot = findSlot(lookup))
+        return &m_entries.get(m_owner)[slot->entryIndex];
+
+    if (!ensureSpaceForAppend(exec, owner))
+        return 0;
+    ensureIndexSpaceForAppend();
+
+    // The key is not in the table, so it can take the first free slot on its probe sequence.
+    unsigned mask = m_index.size() - 1;
+    unsigned i = lookup.hash & mask;
+    while (m_index[i].entryIndex >= 0)
+        i = (i + 1) & mask;
+    if (m_index[i].entryIndex == deletedEntryIndex)
+        m_indexDeletedCount--;
+    m_index[i].entryIndex = m_size;
+    m_index[i].hash = lookup.hash;
+
+    Entry* entry = &m_entries.get(m_owner)[m_size++];
+    new (entry) Entry();
+    entry->setKey(exec->vm(), owner, key.value);
+    return entry;
 }
 
 template<typename Entry, typename JSIterator>
@@ -138,37 +165,47 @@ inline JSValue MapDataImpl<Entry, JSIterator>::get(ExecState* exec, KeyType key)
 template<typename Entry, typename JSIterator>
 inline bool MapDataImpl<Entry, JSIterator>::remove(ExecState* exec, KeyType key)
 {
-    int32_t location;
-    if (key.value.isString()) {
-        auto iter = m_stringKeyedTable.find(asString(key.value)->value(exec).impl());
-        if (iter == m_stringKeyedTable.end())
-            return false;
-        location = iter->value;
-        m_stringKeyedTable.remove(iter);
-    }  else if (key.value.isSymbol()) {
-        auto iter = m_symbolKeyedTable.find(asSymbol(key.value)->privateName().uid());
-        if (iter == m_symbolKeyedTable.end())
-            return false;
-        location = iter->value;
-        m_symbolKeyedTable.remove(iter);
-    } else if (key.value.isCell()) {
-        auto iter = m_cellKeyedTable.find(key.value.asCell());
-        if (iter == m_cellKeyedTable.end())
-            return false;
-        location = iter->value;
-        m_cellKeyedTable.remove(iter);
-    } else {
-        auto iter = m_valueKeyedTable.find(JSValue::encode(key.value));
-        if (iter == m_valueKeyedTable.end())
-            return false;
-        location = iter->value;
-        m_valueKeyedTable.remove(iter);
-    }
-    m_entries.get(m_owner)[location].clear();
+    IndexSlot* slot = findSlot(lookupKey(exec, key));
+    if (!slot)
+        return false;
+    m_entries.get(m_owner)[slot->entryIndex].clear();
+    slot->entryIndex = deletedEntryIndex;
+    m_indexDeletedCount++;
     m_deletedCount++;
     return true;
 }
 
+template<typename Entry, typename JSIterator>
+inline void MapDataImpl<Entry, JSIterator>::ensureIndexSpaceForAppend()
+{
+    // Keep the load, counting deleted slots, at most 3/4 so that probe sequences stay short.
+    unsigned usedSlots = (m_size - m_deletedCount) + m_indexDeletedCount + 1;
+    if (usedSlots * 4 <= m_index.size() * 3)
+        return;
+
+    unsigned liveCount = m_size - m_deletedCount + 1;
+    rehashIndex(std::max<unsigned>(WTF::roundUpToPowerOfTwo(liveCount * 2), minimumIndexSize));
+}
+
+template<typename Entry, typename JSIterator>
+inline void MapDataImpl<Entry, JSIterator>::rehashIndex(unsigned newSize)
+{
+    Vector<IndexSlot> oldIndex = WTFMove(m_index);
+    IndexSlot emptySlot = { emptyEntryIndex, 0 };
+    m_index.fill(emptySlot, newSize);
+    m_indexDeletedCount = 0;
+
+    unsigned mask = newSize - 1;
+    for (const IndexSlot& slot : oldIndex) {
+        if (slot.entryIndex < 0)
+            continue;
+        unsigned i = slot.hash & mask;
+        while (m_index[i].entryIndex != emptyEntryIndex)
+            i = (i + 1) & mask;
+        m_index[i] = slot;
+    }
+}
+
 template<typename Entry, typename JSIterator>
 inline void MapDataImpl<Entry, JSIterator>::replaceAndPackBackingStore(Entry* destination, int32_t newCapacity)
 {
@@ -193,15 +230,11 @@ inline void MapDataImpl<Entry, JSIterator>::replaceAndPackBackingStore(Entry* de
         newEnd++;
     }
 
-    // Fixup for the hashmaps
-    for (auto ptr = m_valueKeyedTable.begin(); ptr != m_valueKeyedTable.end(); ++ptr)
-        ptr->value = m_entries.getWithoutBarrier()[ptr->value].key().get().asInt32();
-    for (auto ptr = m_cellKeyedTable.begin(); ptr != m_cellKeyedTable.end(); ++ptr)
-        ptr->value = m_entries.getWithoutBarrier()[ptr->value].key().get().asInt32();
-    for (auto ptr = m_stringKeyedTable.begin(); ptr != m_stringKeyedTable.end(); ++ptr)
-        ptr->value = m_entries.getWithoutBarrier()[ptr->value].key().get().asInt32();
-    for (auto ptr = m_symbolKeyedTable.begin(); ptr != m_symbolKeyedTable.end(); ++ptr)
-        ptr->value = m_entries.getWithoutBarrier()[ptr->value].key().get().asInt32();
+    // Fixup for the index. Deleted entries have no slot, so every live slot finds a forwarding index.
+    for (IndexSlot& slot : m_index) {
+        if (slot.entryIndex >= 0)
+            slot.entryIndex = m_entries.getWithoutBarrier()[slot.entryIndex].key().get().asInt32();
+    }
 
     ASSERT((m_size - newEnd) == m_deletedCount);
     m_deletedCount = 0;
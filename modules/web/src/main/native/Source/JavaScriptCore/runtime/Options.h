@@ -108,7 +108,9 @@ typedef const char* optionString;
     v(bool, useLLInt,  true, "allows the LLINT to be used if true") \
     v(bool, useJIT,    true, "allows the baseline JIT to be used if true") \
     v(bool, useDFGJIT, true, "allows the DFG JIT to be used if true") \
+    v(bool, useCLoopSuperinstructions, true, "allows the C loop interpreter to fuse frequent bytecode pairs into superinstructions if true") \
     v(bool, useRegExpJIT, true, "allows the RegExp JIT to be used if true") \
+    v(bool, useRegExpPikeVM, true, "allows RegExps the JIT does not handle to run on the linear time Pike VM instead of the backtracking interpreter if true") \
     \
     v(bool, reportMustSucceedExecutableAllocations, false, nullptr) \
     \
@@ -116,6 +118,8 @@ typedef const char* optionString;
     v(unsigned, reservedZoneSize, 128 * KB, nullptr) \
     v(unsigned, errorModeReservedZoneSize, 64 * KB, nullptr) \
     \
+    v(unsigned, sourceProviderCacheStoreSize, 8 * MB, "bytes of parsed function records kept so reloaded scripts can skip functions they have already checked (0 disables)") \
+    \
     v(bool, crashIfCantAllocateJITMemory, false, nullptr) \
     v(unsigned, jitMemoryReservationSize, 0, "Set this number to change the executable allocation size in ExecutableAllocatorFixedVMPool. (In bytes.)") \
     \
@@ -125,6 +129,7 @@ typedef const char* optionString;
     v(unsigned, repatchCountForCoolDown, 10, nullptr) \
     v(unsigned, initialCoolDownCount, 20, nullptr) \
     \
+    v(bool, logParserArenaStatistics, false, "logs how many bytes parses took from parser arenas and how many arena pools were reused when a VM is destroyed") \
     v(bool, dumpGeneratedBytecodes, false, nullptr) \
     v(bool, dumpBytecodeLivenessResults, false, nullptr) \
     v(bool, validateBytecode, false, nullptr) \
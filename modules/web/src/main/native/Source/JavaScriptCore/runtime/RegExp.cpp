@@ -268,6 +268,8 @@ size_t RegExp::estimatedSize(JSCell* cell)
 {
     RegExp* thisObject = static_cast<RegExp*>(cell);
     size_t regexDataSize = thisObject->m_regExpBytecode ? thisObject->m_regExpBytecode->estimatedSizeInBytes() : 0;
+    if (thisObject->m_regExpPikeVM)
+        regexDataSize += thisObject->m_regExpPikeVM->estimatedSizeInBytes();
 #if ENABLE(YARR_JIT)
     regexDataSize += thisObject->m_regExpJITCode.size();
 #endif
@@ -316,6 +318,14 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
     UNUSED_PARAM(charSize);
 #endif
 
+    if (Options::useRegExpPikeVM()) {
+        m_regExpPikeVM = Yarr::pikeVMCompile(pattern);
+        if (m_regExpPikeVM) {
+            m_state = PikeVMCode;
+            return;
+        }
+    }
+
     m_state = ByteCode;
     m_regExpBytecode = Yarr::byteCompile(pattern, &vm->m_regExpAllocator);
 }
@@ -364,6 +374,9 @@ int RegExp::match(VM& vm, const String& s, unsigned startOffset, Vector<int, 32>
 #endif
     } else
 #endif
+    if (m_state == PikeVMCode)
+        result = Yarr::pikeVMInterpret(m_regExpPikeVM.get(), s, startOffset, reinterpret_cast<unsigned*>(offsetVector));
+    else
         result = Yarr::interpret(m_regExpBytecode.get(), s, startOffset, reinterpret_cast<unsigned*>(offsetVector));
 
     // FIXME: The YARR engine should handle unsigned or size_t length matches.
@@ -435,6 +448,14 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
     UNUSED_PARAM(charSize);
 #endif
 
+    if (Options::useRegExpPikeVM()) {
+        m_regExpPikeVM = Yarr::pikeVMCompile(pattern);
+        if (m_regExpPikeVM) {
+            m_state = PikeVMCode;
+            return;
+        }
+    }
+
     m_state = ByteCode;
     m_regExpBytecode = Yarr::byteCompile(pattern, &vm->m_regExpAllocator);
 }
@@ -485,7 +506,11 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
     Vector<int, 32> nonReturnedOvector;
     nonReturnedOvector.resize(offsetVectorSize);
     offsetVector = nonReturnedOvector.data();
-    int r = Yarr::interpret(m_regExpBytecode.get(), s, startOffset, reinterpret_cast<unsigned*>(offsetVector));
+    int r;
+    if (m_state == PikeVMCode)
+        r = Yarr::pikeVMInterpret(m_regExpPikeVM.get(), s, startOffset, reinterpret_cast<unsigned*>(offsetVector));
+    else
+        r = Yarr::interpret(m_regExpBytecode.get(), s, startOffset, reinterpret_cast<unsigned*>(offsetVector));
 #if REGEXP_FUNC_TEST_DATA_GEN
     RegExpFunctionalTestCollector::get()->outputOneTest(this, s, startOffset, offsetVector, result);
 #endif
@@ -509,6 +534,7 @@ void RegExp::deleteCode()
     m_regExpJITCode.clear();
 #endif
     m_regExpBytecode = nullptr;
+    m_regExpPikeVM = nullptr;
 }
 
 #if ENABLE(YARR_JIT_DEBUG)
@@ -583,7 +609,7 @@ void RegExp::matchCompareWithInterpreter(const String& s, int startOffset, int*
         char jit16BitMatchOnlyAddr[jitAddrSize];
         char jit8BitMatchAddr[jitAddrSize];
         char jit16BitMatchAddr[jitAddrSize];
-        if (m_state == ByteCode) {
+        if (m_state == ByteCode || m_state == PikeVMCode) {
             snprintf(jit8BitMatchOnlyAddr, jitAddrSize, "fallback    ");
             snprintf(jit16BitMatchOnlyAddr, jitAddrSize, "----      ");
             snprintf(jit8BitMatchAddr, jitAddrSize, "fallback    ");
@@ -27,6 +27,7 @@
 #include "RegExpKey.h"
 #include "Structure.h"
 #include "yarr/Yarr.h"
+#include "yarr/YarrPikeVM.h"
 #include <wtf/Forward.h>
 #include <wtf/RefCounted.h>
 #include <wtf/text/WTFString.h>
@@ -99,6 +100,7 @@ private:
         ParseError,
         JITCode,
         ByteCode,
+        PikeVMCode,
         NotCompiled
     };
 
@@ -131,6 +133,7 @@ private:
     Yarr::YarrCodeBlock m_regExpJITCode;
 #endif
     std::unique_ptr<Yarr::BytecodePattern> m_regExpBytecode;
+    std::unique_ptr<Yarr::PikeVMPattern> m_regExpPikeVM;
 };
 
 } // namespace JSC
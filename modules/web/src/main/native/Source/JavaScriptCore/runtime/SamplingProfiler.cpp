@@ -162,6 +162,11 @@ private:
             if (fpCast <= stackBase && fpCast >= stackLimit)
                 return true;
         }
+#if !ENABLE(JIT)
+        // C loop frames live on the JSStack rather than on a machine stack.
+        if (m_vm.interpreter->stack().containsAddress(bitwise_cast<Register*>(exec)))
+            return true;
+#endif
         return false;
     }
 
@@ -213,7 +218,9 @@ SamplingProfiler::SamplingProfiler(VM& vm, RefPtr<Stopwatch>&& stopwatch)
 
             LockHolder machineThreadsLocker(m_vm.heap.machineThreads().getLock());
             LockHolder codeBlockSetLocker(m_vm.heap.codeBlockSet().getLock());
+#if ENABLE(JIT)
             LockHolder executableAllocatorLocker(m_vm.executableAllocator.getLock());
+#endif
 
             bool didSuspend = m_jscExecutionThread->suspend();
             if (didSuspend) {
@@ -223,6 +230,7 @@ SamplingProfiler::SamplingProfiler(VM& vm, RefPtr<Stopwatch>&& stopwatch)
                 void* machinePC;
                 bool topFrameIsLLInt = false;
                 void* llintPC;
+#if ENABLE(JIT)
                 {
                     MachineThreads::Thread::Registers registers;
                     m_jscExecutionThread->getRegisters(registers);
@@ -248,6 +256,20 @@ SamplingProfiler::SamplingProfiler(VM& vm, RefPtr<Stopwatch>&& stopwatch)
                     // useful. We usually get here when we're executing C code.
                     callFrame = m_vm.topCallFrame;
                 }
+#else
+                // The C loop's frame and PC live in CLoop::execute() locals, not in
+                // machine registers, so we read them from the state it publishes.
+                machinePC = nullptr;
+                llintPC = nullptr;
+                callFrame = nullptr;
+                if (VM::CLoopExecutionState* executionState = m_vm.cloopExecutionState) {
+                    callFrame = executionState->callFrame.load(std::memory_order_relaxed);
+                    llintPC = executionState->pc.load(std::memory_order_relaxed);
+                    topFrameIsLLInt = !!callFrame;
+                }
+                if (!callFrame)
+                    callFrame = m_vm.topCallFrame;
+#endif
 
                 size_t walkSize;
                 bool wasValidWalk;
@@ -338,6 +360,7 @@ void SamplingProfiler::processUnverifiedStackTraces()
             m_liveCellPointers.add(codeBlock->ownerExecutable());
 
             if (bytecodeIndex < codeBlock->instructionCount()) {
+                stackTrace.frames.last().bytecodeIndex = bytecodeIndex;
                 int divot;
                 int startOffset;
                 int endOffset;
@@ -436,13 +459,16 @@ void SamplingProfiler::processUnverifiedStackTraces()
                     storeCalleeIntoTopFrame(unprocessedStackTrace.frames[0].unverifiedCallee);
                     startIndex = 1;
                 }
-            } else if (Optional<CodeOrigin> codeOrigin = topCodeBlock->findPC(unprocessedStackTrace.topPC)) {
+            }
+#if ENABLE(JIT)
+            else if (Optional<CodeOrigin> codeOrigin = topCodeBlock->findPC(unprocessedStackTrace.topPC)) {
                 codeOrigin->walkUpInlineStack([&] (const CodeOrigin& codeOrigin) {
                     appendCodeBlock(codeOrigin.inlineCallFrame ? codeOrigin.inlineCallFrame->baselineCodeBlock.get() : topCodeBlock, codeOrigin.bytecodeIndex);
                 });
                 storeCalleeIntoTopFrame(unprocessedStackTrace.frames[0].unverifiedCallee);
                 startIndex = 1;
             }
+#endif
         }
 
         for (size_t i = startIndex; i < unprocessedStackTrace.frames.size(); i++) {
@@ -760,6 +786,91 @@ String SamplingProfiler::stackTracesAsJSON()
     return json.toString();
 }
 
+String SamplingProfiler::stackTracesAsFoldedStacks(bool includeBytecodeIndex)
+{
+    LockHolder locker(m_lock);
+
+    {
+        HeapIterationScope heapIterationScope(m_vm.heap);
+        processUnverifiedStackTraces();
+    }
+
+    // Closures created from the same source function share an UnlinkedFunctionExecutable,
+    // so keying on it folds all of their samples into a single frame.
+    typedef std::pair<void*, unsigned> FrameKey;
+    HashMap<FrameKey, String> frameLabels;
+    auto frameLabel = [&] (StackFrame& stackFrame) -> String {
+        void* executableKey = stackFrame.executable;
+        if (stackFrame.frameType == FrameType::Executable && stackFrame.executable->isFunctionExecutable())
+            executableKey = static_cast<FunctionExecutable*>(stackFrame.executable)->unlinkedExecutable();
+        if (!executableKey)
+            executableKey = stackFrame.callee;
+        unsigned bytecodeIndex = includeBytecodeIndex ? stackFrame.bytecodeIndex : std::numeric_limits<unsigned>::max();
+
+        auto addResult = frameLabels.add(FrameKey(executableKey, bytecodeIndex), String());
+        if (!addResult.isNewEntry)
+            return addResult.iterator->value;
+
+        StringBuilder label;
+        label.append(stackFrame.displayNameForJSONTests(m_vm));
+        int startLine = stackFrame.functionStartLine();
+        if (startLine >= 0) {
+            label.appendLiteral(" (");
+            String url = stackFrame.url();
+            if (!url.isEmpty()) {
+                label.append(url);
+                label.append(':');
+            }
+            label.appendNumber(startLine);
+            label.append(')');
+        }
+        if (includeBytecodeIndex && stackFrame.hasBytecodeIndex()) {
+            label.appendLiteral(" bc#");
+            label.appendNumber(stackFrame.bytecodeIndex);
+        }
+
+        // ';' separates frames and a line break separates stacks in the folded format.
+        String result = label.toString();
+        result.replace(';', ':');
+        result.replace('\n', ' ');
+        addResult.iterator->value = result;
+        return result;
+    };
+
+    HashMap<String, unsigned> stackCounts;
+    for (StackTrace& stackTrace : m_stackTraces) {
+        if (stackTrace.frames.isEmpty())
+            continue;
+
+        StringBuilder stack;
+        for (size_t i = stackTrace.frames.size(); i--;) {
+            stack.append(frameLabel(stackTrace.frames[i]));
+            if (i)
+                stack.append(';');
+        }
+        auto addResult = stackCounts.add(stack.toString(), 0);
+        addResult.iterator->value++;
+    }
+
+    Vector<String> stacks;
+    stacks.reserveInitialCapacity(stackCounts.size());
+    for (auto& stack : stackCounts.keys())
+        stacks.uncheckedAppend(stack);
+    std::sort(stacks.begin(), stacks.end(), codePointCompareLessThan);
+
+    StringBuilder result;
+    for (String& stack : stacks) {
+        result.append(stack);
+        result.append(' ');
+        result.appendNumber(stackCounts.get(stack));
+        result.append('\n');
+    }
+
+    clearData(locker);
+
+    return result.toString();
+}
+
 } // namespace JSC
 
 namespace WTF {
@@ -83,6 +83,7 @@ public:
         // These attempt to be expression-level line and column number.
         unsigned lineNumber { std::numeric_limits<unsigned>::max() };
         unsigned columnNumber { std::numeric_limits<unsigned>::max() };
+        unsigned bytecodeIndex { std::numeric_limits<unsigned>::max() };
 
         bool hasExpressionInfo() const
         {
@@ -90,6 +91,8 @@ public:
                 && columnNumber != std::numeric_limits<unsigned>::max();
         }
 
+        bool hasBytecodeIndex() const { return bytecodeIndex != std::numeric_limits<unsigned>::max(); }
+
         // These are function-level data.
         String nameFromCallee(VM&);
         String displayName(VM&);
@@ -133,6 +136,9 @@ public:
     void stop(const LockHolder&);
     Vector<StackTrace> releaseStackTraces(const LockHolder&);
     JS_EXPORT_PRIVATE String stackTracesAsJSON();
+    // One "outermost;...;innermost count" line per distinct stack, as consumed by flame graph tools.
+    // Frames are keyed by their UnlinkedFunctionExecutable and, optionally, their bytecode offset.
+    JS_EXPORT_PRIVATE String stackTracesAsFoldedStacks(bool includeBytecodeIndex);
     JS_EXPORT_PRIVATE void noticeCurrentThreadAsJSCExecutionThread();
     void noticeCurrentThreadAsJSCExecutionThread(const LockHolder&);
     void processUnverifiedStackTraces(); // You should call this only after acquiring the lock.
@@ -56,6 +56,7 @@
 #include "IncrementalSweeper.h"
 #include "InferredTypeTable.h"
 #include "Interpreter.h"
+#include "IntlCache.h"
 #include "JITCode.h"
 #include "JSAPIValueWrapper.h"
 #include "JSArray.h"
@@ -194,6 +195,7 @@ VM::VM(VMType vmType, HeapType heapType)
 #endif
     , m_inDefineOwnProperty(false)
     , m_codeCache(std::make_unique<CodeCache>())
+    , m_parserArenaPoolCache(std::make_unique<ParserArenaPoolCache>())
     , m_enabledProfiler(nullptr)
     , m_builtinExecutables(std::make_unique<BuiltinExecutables>(*this))
     , m_typeProfilerEnabledCount(0)
@@ -530,6 +532,23 @@ void VM::resetDateCache()
     dateInstanceCache.reset();
 }
 
+void VM::resetDateCacheIfTimeZoneChangedSlow()
+{
+    dateCacheNeedsTimeZoneCheck = false;
+
+    // Asking for a local time input's offset first makes the C library reread the time zone.
+    double january = dateToDaysFrom1970(msToYear(WTF::jsCurrentTime()), 0, 1) * msPerDay;
+    double july = january + 181 * msPerDay;
+    LocalTimeOffset januaryOffset = calculateLocalTimeOffset(january, WTF::LocalTime);
+    LocalTimeOffset julyOffset = calculateLocalTimeOffset(july, WTF::LocalTime);
+    if (januaryOffset == localTimeOffsetCache.januaryOffset && julyOffset == localTimeOffsetCache.julyOffset)
+        return;
+
+    resetDateCache();
+    localTimeOffsetCache.januaryOffset = januaryOffset;
+    localTimeOffsetCache.julyOffset = julyOffset;
+}
+
 void VM::startSampling()
 {
     interpreter->startSampling();
@@ -563,6 +582,7 @@ void VM::deleteAllCode()
     whenIdle([this]() {
         m_codeCache->clear();
         m_regExpCache->deleteAllCode();
+        releaseRopeResolveBuffer();
         heap.deleteAllCodeBlocks();
         heap.deleteAllUnlinkedCodeBlocks();
         heap.reportAbandonedObjectGraph();
@@ -577,11 +597,20 @@ void VM::dumpSampleData(ExecState* exec)
 #endif
 }
 
+#if ENABLE(INTL)
+IntlCache& VM::intlCache()
+{
+    if (!m_intlCache)
+        m_intlCache = std::make_unique<IntlCache>();
+    return *m_intlCache;
+}
+#endif
+
 SourceProviderCache* VM::addSourceProviderCache(SourceProvider* sourceProvider)
 {
     auto addResult = sourceProviderCacheMap.add(sourceProvider, nullptr);
     if (addResult.isNewEntry)
-        addResult.iterator->value = adoptRef(new SourceProviderCache);
+        addResult.iterator->value = SourceProviderCache::create(*this, *sourceProvider);
     return addResult.iterator->value.get();
 }
 
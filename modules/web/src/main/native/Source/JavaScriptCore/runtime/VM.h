@@ -54,6 +54,7 @@
 #include "TypedArrayController.h"
 #include "VMEntryRecord.h"
 #include "Watchpoint.h"
+#include <wtf/Atomics.h>
 #include <wtf/Bag.h>
 #include <wtf/BumpPointerAllocator.h>
 #include <wtf/DateMath.h>
@@ -89,6 +90,9 @@ class TypeProfiler;
 class TypeProfilerLog;
 class HeapProfiler;
 class Identifier;
+#if ENABLE(INTL)
+class IntlCache;
+#endif
 class Interpreter;
 class JSBoundSlotBaseFunction;
 class JSGlobalObject;
@@ -103,6 +107,7 @@ class SamplingProfiler;
 #endif
 class ScriptExecutable;
 class SourceProvider;
+class ParserArenaPoolCache;
 class SourceProviderCache;
 struct StackFrame;
 class Structure;
@@ -141,28 +146,28 @@ struct HashTable;
 struct Instruction;
 
 struct LocalTimeOffsetCache {
-    LocalTimeOffsetCache()
-        : start(0.0)
-        , end(-1.0)
-        , increment(0.0)
-        , timeType(WTF::UTCTime)
-    {
-    }
+    // A span of time, such as one daylight saving time period, over which the offset does not change.
+    struct Period {
+        double start;
+        double end;
+        LocalTimeOffset offset;
+    };
+
+    static const size_t maxPeriods = 256;
 
     void reset()
     {
-        offset = LocalTimeOffset();
-        start = 0.0;
-        end = -1.0;
-        increment = 0.0;
-        timeType = WTF::UTCTime;
+        for (auto& table : periods)
+            table.clear();
     }
 
-    LocalTimeOffset offset;
-    double start;
-    double end;
-    double increment;
-    WTF::TimeType timeType;
+    // One table per WTF::TimeType, sorted by start. Periods do not overlap.
+    Vector<Period> periods[2];
+
+    // Offsets at the start of January and July of the year the periods were computed in, which
+    // tell apart time zones with different standard offsets or daylight saving rules.
+    LocalTimeOffset januaryOffset;
+    LocalTimeOffset julyOffset;
 };
 
 class QueuedTask {
@@ -345,6 +350,20 @@ public:
     WeakGCMap<StringImpl*, JSString, PtrHash<StringImpl*>> stringCache;
     Strong<JSString> lastCachedString;
 
+    // Buffer with spare capacity that the last appended-to rope was resolved into. Only its
+    // first ropeResolveBufferLength characters are in use; see JSRopeString::resolveRope().
+    RefPtr<StringImpl> ropeResolveBuffer;
+    unsigned ropeResolveBufferLength { 0 };
+    // Last long rope that was resolved. Only compared against, never dereferenced.
+    const JSString* lastResolvedRope { nullptr };
+
+    void releaseRopeResolveBuffer()
+    {
+        ropeResolveBuffer = nullptr;
+        ropeResolveBufferLength = 0;
+        lastResolvedRope = nullptr;
+    }
+
     AtomicStringTable* atomicStringTable() const { return m_atomicStringTable; }
     WTF::SymbolRegistry& symbolRegistry() { return m_symbolRegistry; }
 
@@ -496,6 +515,20 @@ public:
 
     bool isExecutingInRegExpJIT { false };
 
+#if ENABLE(SAMPLING_PROFILER) && !ENABLE(JIT)
+    // The C loop keeps its frame and bytecode PC in locals of CLoop::execute(),
+    // where the SamplingProfiler cannot find them through the machine registers.
+    // Each active CLoop::execute() copies them here on function entry, after
+    // returns, before slow path and native calls, and at loop hints. Taking
+    // the locals' addresses instead would keep them out of machine registers.
+    struct CLoopExecutionState {
+        Atomic<ExecState*> callFrame;
+        Atomic<void*> pc;
+        CLoopExecutionState* previous;
+    };
+    CLoopExecutionState* cloopExecutionState { nullptr };
+#endif
+
     ScratchBuffer* scratchBufferForSize(size_t size)
     {
         if (!size)
@@ -554,6 +587,15 @@ public:
 
     JS_EXPORT_PRIVATE void resetDateCache();
 
+    // The date caches outlive VM entries. Entering the VM only marks them for a check that the
+    // time zone is unchanged, which is done before they are next used.
+    void resetDateCacheIfTimeZoneChanged()
+    {
+        if (UNLIKELY(dateCacheNeedsTimeZoneCheck))
+            resetDateCacheIfTimeZoneChangedSlow();
+    }
+    bool dateCacheNeedsTimeZoneCheck { true };
+
     JS_EXPORT_PRIVATE void startSampling();
     JS_EXPORT_PRIVATE void stopSampling();
     JS_EXPORT_PRIVATE void dumpSampleData(ExecState*);
@@ -574,6 +616,10 @@ public:
 
     JSLock& apiLock() { return *m_apiLock; }
     CodeCache* codeCache() { return m_codeCache.get(); }
+    ParserArenaPoolCache& parserArenaPoolCache() { return *m_parserArenaPoolCache; }
+#if ENABLE(INTL)
+    IntlCache& intlCache();
+#endif
 
     JS_EXPORT_PRIVATE void whenIdle(std::function<void()>);
 
@@ -621,6 +667,8 @@ private:
 
     void updateStackLimit();
 
+    void resetDateCacheIfTimeZoneChangedSlow();
+
     void setException(Exception* exception)
     {
         m_exception = exception;
@@ -664,6 +712,10 @@ private:
     bool m_shouldRewriteConstAsVar { false };
     bool m_shouldBuildPCToCodeOriginMapping { false };
     std::unique_ptr<CodeCache> m_codeCache;
+    std::unique_ptr<ParserArenaPoolCache> m_parserArenaPoolCache;
+#if ENABLE(INTL)
+    std::unique_ptr<IntlCache> m_intlCache;
+#endif
     LegacyProfiler* m_enabledProfiler;
     std::unique_ptr<BuiltinExecutables> m_builtinExecutables;
     HashMap<String, RefPtr<WatchpointSet>> m_impurePropertyWatchpointSets;
@@ -43,9 +43,9 @@ VMEntryScope::VMEntryScope(VM& vm, JSGlobalObject* globalObject)
     if (!vm.entryScope) {
         vm.entryScope = this;
 
-        // Reset the date cache between JS invocations to force the VM to
-        // observe time zone changes.
-        vm.resetDateCache();
+        // Recheck the time zone before the date caches are next used, so the
+        // VM observes time zone changes between JS invocations.
+        vm.dateCacheNeedsTimeZoneCheck = true;
 
         if (vm.watchdog())
             vm.watchdog()->enteredVM();
@@ -72,6 +72,10 @@ VMEntryScope::~VMEntryScope()
     if (m_vm.watchdog())
         m_vm.watchdog()->exitedVM();
 
+    // An out of memory error the script did not get to see must not be thrown
+    // at the next, unrelated one.
+    m_vm.heap.clearPendingOutOfMemoryError();
+
     m_vm.entryScope = nullptr;
 
     for (auto& listener : m_didPopListeners)
@@ -83,6 +83,12 @@ JS_EXPORT_PRIVATE void Watchdog::terminateSoon()
     m_timerDidFire = true;
 }
 
+void Watchdog::interrupt()
+{
+    LockHolder locker(m_lock);
+    m_timerDidFire = true;
+}
+
 bool Watchdog::shouldTerminateSlow(ExecState* exec)
 {
     {
@@ -50,6 +50,9 @@ public:
     typedef bool (*ShouldTerminateCallback)(ExecState*, void* data1, void* data2);
     void setTimeLimit(std::chrono::microseconds limit, ShouldTerminateCallback = 0, void* data1 = 0, void* data2 = 0);
     JS_EXPORT_PRIVATE void terminateSoon();
+    // Makes the next polling check take the slow path without terminating, for
+    // clients that have something to tell the running script (see Heap::setPolicy).
+    void interrupt();
 
     bool shouldTerminate(ExecState* exec)
     {
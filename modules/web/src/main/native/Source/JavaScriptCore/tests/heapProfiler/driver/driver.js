@@ -151,6 +151,46 @@ function createCheapHeapSnapshot() {
     return new CheapHeapSnapshot(json);
 }
 
+// Converts the JSON lines of generateStreamedHeapSnapshot() to the payload of
+// generateHeapSnapshot(), like Scripts/convert-heap-snapshot-stream.py does.
+function convertStreamedHeapSnapshot(text) {
+    let lines = text.split("\n").filter((line) => line.length);
+    let header = JSON.parse(lines[0]);
+    let footer = JSON.parse(lines[lines.length - 1]);
+    assert(header.version === 1, "Streamed Heap Snapshot should be version 1");
+
+    let nodes = [[0, 0, "<root>"]];
+    let nodeClassNames = [];
+    let streamedEdges = [];
+    let cellToIdentifier = new Map;
+    for (let i = 1; i < lines.length - 1; ++i) {
+        let record = JSON.parse(lines[i]);
+        if (record[0] === "c")
+            nodeClassNames[record[1]] = record[2];
+        else if (record.length === 4) {
+            let [cell, size, classNameIndex, internal] = record;
+            cellToIdentifier.set(cell, nodes.length);
+            nodes.push(internal ? [nodes.length, size, classNameIndex, 1] : [nodes.length, size, classNameIndex]);
+        } else
+            streamedEdges.push(record);
+    }
+    assert(nodes.length - 1 === footer.nodes, "Streamed Heap Snapshot should have " + footer.nodes + " nodes");
+    assert(streamedEdges.length === footer.edges, "Streamed Heap Snapshot should have " + footer.edges + " edges");
+
+    let edges = [];
+    for (let [from, to, type] of streamedEdges) {
+        let fromIdentifier = from ? cellToIdentifier.get(from) : 0;
+        let toIdentifier = cellToIdentifier.get(to);
+        if (fromIdentifier !== undefined && toIdentifier !== undefined)
+            edges.push([fromIdentifier, toIdentifier, type]);
+    }
+
+    return {version: header.version, nodes, nodeClassNames, edges, edgeTypes: header.edgeTypes};
+}
+
+function createCheapStreamedHeapSnapshot() {
+    return new CheapHeapSnapshot(convertStreamedHeapSnapshot(generateStreamedHeapSnapshot()));
+}
 
 // ------------
 // HeapSnapshot
@@ -0,0 +1,34 @@
+load("./driver/driver.js");
+
+let simpleObject1 = new SimpleObject;
+let simpleObject2 = new SimpleObject;
+setHiddenValue(simpleObject1, simpleObject2);
+
+(function() {
+    let snapshot = createCheapStreamedHeapSnapshot();
+    assert(snapshot.nodesWithClassName("global").length === 1, "Snapshot should contain a single 'global' node");
+    assert(snapshot.nodesWithClassName("Structure").length > 0, "Snapshot should contain 'Structure' nodes");
+    assert(snapshot.nodesWithClassName("string").length > 0, "Snapshot should contain 'string' nodes");
+
+    let nodes = snapshot.nodesWithClassName("SimpleObject");
+    assert(nodes.length === 2, "Snapshot should contain 2 'SimpleObject' instances");
+    let simpleObject1Node = nodes[0].outgoingEdges.length === 2 ? nodes[0] : nodes[1];
+    let simpleObject2Node = nodes[0].outgoingEdges.length === 1 ? nodes[0] : nodes[1];
+    assert(simpleObject1Node.outgoingEdges.length === 2, "'simpleObject1' should reference its structure and hidden value");
+    assert(simpleObject2Node.outgoingEdges.length === 1, "'simpleObject2' should reference only its structure");
+    assert(simpleObject1Node.outgoingEdges.some((edge) => edge.toId === simpleObject2Node.id), "'simpleObject1' should reference 'simpleObject2'");
+})();
+
+// Streaming does not disturb the incremental snapshots.
+(function() {
+    let snapshot = createCheapHeapSnapshot();
+    assert(snapshot.nodesWithClassName("SimpleObject").length === 2, "Snapshot should contain 2 'SimpleObject' instances");
+})();
+
+simpleObject1 = null;
+simpleObject2 = null;
+
+(function() {
+    let snapshot = createCheapStreamedHeapSnapshot();
+    assert(snapshot.nodesWithClassName("SimpleObject").length === 0, "Snapshot should not contain a 'SimpleObject' instance");
+})();
@@ -0,0 +1,17 @@
+(function () {
+    var day = 24 * 60 * 60 * 1000;
+    var start = Date.UTC(2010, 0, 1);
+    var dates = [];
+    for (var i = 0; i < 3000; ++i)
+        dates.push(start + ((i * 7919) % 3000) * day + (i % 24) * 3600000);
+
+    var total = 0;
+    for (var iteration = 0; iteration < 20; ++iteration) {
+        for (var i = 0; i < dates.length; ++i) {
+            var date = new Date(dates[i]);
+            total += date.getHours() + date.getDate() + date.getTimezoneOffset();
+        }
+        for (var i = 0; i < dates.length; i += 10)
+            total += new Date(dates[i]).toLocaleDateString().length + new Date(dates[i]).toString().length;
+    }
+})();
@@ -0,0 +1,13 @@
+(function () {
+    var words = [];
+    for (var i = 0; i < 2000; ++i)
+        words.push("word" + ((i * 7919) % 2000));
+
+    var total = 0;
+    for (var iteration = 0; iteration < 10; ++iteration) {
+        var sorted = words.slice().sort(function (a, b) { return a.localeCompare(b); });
+        total += sorted.length;
+        for (var i = 0; i < 2000; ++i)
+            total += (i * 1.5).toLocaleString().length + new Date(i * 86400000).toLocaleDateString().length;
+    }
+})();
@@ -0,0 +1,21 @@
+(function () {
+    var records = [];
+    for (var i = 0; i < 20000; ++i) {
+        records.push({
+            id: i,
+            guid: "4f1c2a7e-" + i + "-4b8e-9c3d-2a6f0e1b7d5c",
+            isActive: i % 3 == 0,
+            balance: i * 17.25,
+            latitude: -33.8688 + i / 1000,
+            longitude: 151.2093 - i / 1000,
+            name: "Customer number " + i,
+            about: "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.\n",
+            tags: ["alpha", "beta", "gamma"],
+            registered: "2016-04-12T08:15:00 -02:00"
+        });
+    }
+    var text = JSON.stringify(records);
+
+    for (var i = 0; i < 20; ++i)
+        var result = JSON.parse(text);
+})();
@@ -0,0 +1,20 @@
+(function () {
+    var records = [];
+    for (var i = 0; i < 20000; ++i) {
+        records.push({
+            id: i,
+            guid: "4f1c2a7e-" + i + "-4b8e-9c3d-2a6f0e1b7d5c",
+            isActive: i % 3 == 0,
+            balance: i * 17.25,
+            name: "Customer number " + i,
+            about: "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.\n",
+            tags: ["alpha", "beta", "gamma"],
+            address: { street: i + " Main Street", city: "Springfield", zip: "12345" }
+        });
+    }
+
+    for (var i = 0; i < 20; ++i)
+        var text = JSON.stringify(records);
+    for (var i = 0; i < 5; ++i)
+        var indented = JSON.stringify(records, null, 2);
+})();
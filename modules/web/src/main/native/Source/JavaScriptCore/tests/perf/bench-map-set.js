@@ -0,0 +1,33 @@
+(function () {
+    var strings = [];
+    var objects = [];
+    for (var i = 0; i < 10000; ++i) {
+        strings.push("key" + i);
+        objects.push({ id: i });
+    }
+
+    for (var iteration = 0; iteration < 50; ++iteration) {
+        var map = new Map;
+        var set = new Set;
+        for (var i = 0; i < 10000; ++i) {
+            map.set(strings[i], i);
+            map.set(i, strings[i]);
+            set.add(objects[i]);
+        }
+        var sum = 0;
+        for (var i = 0; i < 10000; ++i) {
+            sum += map.get(strings[i]);
+            if (set.has(objects[i]))
+                sum++;
+            if (map.has(i + 0.5))
+                sum++;
+        }
+        for (var i = 0; i < 10000; i += 2) {
+            map.delete(strings[i]);
+            set.delete(objects[i]);
+        }
+        map.forEach(function (value) { sum++; });
+        for (var object of set)
+            sum += object.id;
+    }
+})();
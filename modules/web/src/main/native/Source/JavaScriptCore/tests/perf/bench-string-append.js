@@ -0,0 +1,12 @@
+(function () {
+    var total = 0;
+    for (var iteration = 0; iteration < 20; ++iteration) {
+        var s = "";
+        for (var i = 0; i < 5000; ++i) {
+            s += "<li>" + i + "</li>";
+            if (!(i % 16))
+                total += s.indexOf("</li>", s.length - 16);
+        }
+        total += s.length;
+    }
+})();
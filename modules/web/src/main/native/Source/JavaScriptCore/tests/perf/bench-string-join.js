@@ -0,0 +1,14 @@
+(function () {
+    var words = [];
+    for (var i = 0; i < 2000; ++i)
+        words.push("word" + i);
+
+    var total = 0;
+    for (var iteration = 0; iteration < 50; ++iteration) {
+        var joined = words.join(", ");
+        var concatenated = "";
+        for (var i = 0; i < words.length; ++i)
+            concatenated += words[i] + ", ";
+        total += joined.split(", ").length + concatenated.replace(/word/g, "w").length;
+    }
+})();
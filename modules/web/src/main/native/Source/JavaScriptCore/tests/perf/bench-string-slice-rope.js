@@ -0,0 +1,13 @@
+(function () {
+    var head = "";
+    for (var i = 0; i < 1000; ++i)
+        head += "header" + i + "\n";
+
+    var total = 0;
+    for (var iteration = 0; iteration < 2000; ++iteration) {
+        var document = head + "body" + iteration;
+        total += document.slice(0, 64).length;
+        total += document.substr(7, 16).charCodeAt(3);
+        total += document.substring(head.length).length;
+    }
+})();
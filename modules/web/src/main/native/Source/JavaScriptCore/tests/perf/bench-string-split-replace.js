@@ -0,0 +1,19 @@
+(function () {
+    var lines = [];
+    for (var i = 0; i < 2000; ++i)
+        lines.push("2016-10-18 12:" + (i % 60) + ":00,INFO,worker-" + (i % 8) + ",GET /index.html?id=" + i + ",status=" + (i % 7 ? 200 : 404));
+    var log = lines.join("\n");
+
+    var total = 0;
+    for (var iteration = 0; iteration < 20; ++iteration) {
+        var records = log.split("\n");
+        for (var i = 0; i < records.length; ++i) {
+            var fields = records[i].split(",");
+            if (fields[4].indexOf("404") != -1)
+                total++;
+            if (records[i].includes("worker-3"))
+                total += fields[3].replace("GET ", "").length;
+            total += records[i].lastIndexOf(":");
+        }
+    }
+})();
@@ -0,0 +1,27 @@
+(function () {
+    var length = 200000;
+    var floats = new Float32Array(length);
+    var doubles = new Float64Array(length);
+    var ints = new Int32Array(length);
+    var bytes = new Uint8Array(length);
+
+    var seed = 1;
+    var total = 0;
+    for (var iteration = 0; iteration < 10; ++iteration) {
+        for (var i = 0; i < length; ++i) {
+            seed = (seed * 1103515245 + 12345) % 2147483648;
+            doubles[i] = seed / 1000 - 1000000;
+            ints[i] = seed;
+        }
+        floats.set(doubles);
+        bytes.set(ints);
+        floats.sort();
+        doubles.sort();
+        ints.sort();
+        bytes.sort();
+        total += floats.indexOf(floats[length >> 1]) + bytes.indexOf(255) + ints.lastIndexOf(ints[10]);
+        doubles.fill(0);
+        floats.reverse();
+        ints.copyWithin(0, length >> 1);
+    }
+})();
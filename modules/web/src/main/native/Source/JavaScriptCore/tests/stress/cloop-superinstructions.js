@@ -0,0 +1,106 @@
+function shouldBe(actual, expected) {
+    if (actual !== expected)
+        throw new Error("bad value: " + actual + ", expected: " + expected);
+}
+
+function countUp(start, end) {
+    var count = 0;
+    for (var i = start; i < end; i++)
+        count++;
+    return count;
+}
+noInline(countUp);
+
+function countUpInclusive(start, end) {
+    var count = 0;
+    for (var i = start; i <= end; i++)
+        count++;
+    return count;
+}
+noInline(countUpInclusive);
+
+function countDown(start, end) {
+    var count = 0;
+    for (var i = start; i > end; i--)
+        count++;
+    return count;
+}
+noInline(countDown);
+
+function countDownInclusive(start, end) {
+    var count = 0;
+    for (var i = start; i >= end; i--)
+        count++;
+    return count;
+}
+noInline(countDownInclusive);
+
+function countWithBreak(limit) {
+    var count = 0;
+    for (;;) {
+        if (count == limit)
+            break;
+        count++;
+    }
+    return count;
+}
+noInline(countWithBreak);
+
+function swap(a, b) {
+    var t = a;
+    a = b;
+    b = t;
+    return a + ":" + b;
+}
+noInline(swap);
+
+function callMethod(o) {
+    return o.method() + o.method(1);
+}
+noInline(callMethod);
+
+function setBoth(o, a, b) {
+    o.a = a;
+    o.b = b;
+    return o;
+}
+noInline(setBoth);
+
+function Pair() {
+    this.a = 0;
+    this.b = 0;
+}
+
+var withMethod = { method: function(x) { return (x | 0) + 1; } };
+var withOtherMethod = { other: 0, method: function(x) { return (x | 0) + 2; } };
+var withGetter = { get method() { return function(x) { return (x | 0) + 3; }; } };
+
+for (var i = 0; i < 10000; ++i) {
+    shouldBe(countUp(0, 10), 10);
+    shouldBe(countUp(0.5, 10), 10);
+    shouldBe(countUp(-5, -10), 0);
+    shouldBe(countUpInclusive(0, 10), 11);
+    shouldBe(countUpInclusive("0", 3), 4);
+    shouldBe(countDown(10, 0), 10);
+    shouldBe(countDown(10, -0.5), 11);
+    shouldBe(countDownInclusive(10, 0), 11);
+    shouldBe(countDownInclusive(0, 0), 1);
+    shouldBe(countWithBreak(7), 7);
+    shouldBe(swap(1, 2), "2:1");
+    shouldBe(callMethod(withMethod), 3);
+    shouldBe(callMethod(withOtherMethod), 5);
+    shouldBe(callMethod(withGetter), 7);
+
+    var pair = setBoth(new Pair, i, i + 1);
+    shouldBe(pair.a + pair.b, 2 * i + 1);
+    pair = setBoth(new Pair, i + 0.5, "b");
+    shouldBe(pair.a, i + 0.5);
+    shouldBe(pair.b, "b");
+    var other = setBoth({ b: 1, a: 2 }, 3, 4);
+    shouldBe(other.a * 10 + other.b, 34);
+    var fresh = setBoth({}, 5, 6);
+    shouldBe(fresh.a * 10 + fresh.b, 56);
+    var setterCalls = 0;
+    setBoth({ set a(x) { setterCalls += x; }, b: 0 }, 7, 8);
+    shouldBe(setterCalls, 7);
+}
@@ -0,0 +1,30 @@
+function assert(actual, expected, message) {
+    if (actual !== expected)
+        throw new Error("bad " + message + ": " + actual + " expected " + expected);
+}
+
+// Local time offsets are cached per period over which they don't change, so the offset of a
+// time must not depend on which times were looked up before it.
+var hour = 60 * 60 * 1000;
+var start = Date.UTC(1965, 0, 1) + 17;
+var count = 3 * 24 * 365 * 3;
+var offsets = [];
+for (var i = 0; i < count; ++i)
+    offsets.push(new Date(start + i * 7 * hour).getTimezoneOffset());
+
+for (var i = count; i--;)
+    assert(new Date(start + i * 7 * hour + 1).getTimezoneOffset(), offsets[i], "offset walking backwards at " + i);
+
+var seed = 1;
+for (var i = 0; i < 10000; ++i) {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    var index = seed % count;
+    var date = new Date(start + index * 7 * hour + 2);
+    assert(date.getTimezoneOffset(), offsets[index], "offset in random order at " + index);
+
+    var local = new Date(date.getFullYear(), date.getMonth(), date.getDate(), date.getHours(), date.getMinutes(), date.getSeconds(), date.getMilliseconds());
+    var utc = Date.UTC(date.getFullYear(), date.getMonth(), date.getDate(), date.getHours(), date.getMinutes(), date.getSeconds(), date.getMilliseconds());
+    assert(utc - date.getTime(), -date.getTimezoneOffset() * 60 * 1000, "local components at " + index);
+    if (local.getHours() === date.getHours())
+        assert(local.getTime() - date.getTime() + (local.getTimezoneOffset() - date.getTimezoneOffset()) * 60 * 1000, 0, "round trip through local time at " + index);
+}
@@ -0,0 +1,48 @@
+function assert(b, message) {
+    if (!b)
+        throw new Error("Bad assertion: " + message);
+}
+
+function sum(array) {
+    var result = 0;
+    for (var i = 0; i < array.length; ++i)
+        result += array[i];
+    return result;
+}
+
+function check(kind, phase, minimumCount) {
+    var histogram = gcPauseHistogram(kind, phase);
+    assert(histogram.buckets.length == 16, kind + " " + phase + " bucket count");
+    assert(histogram.count >= minimumCount, kind + " " + phase + " count " + histogram.count);
+    assert(sum(histogram.buckets) == histogram.count, kind + " " + phase + " buckets add up to the count");
+    assert(histogram.totalMilliseconds >= 0, kind + " " + phase + " total");
+    assert(histogram.maxMilliseconds <= histogram.totalMilliseconds, kind + " " + phase + " max is at most the total");
+    assert(histogram.maxMilliseconds * histogram.count >= histogram.totalMilliseconds, kind + " " + phase + " max is at least the mean");
+    assert(histogram.p50Milliseconds <= histogram.p99Milliseconds, kind + " " + phase + " p50 is at most p99");
+    assert(histogram.p99Milliseconds <= histogram.maxMilliseconds, kind + " " + phase + " p99 is at most the max");
+    return histogram;
+}
+
+var edenBefore = gcPauseHistogram("eden", "pause").count;
+var fullBefore = gcPauseHistogram("full", "pause").count;
+
+var live = [];
+for (var i = 0; i < 10; ++i) {
+    for (var j = 0; j < 1000; ++j)
+        live.push({ i: i, j: j });
+    edenGC();
+    fullGC();
+}
+
+var edenPauses = check("eden", "pause", edenBefore);
+var fullPauses = check("full", "pause", fullBefore + 10);
+// Eden requests become full collections when generational GC is off.
+assert(edenPauses.count + fullPauses.count >= edenBefore + fullBefore + 20, "every collection is recorded");
+var edenMarking = check("eden", "marking", 0);
+var fullMarking = check("full", "marking", 0);
+
+// Every collection records its pause and its marking phase together.
+assert(edenMarking.count == edenPauses.count, "eden marking and pause counts match");
+assert(fullMarking.count == fullPauses.count, "full marking and pause counts match");
+assert(edenMarking.totalMilliseconds <= edenPauses.totalMilliseconds, "eden marking is part of the pause");
+assert(fullMarking.totalMilliseconds <= fullPauses.totalMilliseconds, "full marking is part of the pause");
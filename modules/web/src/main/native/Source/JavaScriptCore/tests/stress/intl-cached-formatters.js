@@ -0,0 +1,54 @@
+function assert(actual, expected, message) {
+    if (actual !== expected)
+        throw new Error("bad " + message + ": " + actual + " expected " + expected);
+}
+
+// Formatters opened with the same options come from the VM's cache after the first one, so
+// repeated calls have to keep producing what the first call did, and different options must
+// never share a formatter.
+var firstNumber = (1234567.891).toLocaleString("en-US");
+var firstPercent = (0.256).toLocaleString("en-US", { style: "percent" });
+var firstCurrency = (12.5).toLocaleString("en-US", { style: "currency", currency: "EUR" });
+var firstDigits = (1.5).toLocaleString("en-US", { minimumFractionDigits: 3 });
+assert(firstNumber, "1,234,567.891", "number");
+assert(firstPercent, "26%", "percent");
+assert(firstDigits, "1.500", "fraction digits");
+
+for (var i = 0; i < 100; ++i) {
+    assert((1234567.891).toLocaleString("en-US"), firstNumber, "cached number");
+    assert((0.256).toLocaleString("en-US", { style: "percent" }), firstPercent, "cached percent");
+    assert((12.5).toLocaleString("en-US", { style: "currency", currency: "EUR" }), firstCurrency, "cached currency");
+    assert((12.5).toLocaleString("en-US", { style: "currency", currency: "USD" }), "$12.50", "cached currency in another code");
+    assert((1.5).toLocaleString("en-US", { minimumFractionDigits: 3 }), firstDigits, "cached fraction digits");
+    assert((1234).toLocaleString("en-US", { useGrouping: false }), "1234", "cached without grouping");
+}
+
+assert("a".localeCompare("b", "en"), -1, "ASCII compare");
+assert("a".localeCompare("A", "en"), -1, "ASCII case compare");
+assert("a".localeCompare("A", "en", { sensitivity: "base" }), 0, "ASCII base compare");
+assert("a".localeCompare("á", "en", { sensitivity: "base" }), 0, "mixed width base compare");
+assert("a".localeCompare("á", "en", { sensitivity: "accent" }), -1, "mixed width accent compare");
+assert("item10".localeCompare("item9", "en", { numeric: true }), 1, "numeric compare");
+assert("item10".localeCompare("item9", "en"), -1, "non-numeric compare");
+for (var i = 0; i < 100; ++i) {
+    assert("a".localeCompare("A", "en", { sensitivity: "base" }), 0, "cached base compare");
+    assert("a".localeCompare("A", "en"), -1, "cached case compare");
+    assert("item10".localeCompare("item9", "en", { numeric: true }), 1, "cached numeric compare");
+    assert("item10".localeCompare("item9", "en"), -1, "cached non-numeric compare");
+}
+
+var words = ["pear", "Apple", "banana", "apple", "Banana", "cherry"];
+assert(words.slice().sort(function (a, b) { return a.localeCompare(b, "en"); }).join(), "apple,Apple,banana,Banana,cherry,pear", "sorted words");
+
+var date = new Date(Date.UTC(2016, 9, 18, 12, 30, 15));
+var firstDate = date.toLocaleDateString("en-US", { timeZone: "UTC" });
+var firstTime = date.toLocaleTimeString("en-US", { timeZone: "UTC" });
+assert(firstDate, "10/18/2016", "date");
+for (var i = 0; i < 100; ++i) {
+    assert(date.toLocaleDateString("en-US", { timeZone: "UTC" }), firstDate, "cached date");
+    assert(date.toLocaleTimeString("en-US", { timeZone: "UTC" }), firstTime, "cached time");
+    var format = new Intl.DateTimeFormat("en-US", { timeZone: "UTC", year: "numeric", month: "long" });
+    assert(format.format(date), "October 2016", "cached long month");
+    assert(format.resolvedOptions().month, "long", "resolved options of a cached format");
+    assert(format.resolvedOptions().day, undefined, "resolved options without a day");
+}
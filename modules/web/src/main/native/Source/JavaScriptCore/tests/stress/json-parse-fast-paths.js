@@ -0,0 +1,63 @@
+function shouldBe(actual, expected) {
+    if (actual !== expected)
+        throw new Error("bad value: " + actual + ", expected: " + expected);
+}
+
+function shouldThrow(func) {
+    var error = null;
+    try {
+        func();
+    } catch (e) {
+        error = e;
+    }
+    if (!(error instanceof SyntaxError))
+        throw new Error("bad error: " + error);
+}
+
+// Strings long enough to be scanned a vector at a time, with the stop characters at every offset.
+var filler = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJ";
+for (var i = 0; i < filler.length; ++i) {
+    var prefix = filler.substring(0, i);
+    shouldBe(JSON.parse('"' + prefix + '\\n' + filler + '"'), prefix + "\n" + filler);
+    shouldBe(JSON.parse('"' + prefix + '\\"' + filler + '"'), prefix + '"' + filler);
+    shouldBe(JSON.parse('"' + prefix + '\\u0041' + filler + '"'), prefix + "A" + filler);
+    shouldBe(JSON.parse('"' + prefix + 'éÿ' + filler + '"'), prefix + "éÿ" + filler);
+    shouldBe(JSON.parse('"' + prefix + 'あ가' + filler + '"'), prefix + "あ가" + filler);
+    shouldBe(JSON.parse('["' + prefix + '","' + filler + '"]').join(), prefix + "," + filler);
+    shouldThrow(function() { JSON.parse('"' + prefix + '\t' + filler + '"'); });
+    shouldThrow(function() { JSON.parse('"' + prefix + '\u001f' + filler + '"'); });
+    shouldThrow(function() { JSON.parse('"' + prefix + 'あ\n' + filler + '"'); });
+    shouldThrow(function() { JSON.parse('"' + prefix + filler); });
+}
+
+// Numbers must round exactly like the general double parser.
+var numbers = [
+    "0", "-0", "7", "-42", "123456789", "1234567890", "999999999999999", "9007199254740993",
+    "123456789012345678901234567890", "0.1", "0.2", "0.3", "-0.5", "1.5e3", "1.5E+3", "25e-2",
+    "0.000001", "0.0000000000000000000001", "1e22", "1e23", "1e-22", "1e-23", "5e-324", "1e309",
+    "-1e309", "1.7976931348623157e308", "2.2250738585072014e-308", "3.141592653589793",
+    "123.456", "0.30000000000000004", "100000000000000000000000", "1e0000000000000001"
+];
+for (var i = 0; i < numbers.length; ++i) {
+    var parsed = JSON.parse(numbers[i]);
+    shouldBe(Object.is(parsed, Number(numbers[i])), true);
+    shouldBe(Object.is(JSON.parse("[" + numbers[i] + "]")[0], parsed), true);
+}
+shouldBe(Object.is(JSON.parse("-0.0"), -0), true);
+shouldThrow(function() { JSON.parse("01"); });
+shouldThrow(function() { JSON.parse("1."); });
+shouldThrow(function() { JSON.parse("1e"); });
+shouldThrow(function() { JSON.parse("-"); });
+
+// Repeated keys, including keys that share their first character, come back as the same properties.
+var records = [];
+for (var i = 0; i < 100; ++i)
+    records.push('{"id":' + i + ',"index":' + (i * 2) + ',"items":["x"],"i":' + i + ',"あkey":true}');
+var parsed = JSON.parse("[" + records.join(",") + "]");
+for (var i = 0; i < 100; ++i) {
+    shouldBe(Object.keys(parsed[i]).join(), "id,index,items,i,あkey");
+    shouldBe(parsed[i].id, i);
+    shouldBe(parsed[i].index, i * 2);
+    shouldBe(parsed[i].items[0], "x");
+    shouldBe(parsed[i]["あkey"], true);
+}
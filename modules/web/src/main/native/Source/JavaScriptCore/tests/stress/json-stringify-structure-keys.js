@@ -0,0 +1,59 @@
+function shouldBe(actual, expected) {
+    if (actual !== expected)
+        throw new Error("bad value: " + actual + ", expected: " + expected);
+}
+
+// Records that share a structure.
+var records = [];
+for (var i = 0; i < 100; ++i)
+    records.push({ id: i, name: "n\"" + i, "quoted\\key": true, nested: { x: i } });
+var text = JSON.stringify(records);
+shouldBe(text.indexOf('{"id":3,"name":"n\\"3","quoted\\\\key":true,"nested":{"x":3}}') > 0, true);
+shouldBe(JSON.stringify(JSON.parse(text)), text);
+shouldBe(JSON.stringify([{ a: 1, b: 2 }, { a: 3, b: 4 }], null, 2), '[\n  {\n    "a": 1,\n    "b": 2\n  },\n  {\n    "a": 3,\n    "b": 4\n  }\n]');
+shouldBe(JSON.stringify([{ a: 1, b: 2 }, { a: 3, b: 4 }], null, "\t-"), '[\n\t-{\n\t-\t-"a": 1,\n\t-\t-"b": 2\n\t-},\n\t-{\n\t-\t-"a": 3,\n\t-\t-"b": 4\n\t-}\n]');
+
+// Undefined, function and symbol values are still left out.
+shouldBe(JSON.stringify([{ a: undefined, b: 1, c: function() { }, d: Symbol() }, { a: 2, b: undefined, c: 3, d: 4 }]), '[{"b":1},{"a":2,"c":3,"d":4}]');
+
+// A toJSON function that reshapes or empties the object being serialized.
+var shared = { first: { toJSON: function() { delete shared.second; shared.third = 3; return "x"; } }, second: 2 };
+shouldBe(JSON.stringify(shared), '{"first":"x"}');
+var target = { a: { toJSON: function() { target.b = "changed"; return 1; } }, b: "original" };
+shouldBe(JSON.stringify([target, target]), '[{"a":1,"b":"changed"},{"a":1,"b":"changed"}]');
+
+// Replacers and the objects they see.
+shouldBe(JSON.stringify([{ a: 1, b: 2 }, { a: 3, b: 4 }], function(key, value) { return key === "b" ? undefined : value; }), '[{"a":1},{"a":3}]');
+shouldBe(JSON.stringify([{ a: 1, b: 2 }, { a: 3, b: 4 }], ["b"]), '[{"b":2},{"b":4}]');
+
+// Objects that are not plain data properties take the generic path.
+var withGetter = { a: 1, get b() { return this.a + 1; } };
+shouldBe(JSON.stringify([withGetter, withGetter]), '[{"a":1,"b":2},{"a":1,"b":2}]');
+var withIndex = { b: 1, 1: "one", a: 2, 0: "zero" };
+shouldBe(JSON.stringify(withIndex), '{"0":"zero","1":"one","b":1,"a":2}');
+var withHidden = { a: 1 };
+Object.defineProperty(withHidden, "hidden", { value: 2, enumerable: false });
+shouldBe(JSON.stringify([withHidden, withHidden]), '[{"a":1},{"a":1}]');
+var dictionary = { a: 1, b: 2, c: 3 };
+delete dictionary.b;
+shouldBe(JSON.stringify([dictionary, dictionary]), '[{"a":1,"c":3},{"a":1,"c":3}]');
+
+// Many different shapes in one call.
+var shapes = [];
+for (var i = 0; i < 200; ++i) {
+    var object = {};
+    object["key" + i] = i;
+    shapes.push(object);
+}
+var shapesText = JSON.stringify(shapes);
+shouldBe(JSON.parse(shapesText)[150].key150, 150);
+
+// Strings long enough to be checked for escapes a vector at a time.
+var filler = "abcdefghijklmnopqrstuvwxyz0123456789";
+for (var i = 0; i < filler.length; ++i) {
+    var prefix = filler.substring(0, i);
+    shouldBe(JSON.stringify(prefix + "\"" + filler), '"' + prefix + '\\"' + filler + '"');
+    shouldBe(JSON.stringify(prefix + "\u0001" + filler), '"' + prefix + '\\u0001' + filler + '"');
+    shouldBe(JSON.stringify(prefix + "あ\n" + filler), '"' + prefix + 'あ\\n' + filler + '"');
+    shouldBe(JSON.stringify(prefix + "\\" + filler + "é"), '"' + prefix + '\\\\' + filler + 'é"');
+}
@@ -0,0 +1,98 @@
+function shouldBe(actual, expected) {
+    if (actual !== expected)
+        throw new Error("bad value: " + actual + ", expected: " + expected);
+}
+
+var symbol = Symbol("key");
+var object = {};
+var keys = [0, -0, 1, 1.5, NaN, "0", "1", "", "a" + "b", true, false, null, undefined, symbol, object, 2147483648];
+
+for (var iteration = 0; iteration < 100; ++iteration) {
+    var map = new Map;
+    for (var i = 0; i < keys.length; ++i)
+        map.set(keys[i], i);
+
+    // -0 and 0 are the same key, as are NaNs and strings with the same contents.
+    shouldBe(map.size, keys.length - 1);
+    shouldBe(map.get(0), 1);
+    shouldBe(map.get(0.0 / -1), 1);
+    shouldBe(map.get(0 / 0), 4);
+    shouldBe(map.get(1.0), 2);
+    shouldBe(map.get("1"), 6);
+    shouldBe(map.get(["a", "b"].join("")), 8);
+    shouldBe(map.get(String.fromCharCode(97) + "b"), 8);
+    shouldBe(map.get(symbol), 13);
+    shouldBe(map.get(Symbol("key")), undefined);
+    shouldBe(map.get(object), 14);
+    shouldBe(map.get({}), undefined);
+    shouldBe(map.get(2147483648), 15);
+    shouldBe(map.has("undefined"), false);
+    shouldBe(map.has(undefined), true);
+
+    // Deleting and re-adding moves a key to the end of the iteration order.
+    shouldBe(map.delete("1"), true);
+    shouldBe(map.delete("1"), false);
+    map.set("1", "again");
+    var order = [];
+    map.forEach(function (value, key) { order.push(String(key)); });
+    shouldBe(order[order.length - 1], "1");
+    shouldBe(order[0], "0");
+}
+
+// Iterators keep their place while entries are deleted and the backing store is packed.
+var set = new Set;
+for (var i = 0; i < 1000; ++i)
+    set.add("key" + i);
+var seen = 0;
+for (var key of set) {
+    var n = +key.substring(3);
+    shouldBe(n % 2, 0);
+    ++seen;
+    set.delete("key" + (n + 1));
+    if (n < 100)
+        set.add("key" + (n + 1000) * 2);
+}
+shouldBe(seen, 550);
+shouldBe(set.size, seen);
+
+// Lots of churn exercises rehashing the index and reusing deleted slots.
+var churn = new Map;
+for (var i = 0; i < 100000; ++i) {
+    churn.set(i % 3000, i);
+    if (i % 3)
+        churn.delete((i * 7) % 3000);
+}
+// Model the expected contents with a plain object, so that a bug shared by every
+// Map cannot hide itself.
+var expected = {};
+var expectedSize = 0;
+for (var i = 0; i < 100000; ++i) {
+    var key = i % 3000;
+    if (!(key in expected))
+        ++expectedSize;
+    expected[key] = i;
+    if (i % 3) {
+        var deleted = (i * 7) % 3000;
+        if (deleted in expected) {
+            delete expected[deleted];
+            --expectedSize;
+        }
+    }
+}
+shouldBe(churn.size, expectedSize);
+for (var key = 0; key < 3000; ++key) {
+    shouldBe(churn.has(key), key in expected);
+    shouldBe(churn.get(key), expected[key]);
+}
+var count = 0;
+churn.forEach(function (value, key) {
+    shouldBe(expected[key], value);
+    ++count;
+});
+shouldBe(count, expectedSize);
+
+churn.clear();
+shouldBe(churn.size, 0);
+shouldBe(churn.get(1), undefined);
+churn.set(1, 2);
+shouldBe(churn.get(1), 2);
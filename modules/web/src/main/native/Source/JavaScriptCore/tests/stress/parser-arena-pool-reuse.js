@@ -0,0 +1,32 @@
+// Parser arena pools are handed from one parse to the next. Parses of very
+// different sizes, including ones that fail, must not see each other's nodes.
+
+function shouldBe(actual, expected) {
+    if (actual !== expected)
+        throw new Error("bad value: " + actual + " expected: " + expected);
+}
+
+function bigSource(count) {
+    var source = "var total = 0;";
+    for (var i = 0; i < count; ++i)
+        source += "total += (function(a, { b }, [c] = [" + i + "]) { return a + b + c; })(1, { b: 2 });";
+    return source + "total";
+}
+
+for (var i = 0; i < 200; ++i) {
+    shouldBe(eval("(function(x) { return x * 2; })(" + i + ")"), i * 2);
+    shouldBe(new Function("a", "b", "return a + b + " + i)(1, 2), 3 + i);
+
+    if (i % 20 == 0) {
+        var count = 50 + i;
+        shouldBe(eval(bigSource(count)), count * 3 + count * (count - 1) / 2);
+    }
+
+    var threw = false;
+    try {
+        eval("(function() { var x = { a: [1, 2, 3], b: ; })");
+    } catch (e) {
+        threw = e instanceof SyntaxError;
+    }
+    shouldBe(threw, true);
+}
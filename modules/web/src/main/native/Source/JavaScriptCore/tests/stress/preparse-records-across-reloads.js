@@ -0,0 +1,18 @@
+// Function records from the first load of a script are kept after its source
+// provider is gone. Later loads of the same file skip those function bodies and
+// must still behave exactly like the first load.
+
+function shouldBe(actual, expected) {
+    if (actual !== expected)
+        throw new Error("bad value: " + actual + " expected: " + expected);
+}
+
+var expected = "103,42,42,36,4:8:0,1:5:2,9,30";
+
+for (var i = 0; i < 5; ++i) {
+    load("./resources/preparse-reload-helper.js");
+    shouldBe(reloadResults.join(), expected);
+    shouldBe(makeCounter(1)(1), 2);
+    shouldBe(strictOuter(), 42);
+    fullGC();
+}
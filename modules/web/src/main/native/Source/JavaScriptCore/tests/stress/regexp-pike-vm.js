@@ -0,0 +1,60 @@
+function shouldBe(actual, expected) {
+    if (actual !== expected)
+        throw new Error("bad value: " + actual + ", expected: " + expected);
+}
+
+function shouldBeArray(actual, expected) {
+    if (actual === null || expected === null) {
+        shouldBe(actual, expected);
+        return;
+    }
+    shouldBe(actual.length, expected.length);
+    for (var i = 0; i < expected.length; ++i)
+        shouldBe(actual[i], expected[i]);
+}
+
+for (var i = 0; i < 100; ++i) {
+    // Priority order between alternatives and quantifiers.
+    shouldBeArray(/(a|ab)(c|bcd)(d*)/.exec("abcd"), ["abcd", "a", "bcd", ""]);
+    shouldBeArray(/(a)|b/.exec("b"), ["b", undefined]);
+    shouldBe(/a+?b/.exec("xaaab")[0], "aaab");
+    shouldBe(/<.+?>/.exec("<a><b>")[0], "<a>");
+    shouldBeArray(/(\d{1,3})\.(\d{1,3})/.exec("ip 10.200.3"), ["10.200", "10", "200"]);
+    shouldBeArray(/([a-c]{2,3}?)(c*)d/.exec("abccd"), ["abccd", "ab", "cc"]);
+
+    // Captures inside a quantified group are reset on every iteration.
+    shouldBeArray(/(?:(a)|b)+/.exec("ab"), ["ab", undefined]);
+    shouldBeArray(/(z)((a+)?(b+)?(c))*/.exec("zaacbbbcac"), ["zaacbbbcac", "z", "ac", "a", undefined, "c"]);
+
+    // Flags and assertions.
+    shouldBe(/HELLO/i.exec("say hello").index, 4);
+    shouldBe(/^b/m.exec("a\nb").index, 2);
+    shouldBe(/^b/.test("a\nb"), false);
+    shouldBe(/a$/m.test("a\nb"), true);
+    shouldBe(/a$/.test("a\nb"), false);
+    shouldBe(/^a|b/.exec("cab").index, 2);
+    shouldBe(/\bfoo\b/.exec("a foo b").index, 2);
+    shouldBe(/\Bfoo/.test("foo"), false);
+    shouldBe(/.*foo.*/.exec("x\nbarfoobaz\ny")[0], "barfoobaz");
+
+    // Prefilters.
+    shouldBe(/x(y)/.exec("abc"), null);
+    shouldBe(/key=[^;]*;/.exec("a=1; key=2; b=3")[0], "key=2;");
+    shouldBe(/あ/.test("abc"), false);
+
+    // Global matching, start offsets and 16-bit subjects.
+    shouldBe("a1b22c333".match(/\d+/g).join(), "1,22,333");
+    shouldBe("あxyzあ".replace(/x(y)z/, "[$1]"), "あ[y]あ");
+    var re = /o+/g;
+    re.lastIndex = 5;
+    shouldBe(re.exec("foo boo").index, 5);
+
+    // Patterns that need the backtracking interpreter still work.
+    shouldBeArray(/(a*)*b/.exec("b"), ["b", undefined]);
+    shouldBe(/(a)\1/.test("aa"), true);
+    shouldBe(/a(?=b)/.exec("acab").index, 2);
+}
+
+// Nested quantifiers no longer backtrack exponentially without a JIT.
+shouldBe(/(a+)+b/.test("aaaaaaaaaaaaaaaaaaaa"), false);
+shouldBe(/(x+x+)+y/.test("xxxxxxxxxxxxxxxx"), false);
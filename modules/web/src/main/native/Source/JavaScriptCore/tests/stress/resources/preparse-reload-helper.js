@@ -0,0 +1,79 @@
+// Loaded several times by preparse-records-across-reloads.js. Large enough for
+// the records of its functions to be kept across loads.
+
+var reloadResults = [];
+
+function makeCounter(start) {
+    var count = start;
+    function increment(step) {
+        count += step;
+        return count;
+    }
+    return increment;
+}
+
+function strictOuter() {
+    "use strict";
+    function inner(a, b) {
+        var local = a * b;
+        return typeof this === "undefined" ? local : -local;
+    }
+    return inner(6, 7);
+}
+
+function usesEval(source) {
+    var hidden = 40;
+    return eval(source);
+}
+
+function arrows(values) {
+    var offset = 10;
+    var mapped = values.map((value) => value + offset);
+    var summed = mapped.reduce((sum, value) => {
+        var next = sum + value;
+        return next;
+    }, 0);
+    return summed;
+}
+
+function defaultsAndRest(first, second = first * 2, ...rest) {
+    function describe() {
+        return first + ":" + second + ":" + rest.length;
+    }
+    return describe();
+}
+
+function closuresWriteOuter() {
+    var written = 0;
+    var readers = [];
+    for (var i = 0; i < 3; ++i) {
+        readers.push(function () {
+            written += i;
+            return written;
+        });
+    }
+    readers.forEach(function (reader) { reader(); });
+    return written;
+}
+
+function nestedGenerators() {
+    function* generate(limit) {
+        for (var i = 0; i < limit; ++i)
+            yield i * i;
+    }
+    var total = 0;
+    for (var value of generate(5))
+        total += value;
+    return total;
+}
+
+var counter = makeCounter(100);
+counter(1);
+reloadResults.push(counter(2));
+reloadResults.push(strictOuter());
+reloadResults.push(usesEval("hidden + 2"));
+reloadResults.push(arrows([1, 2, 3]));
+reloadResults.push(defaultsAndRest(4));
+reloadResults.push(defaultsAndRest(1, 5, 6, 7));
+reloadResults.push(closuresWriteOuter());
+reloadResults.push(nestedGenerators());
@@ -0,0 +1,95 @@
+function assert(actual, expected, message) {
+    if (actual !== expected)
+        throw new Error("bad " + message + ": " + actual + " expected " + expected);
+}
+
+function reference(pieces) {
+    var result = [];
+    for (var i = 0; i < pieces.length; ++i)
+        result.push(pieces[i]);
+    return result.join("");
+}
+
+// Appending while reading the string back resolves the same growing rope over and over.
+(function () {
+    var pieces = [];
+    var s = "";
+    for (var i = 0; i < 3000; ++i) {
+        var piece = "piece" + i + ";";
+        pieces.push(piece);
+        s += piece;
+        if (i % 7 == 0)
+            assert(s.indexOf("piece" + i + ";"), s.length - piece.length, "indexOf after append " + i);
+    }
+    assert(s, reference(pieces), "appended string");
+})();
+
+// Two strings that share a resolved prefix must not overwrite each other.
+(function () {
+    var base = "";
+    for (var i = 0; i < 400; ++i)
+        base += String.fromCharCode(97 + i % 26);
+    base.charCodeAt(0);
+
+    var first = base + "first";
+    var second = base + "second";
+    first.charCodeAt(0);
+    second.charCodeAt(0);
+    assert(first.slice(-5), "first", "first branch");
+    assert(second.slice(-6), "second", "second branch");
+    assert(first.slice(0, 400), base, "first prefix");
+    assert(second.slice(0, 400), base, "second prefix");
+
+    var third = first + "third";
+    var fourth = base + "fourth";
+    third.charCodeAt(0);
+    fourth.charCodeAt(0);
+    assert(third.slice(-10), "firstthird", "third branch");
+    assert(fourth.slice(-6), "fourth", "fourth branch");
+    assert(first.length, 405, "first length");
+})();
+
+// Appending a string to itself reads from the part of the buffer being appended to.
+(function () {
+    var s = "";
+    for (var i = 0; i < 300; ++i)
+        s += "ab";
+    s.charCodeAt(0);
+    for (var i = 0; i < 4; ++i) {
+        s = s + s;
+        s.charCodeAt(0);
+    }
+    assert(s.length, 600 * 16, "doubled length");
+    assert(s.replace(/ab/g, ""), "", "doubled contents");
+})();
+
+// Sixteen-bit appends, and appends that switch from eight to sixteen bits.
+(function () {
+    var pieces = [];
+    var s = "";
+    for (var i = 0; i < 1000; ++i) {
+        var piece = i == 500 ? "☃" : (i > 500 ? "éλ" : "x" + i);
+        pieces.push(piece);
+        s += piece;
+        if (i % 10 == 0)
+            s.charCodeAt(0);
+    }
+    assert(s, reference(pieces), "mixed width string");
+})();
+
+// Substrings of ropes are taken from the fiber that holds them, and still see the right characters.
+(function () {
+    var left = "";
+    var right = "";
+    for (var i = 0; i < 100; ++i) {
+        left += "L" + i;
+        right += "R" + i;
+    }
+    var rope = left + "|" + right;
+    assert(rope.slice(0, 3), "L0L", "slice of left fiber");
+    assert(rope.substr(left.length + 1, 2), "R0", "substr of right fiber");
+    assert(rope.substring(left.length - 2, left.length + 3), "99|R0", "substring across fibers");
+    assert(rope.slice(0, left.length), left, "slice equal to a fiber");
+    assert(rope.slice(left.length + 1), right, "slice equal to the last fiber");
+    assert(rope, left + "|" + right, "rope after slicing");
+})();
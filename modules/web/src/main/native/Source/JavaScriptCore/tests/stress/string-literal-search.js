@@ -0,0 +1,42 @@
+function assert(actual, expected, message) {
+    if (actual !== expected)
+        throw new Error("bad " + message + ": " + actual + " expected " + expected);
+}
+
+function assertArray(actual, expected, message) {
+    assert(actual.length, expected.length, message + " length");
+    for (var i = 0; i < expected.length; ++i)
+        assert(actual[i], expected[i], message + " [" + i + "]");
+}
+
+var line = "2016-10-18 12:00:01,INFO,a,,b,request done,status=200";
+assertArray(line.split(","), ["2016-10-18 12:00:01", "INFO", "a", "", "b", "request done", "status=200"], "split on comma");
+assertArray(line.split(",", 3), ["2016-10-18 12:00:01", "INFO", "a"], "split with limit");
+assertArray("a,b,c".split(","), ["a", "b", "c"], "split into single characters");
+assertArray("a::b::::c".split("::"), ["a", "b", "", "c"], "split on two characters");
+assertArray("xéyéz".split("é"), ["x", "y", "z"], "split on a Latin-1 character");
+assertArray("x☃y".split("☃"), ["x", "y"], "split on a 16-bit character");
+assertArray("abc".split("☃"), ["abc"], "split on a missing 16-bit character");
+
+// The pieces of a split share the same single-character strings.
+var pieces = "a,a,a".split(",");
+assert(pieces[0] === pieces[2], true, "single character pieces");
+
+assert(line.indexOf("status"), 43, "indexOf");
+assert(line.indexOf(",", 20), 24, "indexOf a character after a position");
+assert(line.indexOf("INFO", 21), -1, "indexOf past the only match");
+assert(line.lastIndexOf(","), 42, "lastIndexOf");
+assert(line.includes("request done"), true, "includes");
+assert(line.includes("request done", 40), false, "includes after the match");
+assert(line.replace(",", ";"), "2016-10-18 12:00:01;INFO,a,,b,request done,status=200", "replace");
+assert(line.replace("status=", "$&!"), "2016-10-18 12:00:01,INFO,a,,b,request done,status=!200", "replace with a pattern");
+
+// Runs of the first character of the pattern, in front of the match and without one.
+var run = "";
+for (var i = 0; i < 5000; ++i)
+    run += "a";
+var pattern = run.slice(0, 100) + "b";
+assert((run + "b").indexOf(pattern), 4900, "indexOf after a run");
+assert(run.indexOf(pattern), -1, "indexOf in a run");
+assert((run + "b").includes(pattern, 4901), false, "includes after a run");
+assertArray((run + "b" + run + "b").split(pattern), [run.slice(100), run.slice(100), ""], "split on a run");
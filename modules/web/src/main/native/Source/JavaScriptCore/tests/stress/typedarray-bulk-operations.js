@@ -0,0 +1,91 @@
+function assert(actual, expected, message) {
+    if (!Object.is(actual, expected))
+        throw new Error("bad " + message + ": " + actual + " expected " + expected);
+}
+
+var constructors = [Int8Array, Uint8Array, Uint8ClampedArray, Int16Array, Uint16Array, Int32Array, Uint32Array, Float32Array, Float64Array];
+
+var seed = 1;
+function random() {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed;
+}
+
+// Long arrays are sorted by radix sort, short ones by comparison, and both must agree with a
+// comparison sort of the same values.
+function compare(a, b) {
+    if (a !== a)
+        return b !== b ? 0 : 1;
+    if (b !== b)
+        return -1;
+    if (a === 0 && b === 0)
+        return Object.is(a, -0) ? (Object.is(b, -0) ? 0 : -1) : (Object.is(b, -0) ? 1 : 0);
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+
+for (var constructor of constructors) {
+    for (var length of [0, 1, 100, 255, 256, 1000, 5000]) {
+        var array = new constructor(length);
+        for (var i = 0; i < length; ++i) {
+            var value = random() - 1073741824;
+            if (constructor === Float32Array || constructor === Float64Array) {
+                var special = [NaN, -0, 0, Infinity, -Infinity, 1e-310, -1e-310];
+                value = i % 10 ? value / 1000 : special[(i / 10) % special.length];
+            }
+            array[i] = value;
+        }
+        var expected = Array.prototype.slice.call(array).sort(compare);
+        array.sort();
+        for (var i = 0; i < length; ++i)
+            assert(array[i], expected[i], constructor.name + " of " + length + " sorted at " + i);
+    }
+}
+
+for (var constructor of constructors) {
+    var array = new constructor(1000);
+    array.fill(7);
+    assert(array[999], 7, constructor.name + " fill");
+    array.fill(0, 10, 20);
+    assert(array[9], 7, constructor.name + " fill before range");
+    assert(array[10], 0, constructor.name + " fill zero");
+    assert(array[20], 7, constructor.name + " fill after range");
+    array.fill(-1, 500);
+    assert(array[499], 7, constructor.name + " fill negative before range");
+    assert(array[500], new constructor([-1])[0], constructor.name + " fill negative");
+}
+var floats = new Float64Array(10);
+floats.fill(-0);
+assert(floats[3], -0, "fill with negative zero");
+
+var bytes = new Uint8Array([1, 44, 2, 44, 255]);
+assert(bytes.indexOf(44), 1, "byte indexOf");
+assert(bytes.indexOf(44, 2), 3, "byte indexOf from index");
+assert(bytes.indexOf(300), -1, "byte indexOf out of range");
+assert(bytes.indexOf(44.5), -1, "byte indexOf fraction");
+assert(bytes.indexOf(-1), -1, "byte indexOf negative");
+assert(bytes.indexOf(255), 4, "byte indexOf last");
+assert(bytes.indexOf(1, 5), -1, "byte indexOf past end");
+assert(bytes.lastIndexOf(44), 3, "byte lastIndexOf");
+assert(bytes.lastIndexOf(300), -1, "byte lastIndexOf out of range");
+assert(new Int8Array([-1, 5]).indexOf(255), -1, "signed byte indexOf of unsigned value");
+assert(new Int8Array([-1, 5]).indexOf(-1), 0, "signed byte indexOf");
+assert(new Uint8ClampedArray([255, 2]).indexOf(1000), -1, "clamped indexOf out of range");
+assert(new Int32Array([0, 1]).indexOf(-0), 0, "indexOf negative zero");
+assert(new Float32Array([0.1, 0.5]).indexOf(0.1), -1, "float indexOf of a double");
+assert(new Float32Array([0.1, 0.5]).indexOf(0.5), 1, "float indexOf");
+assert(new Float64Array([NaN, 1]).indexOf(NaN), -1, "indexOf NaN");
+assert(new Float64Array([NaN, 1]).lastIndexOf(NaN), -1, "lastIndexOf NaN");
+
+var source = new Float64Array([1.5, -2.5, 300, NaN, -0]);
+var target = new Int8Array(7);
+target.set(source, 1);
+assert([].join.call(target), "0,1,-2,44,0,0,0", "set converting doubles to bytes");
+var buffer = new ArrayBuffer(16);
+var wide = new Int32Array(buffer);
+wide.set([1, 2, 3, 4]);
+var narrow = new Int8Array(buffer, 2, 4);
+wide.set(narrow);
+assert([].join.call(wide), "0,0,2,0", "set from an overlapping narrower view");
+var overlapping = new Uint32Array(buffer, 4, 3);
+new Int32Array(buffer, 0, 3).set(overlapping);
+assert([].join.call(wide), "0,2,0,0", "set from an overlapping view of the same size");
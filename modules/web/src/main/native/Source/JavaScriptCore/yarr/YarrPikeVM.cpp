@@ -0,0 +1,812 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "YarrPikeVM.h"
+
+#include "Yarr.h"
+#include <string.h>
+#include <unicode/uchar.h>
+#include <wtf/text/WTFString.h>
+
+using namespace WTF;
+
+namespace JSC { namespace Yarr {
+
+// Counted quantifiers are unrolled, so cap the program (and with it the capture
+// table kept by the pattern) rather than let /a{100000}/ hold on to megabytes.
+static const unsigned maximumInstructionCount = 4096;
+static const unsigned maximumCaptureTableSize = 1 << 16;
+
+static bool testCharacterClass(CharacterClass* characterClass, int ch)
+{
+    if (ch & 0x1FFF80) {
+        for (unsigned i = 0; i < characterClass->m_matchesUnicode.size(); ++i) {
+            if (ch == characterClass->m_matchesUnicode[i])
+                return true;
+        }
+        for (unsigned i = 0; i < characterClass->m_rangesUnicode.size(); ++i) {
+            if ((ch >= characterClass->m_rangesUnicode[i].begin) && (ch <= characterClass->m_rangesUnicode[i].end))
+                return true;
+        }
+    } else {
+        for (unsigned i = 0; i < characterClass->m_matches.size(); ++i) {
+            if (ch == characterClass->m_matches[i])
+                return true;
+        }
+        for (unsigned i = 0; i < characterClass->m_ranges.size(); ++i) {
+            if ((ch >= characterClass->m_ranges[i].begin) && (ch <= characterClass->m_ranges[i].end))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+static bool isCaseInvariant(YarrPattern& pattern, UChar32 ch)
+{
+    return !pattern.m_ignoreCase || u_tolower(ch) == u_toupper(ch);
+}
+
+static unsigned findCharacter(const LChar* input, unsigned length, unsigned start, UChar32 character)
+{
+    if (character > 0xff || start >= length)
+        return offsetNoMatch;
+    const void* found = memchr(input + start, character, length - start);
+    return found ? static_cast<const LChar*>(found) - input : offsetNoMatch;
+}
+
+static unsigned findCharacter(const UChar* input, unsigned length, unsigned start, UChar32 character)
+{
+    for (unsigned i = start; i < length; ++i) {
+        if (input[i] == character)
+            return i;
+    }
+    return offsetNoMatch;
+}
+
+static bool holdsThread(PikeVMInstruction::Opcode opcode)
+{
+    switch (opcode) {
+    case PikeVMInstruction::Character:
+    case PikeVMInstruction::CasedCharacter:
+    case PikeVMInstruction::Class:
+    case PikeVMInstruction::Match:
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct PikeVMThreadList {
+    PikeVMThreadList(unsigned instructionCount, unsigned threadCount, unsigned slotCount)
+    {
+        dense.fill(0, instructionCount);
+        sparse.fill(0, instructionCount);
+        threads.reserveInitialCapacity(threadCount);
+        captures.fill(offsetNoMatch, threadCount * slotCount);
+    }
+
+    bool contains(unsigned pc) const
+    {
+        unsigned index = sparse[pc];
+        return index < size && dense[index] == pc;
+    }
+
+    void add(unsigned pc)
+    {
+        sparse[pc] = size;
+        dense[size++] = pc;
+    }
+
+    void clear()
+    {
+        size = 0;
+        threads.shrink(0);
+    }
+
+    unsigned* capturesFor(unsigned threadIndex, unsigned slotCount) { return captures.data() + threadIndex * slotCount; }
+
+    // Every program counter visited at this position, and the usual sparse set index
+    // into them. threads holds the ones waiting for input, in priority order.
+    Vector<unsigned> dense;
+    Vector<unsigned> sparse;
+    Vector<unsigned> threads;
+    Vector<unsigned> captures;
+    unsigned size { 0 };
+};
+
+struct PikeVMMatchState {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    PikeVMMatchState(unsigned instructionCount, unsigned threadCount, unsigned slotCount)
+        : first(instructionCount, threadCount, slotCount)
+        , second(instructionCount, threadCount, slotCount)
+    {
+    }
+
+    size_t sizeInBytes() const
+    {
+        return 2 * (first.dense.capacity() + first.sparse.capacity() + first.threads.capacity() + first.captures.capacity()) * sizeof(unsigned);
+    }
+
+    PikeVMThreadList first;
+    PikeVMThreadList second;
+};
+
+PikeVMPattern::PikeVMPattern(YarrPattern& pattern, Vector<PikeVMInstruction>&& instructions)
+    : m_instructions(WTFMove(instructions))
+    , m_numSubpatterns(pattern.m_numSubpatterns)
+    , m_multiline(pattern.m_multiline)
+{
+    m_instructions.shrinkToFit();
+
+    m_threadIndex.fill(0, m_instructions.size());
+    for (unsigned pc = 0; pc < m_instructions.size(); ++pc) {
+        if (holdsThread(m_instructions[pc].opcode))
+            m_threadIndex[pc] = m_threadCount++;
+    }
+
+    newlineCharacterClass = pattern.newlineCharacterClass();
+    wordcharCharacterClass = pattern.wordcharCharacterClass();
+
+    m_userCharacterClasses.swap(pattern.m_userCharacterClasses);
+    m_userCharacterClasses.shrinkToFit();
+}
+
+PikeVMPattern::~PikeVMPattern()
+{
+}
+
+size_t PikeVMPattern::estimatedSizeInBytes() const
+{
+    size_t size = m_instructions.capacity() * sizeof(PikeVMInstruction);
+    if (m_matchState)
+        size += m_matchState->sizeInBytes();
+    return size;
+}
+
+class PikeVMCompiler {
+public:
+    PikeVMCompiler(YarrPattern& pattern)
+        : m_pattern(pattern)
+    {
+    }
+
+    std::unique_ptr<PikeVMPattern> compile()
+    {
+        if (m_pattern.m_containsBackreferences || m_pattern.m_unicode || m_pattern.containsUnsignedLengthPattern())
+            return nullptr;
+
+        // optimizeBOL() marks the original alternatives as once-through and appends copies of
+        // those that do not start with ^ for later start positions. Every start position runs
+        // the same program here, so the copies would only be lower priority duplicates.
+        Vector<std::unique_ptr<PatternAlternative>>& alternatives = m_pattern.m_body->m_alternatives;
+        bool onceThrough = alternatives[0]->onceThrough();
+        for (unsigned alt = 0; alt < alternatives.size(); ++alt) {
+            if (!onceThrough || alternatives[alt]->onceThrough())
+                m_bodyAlternatives.append(alternatives[alt].get());
+        }
+
+        emitSave(0);
+        if (!emitAlternatives(m_bodyAlternatives))
+            return nullptr;
+        emitSave(1);
+        emit(PikeVMInstruction::Match);
+
+        // Check the capture table size before PikeVMPattern takes the character classes.
+        unsigned threadCount = 0;
+        for (const PikeVMInstruction& instruction : m_instructions)
+            threadCount += holdsThread(instruction.opcode);
+        unsigned slotCount = (m_pattern.m_numSubpatterns + 1) * 2;
+        if (slotCount > maximumCaptureTableSize || threadCount > maximumCaptureTableSize / slotCount)
+            return nullptr;
+
+        auto result = std::make_unique<PikeVMPattern>(m_pattern, WTFMove(m_instructions));
+        result->m_dotStarEnclosure = m_dotStarEnclosure;
+        computeAnchoring(*result);
+        computePrefilters(*result);
+        computeStartSet(*result);
+        return result;
+    }
+
+private:
+    unsigned emit(PikeVMInstruction::Opcode opcode)
+    {
+        m_instructions.append(PikeVMInstruction(opcode));
+        return m_instructions.size() - 1;
+    }
+
+    void emitSave(unsigned slot)
+    {
+        m_instructions[emit(PikeVMInstruction::Save)].slot = slot;
+    }
+
+    bool emitAlternatives(const Vector<PatternAlternative*>& alternatives)
+    {
+        Vector<unsigned> jumpsToEnd;
+        for (unsigned alt = 0; alt < alternatives.size(); ++alt) {
+            unsigned split = 0;
+            bool isLast = alt == alternatives.size() - 1;
+            if (!isLast) {
+                split = emit(PikeVMInstruction::Split);
+                m_instructions[split].target = split + 1;
+            }
+
+            Vector<PatternTerm>& terms = alternatives[alt]->m_terms;
+            for (unsigned i = 0; i < terms.size(); ++i) {
+                if (!emitTerm(terms[i]))
+                    return false;
+            }
+
+            if (!isLast) {
+                jumpsToEnd.append(emit(PikeVMInstruction::Jump));
+                m_instructions[split].alternate = m_instructions.size();
+            }
+        }
+
+        for (unsigned jump : jumpsToEnd)
+            m_instructions[jump].target = m_instructions.size();
+        return m_instructions.size() <= maximumInstructionCount;
+    }
+
+    bool emitDisjunction(PatternDisjunction* disjunction)
+    {
+        Vector<PatternAlternative*> alternatives;
+        for (unsigned alt = 0; alt < disjunction->m_alternatives.size(); ++alt)
+            alternatives.append(disjunction->m_alternatives[alt].get());
+        return emitAlternatives(alternatives);
+    }
+
+    void emitAtom(PatternTerm& term)
+    {
+        if (term.type == PatternTerm::TypeCharacterClass) {
+            PikeVMInstruction& instruction = m_instructions[emit(PikeVMInstruction::Class)];
+            instruction.characterClass = term.characterClass;
+            instruction.invert = term.invert();
+            return;
+        }
+
+        // Same case folding as the interpreter's atomPatternCharacter().
+        UChar32 ch = term.patternCharacter;
+        if (m_pattern.m_ignoreCase) {
+            UChar32 lo = u_tolower(ch);
+            UChar32 hi = u_toupper(ch);
+            if (lo != hi) {
+                PikeVMInstruction& instruction = m_instructions[emit(PikeVMInstruction::CasedCharacter)];
+                instruction.character = lo;
+                instruction.otherCase = hi;
+                return;
+            }
+        }
+        m_instructions[emit(PikeVMInstruction::Character)].character = ch;
+    }
+
+    bool emitParenthesesIteration(PatternTerm& term, bool clearCaptures)
+    {
+        unsigned firstSubpattern = term.parentheses.subpatternId;
+        unsigned lastSubpattern = term.parentheses.lastSubpatternId;
+        if (clearCaptures && lastSubpattern >= firstSubpattern) {
+            PikeVMInstruction& instruction = m_instructions[emit(PikeVMInstruction::ClearCaptures)];
+            instruction.slot = firstSubpattern * 2;
+            instruction.lastSlot = (lastSubpattern + 1) * 2;
+        }
+
+        if (term.capture())
+            emitSave(firstSubpattern * 2);
+        if (!emitDisjunction(term.parentheses.disjunction))
+            return false;
+        if (term.capture())
+            emitSave(firstSubpattern * 2 + 1);
+        return true;
+    }
+
+    template<typename EmitIteration>
+    bool emitQuantified(PatternTerm& term, const EmitIteration& emitIteration)
+    {
+        unsigned count = term.quantityCount.unsafeGet();
+
+        if (term.quantityType == QuantifierFixedCount) {
+            for (unsigned i = 0; i < count; ++i) {
+                if (!emitIteration() || m_instructions.size() > maximumInstructionCount)
+                    return false;
+            }
+            return true;
+        }
+
+        bool greedy = term.quantityType == QuantifierGreedy;
+        if (count == quantifyInfinite) {
+            unsigned split = emit(PikeVMInstruction::Split);
+            if (!emitIteration())
+                return false;
+            m_instructions[emit(PikeVMInstruction::Jump)].target = split;
+            m_instructions[split].target = greedy ? split + 1 : m_instructions.size();
+            m_instructions[split].alternate = greedy ? m_instructions.size() : split + 1;
+            return true;
+        }
+
+        Vector<unsigned> splits;
+        for (unsigned i = 0; i < count; ++i) {
+            splits.append(emit(PikeVMInstruction::Split));
+            if (!emitIteration() || m_instructions.size() > maximumInstructionCount)
+                return false;
+        }
+        for (unsigned split : splits) {
+            m_instructions[split].target = greedy ? split + 1 : m_instructions.size();
+            m_instructions[split].alternate = greedy ? m_instructions.size() : split + 1;
+        }
+        return true;
+    }
+
+    bool emitTerm(PatternTerm& term)
+    {
+        switch (term.type) {
+        case PatternTerm::TypeAssertionBOL:
+            emit(PikeVMInstruction::AssertionBOL);
+            return true;
+
+        case PatternTerm::TypeAssertionEOL:
+            emit(PikeVMInstruction::AssertionEOL);
+            return true;
+
+        case PatternTerm::TypeAssertionWordBoundary:
+            m_instructions[emit(PikeVMInstruction::AssertionWordBoundary)].invert = term.invert();
+            return true;
+
+        case PatternTerm::TypePatternCharacter:
+        case PatternTerm::TypeCharacterClass:
+            return emitQuantified(term, [&] {
+                emitAtom(term);
+                return true;
+            });
+
+        case PatternTerm::TypeParenthesesSubpattern: {
+            // ES6 21.2.2.5.1 rejects an optional iteration that consumes nothing. Threads are
+            // merged by program counter alone, so that check cannot be made here; only accept
+            // quantified groups that always consume input.
+            if (term.quantityType != QuantifierFixedCount && !term.parentheses.disjunction->m_minimumSize)
+                return false;
+            // Captures inside a quantified group are reset at the start of every iteration.
+            bool clearCaptures = term.quantityType != QuantifierFixedCount || term.quantityCount.unsafeGet() != 1 || term.parentheses.isCopy;
+            return emitQuantified(term, [&] {
+                return emitParenthesesIteration(term, clearCaptures);
+            });
+        }
+
+        case PatternTerm::TypeDotStarEnclosure:
+            // The anchored forms can fail after the expression matched and make the interpreter
+            // move on to the next start position; leave those to the interpreter.
+            if ((term.anchors.bolAnchor || term.anchors.eolAnchor) && !m_pattern.m_multiline)
+                return false;
+            m_dotStarEnclosure = true;
+            return true;
+
+        case PatternTerm::TypeBackReference:
+        case PatternTerm::TypeForwardReference:
+        case PatternTerm::TypeParentheticalAssertion:
+            return false;
+        }
+
+        RELEASE_ASSERT_NOT_REACHED();
+        return false;
+    }
+
+    void computeAnchoring(PikeVMPattern& result)
+    {
+        // m_startsWithBOL is also set for /(^a)*b/, so look for a leading ^ term instead.
+        if (m_pattern.m_multiline)
+            return;
+        for (PatternAlternative* alternative : m_bodyAlternatives) {
+            if (alternative->m_terms.isEmpty() || alternative->m_terms[0].type != PatternTerm::TypeAssertionBOL)
+                return;
+        }
+        result.m_anchored = true;
+    }
+
+    static PatternTerm* firstConsumingTerm(PatternAlternative* alternative)
+    {
+        for (PatternTerm& term : alternative->m_terms) {
+            switch (term.type) {
+            case PatternTerm::TypeAssertionBOL:
+            case PatternTerm::TypeAssertionEOL:
+            case PatternTerm::TypeAssertionWordBoundary:
+                continue;
+            default:
+                return &term;
+            }
+        }
+        return nullptr;
+    }
+
+    bool isLiteral(PatternTerm* term)
+    {
+        return term
+            && term->type == PatternTerm::TypePatternCharacter
+            && term->quantityType == QuantifierFixedCount
+            && isCaseInvariant(m_pattern, term->patternCharacter);
+    }
+
+    void computePrefilters(PikeVMPattern& result)
+    {
+        for (unsigned alt = 0; alt < m_bodyAlternatives.size(); ++alt) {
+            PatternTerm* term = firstConsumingTerm(m_bodyAlternatives[alt]);
+            if (!isLiteral(term) || (alt && term->patternCharacter != result.m_firstCharacter)) {
+                result.m_hasFirstCharacter = false;
+                break;
+            }
+            result.m_hasFirstCharacter = true;
+            result.m_firstCharacter = term->patternCharacter;
+        }
+
+        if (m_bodyAlternatives.size() != 1)
+            return;
+
+        // Prefer the last literal: for /key=.*;/ the ';' says more about the subject than the 'k'.
+        Vector<PatternTerm>& terms = m_bodyAlternatives[0]->m_terms;
+        for (unsigned i = terms.size(); i--;) {
+            if (!isLiteral(&terms[i]))
+                continue;
+            if (result.m_hasFirstCharacter && terms[i].patternCharacter == result.m_firstCharacter)
+                return;
+            result.m_hasRequiredCharacter = true;
+            result.m_requiredCharacter = terms[i].patternCharacter;
+            return;
+        }
+    }
+
+    // Collects the code units the first consuming instruction of a match can accept,
+    // treating assertions as passing. Not useful if a match can be empty.
+    static void computeStartSet(PikeVMPattern& result)
+    {
+        const Vector<PikeVMInstruction>& instructions = result.m_instructions;
+        Vector<bool> visited;
+        visited.fill(false, instructions.size());
+        Vector<unsigned> worklist;
+        worklist.append(0);
+        while (!worklist.isEmpty()) {
+            unsigned pc = worklist.takeLast();
+            if (visited[pc])
+                continue;
+            visited[pc] = true;
+
+            const PikeVMInstruction& instruction = instructions[pc];
+            switch (instruction.opcode) {
+            case PikeVMInstruction::Character:
+            case PikeVMInstruction::CasedCharacter:
+                addToStartSet(result, instruction.character);
+                if (instruction.opcode == PikeVMInstruction::CasedCharacter)
+                    addToStartSet(result, instruction.otherCase);
+                break;
+            case PikeVMInstruction::Class:
+                for (UChar32 ch = 0; ch < 256; ++ch) {
+                    if (testCharacterClass(instruction.characterClass, ch) != instruction.invert)
+                        result.m_startSet.set(ch);
+                }
+                if (instruction.invert || classHasNonLatin1(instruction.characterClass))
+                    result.m_startSetHasNonLatin1 = true;
+                break;
+            case PikeVMInstruction::Match:
+                return;
+            case PikeVMInstruction::Split:
+                worklist.append(instruction.alternate);
+                worklist.append(instruction.target);
+                break;
+            case PikeVMInstruction::Jump:
+                worklist.append(instruction.target);
+                break;
+            default:
+                worklist.append(pc + 1);
+                break;
+            }
+        }
+        result.m_hasStartSet = true;
+    }
+
+    static void addToStartSet(PikeVMPattern& result, UChar32 ch)
+    {
+        if (ch < 256)
+            result.m_startSet.set(ch);
+        else
+            result.m_startSetHasNonLatin1 = true;
+    }
+
+    static bool classHasNonLatin1(CharacterClass* characterClass)
+    {
+        for (UChar32 ch : characterClass->m_matchesUnicode) {
+            if (ch > 0xff)
+                return true;
+        }
+        for (const CharacterRange& range : characterClass->m_rangesUnicode) {
+            if (range.end > 0xff)
+                return true;
+        }
+        return false;
+    }
+
+    YarrPattern& m_pattern;
+    Vector<PatternAlternative*> m_bodyAlternatives;
+    Vector<PikeVMInstruction> m_instructions;
+    bool m_dotStarEnclosure { false };
+};
+
+template<typename CharType>
+class PikeVM {
+public:
+    PikeVM(PikeVMPattern* pattern, PikeVMMatchState& state, const CharType* input, unsigned length, unsigned* output)
+        : m_pattern(pattern)
+        , m_instructions(pattern->m_instructions)
+        , m_input(input)
+        , m_length(length)
+        , m_output(output)
+        , m_slotCount((pattern->m_numSubpatterns + 1) * 2)
+        , m_first(state.first)
+        , m_second(state.second)
+    {
+        m_first.clear();
+        m_second.clear();
+        m_scratch.fill(offsetNoMatch, m_slotCount);
+    }
+
+    unsigned match(unsigned start)
+    {
+        for (unsigned i = 0; i < m_slotCount; ++i)
+            m_output[i] = offsetNoMatch;
+
+        if (start > m_length)
+            return offsetNoMatch;
+        if (m_pattern->m_hasRequiredCharacter && findCharacter(m_input, m_length, start, m_pattern->m_requiredCharacter) == offsetNoMatch)
+            return offsetNoMatch;
+
+        PikeVMThreadList* current = &m_first;
+        PikeVMThreadList* next = &m_second;
+        bool matched = false;
+
+        for (unsigned pos = start; ; ++pos) {
+            // New start positions have the lowest priority, and are only worth trying while
+            // nothing to the left has matched yet.
+            if (!matched && (!m_pattern->m_anchored || pos == start)) {
+                if (current->threads.isEmpty() && !m_pattern->m_anchored) {
+                    // Nothing is alive, so the dead ends recorded for this position can be dropped.
+                    current->clear();
+                    pos = skipToPossibleStart(pos);
+                    if (pos == offsetNoMatch)
+                        break;
+                }
+                for (unsigned i = 0; i < m_slotCount; ++i)
+                    m_scratch[i] = offsetNoMatch;
+                addThread(*current, 0, pos);
+            }
+
+            if (current->threads.isEmpty()) {
+                if (matched || m_pattern->m_anchored || pos >= m_length)
+                    break;
+                current->clear();
+                continue;
+            }
+
+            next->clear();
+            int ch = pos < m_length ? m_input[pos] : -1;
+            for (unsigned pc : current->threads) {
+                const PikeVMInstruction& instruction = m_instructions[pc];
+                bool advance = false;
+
+                switch (instruction.opcode) {
+                case PikeVMInstruction::Character:
+                    advance = ch == instruction.character;
+                    break;
+                case PikeVMInstruction::CasedCharacter:
+                    advance = ch == instruction.character || ch == instruction.otherCase;
+                    break;
+                case PikeVMInstruction::Class:
+                    advance = ch != -1 && testCharacterClass(instruction.characterClass, ch) != instruction.invert;
+                    break;
+                case PikeVMInstruction::Match:
+                    memcpy(m_output, current->capturesFor(m_pattern->m_threadIndex[pc], m_slotCount), m_slotCount * sizeof(unsigned));
+                    matched = true;
+                    break;
+                default:
+                    RELEASE_ASSERT_NOT_REACHED();
+                    break;
+                }
+
+                // Everything after a match in the list has lower priority and can only lose.
+                if (instruction.opcode == PikeVMInstruction::Match)
+                    break;
+
+                if (advance) {
+                    memcpy(m_scratch.data(), current->capturesFor(m_pattern->m_threadIndex[pc], m_slotCount), m_slotCount * sizeof(unsigned));
+                    addThread(*next, pc + 1, pos + 1);
+                }
+            }
+
+            if (pos == m_length)
+                break;
+            std::swap(current, next);
+        }
+
+        if (!matched)
+            return offsetNoMatch;
+
+        if (m_pattern->m_dotStarEnclosure)
+            expandDotStarEnclosure();
+        return m_output[0];
+    }
+
+private:
+    struct StackEntry {
+        static StackEntry explore(unsigned pc) { return { pc, 0, 0, false }; }
+        static StackEntry restore(unsigned slot, unsigned value) { return { 0, slot, value, true }; }
+
+        unsigned pc;
+        unsigned slot;
+        unsigned value;
+        bool isRestore;
+    };
+
+    bool isNewline(unsigned pos) { return testCharacterClass(m_pattern->newlineCharacterClass, m_input[pos]); }
+    bool isWordchar(unsigned pos) { return testCharacterClass(m_pattern->wordcharCharacterClass, m_input[pos]); }
+
+    bool matchAssertionBOL(unsigned pos)
+    {
+        return !pos || (m_pattern->m_multiline && isNewline(pos - 1));
+    }
+
+    bool matchAssertionEOL(unsigned pos)
+    {
+        return pos == m_length || (m_pattern->m_multiline && isNewline(pos));
+    }
+
+    bool matchAssertionWordBoundary(const PikeVMInstruction& instruction, unsigned pos)
+    {
+        bool prevIsWordchar = pos && isWordchar(pos - 1);
+        bool readIsWordchar = pos < m_length && isWordchar(pos);
+        bool wordBoundary = prevIsWordchar != readIsWordchar;
+        return instruction.invert ? !wordBoundary : wordBoundary;
+    }
+
+    // Follows the epsilon transitions from pc at pos, in priority order, starting with
+    // the captures in m_scratch. Every instruction reached is recorded in list; the
+    // ones that wait for input (or report a match) also get a copy of the captures.
+    void addThread(PikeVMThreadList& list, unsigned startPC, unsigned pos)
+    {
+        m_stack.append(StackEntry::explore(startPC));
+        while (!m_stack.isEmpty()) {
+            StackEntry entry = m_stack.takeLast();
+            if (entry.isRestore) {
+                m_scratch[entry.slot] = entry.value;
+                continue;
+            }
+
+            unsigned pc = entry.pc;
+            while (!list.contains(pc)) {
+                list.add(pc);
+                const PikeVMInstruction& instruction = m_instructions[pc];
+
+                switch (instruction.opcode) {
+                case PikeVMInstruction::Jump:
+                    pc = instruction.target;
+                    continue;
+                case PikeVMInstruction::Split:
+                    m_stack.append(StackEntry::explore(instruction.alternate));
+                    pc = instruction.target;
+                    continue;
+                case PikeVMInstruction::Save:
+                    m_stack.append(StackEntry::restore(instruction.slot, m_scratch[instruction.slot]));
+                    m_scratch[instruction.slot] = pos;
+                    ++pc;
+                    continue;
+                case PikeVMInstruction::ClearCaptures:
+                    for (unsigned slot = instruction.slot; slot < instruction.lastSlot; ++slot) {
+                        m_stack.append(StackEntry::restore(slot, m_scratch[slot]));
+                        m_scratch[slot] = offsetNoMatch;
+                    }
+                    ++pc;
+                    continue;
+                case PikeVMInstruction::AssertionBOL:
+                    if (!matchAssertionBOL(pos))
+                        break;
+                    ++pc;
+                    continue;
+                case PikeVMInstruction::AssertionEOL:
+                    if (!matchAssertionEOL(pos))
+                        break;
+                    ++pc;
+                    continue;
+                case PikeVMInstruction::AssertionWordBoundary:
+                    if (!matchAssertionWordBoundary(instruction, pos))
+                        break;
+                    ++pc;
+                    continue;
+                case PikeVMInstruction::Character:
+                case PikeVMInstruction::CasedCharacter:
+                case PikeVMInstruction::Class:
+                case PikeVMInstruction::Match:
+                    memcpy(list.capturesFor(m_pattern->m_threadIndex[pc], m_slotCount), m_scratch.data(), m_slotCount * sizeof(unsigned));
+                    list.threads.uncheckedAppend(pc);
+                    break;
+                }
+                break;
+            }
+        }
+    }
+
+    unsigned skipToPossibleStart(unsigned pos)
+    {
+        if (m_pattern->m_hasFirstCharacter)
+            return findCharacter(m_input, m_length, pos, m_pattern->m_firstCharacter);
+        if (!m_pattern->m_hasStartSet)
+            return pos;
+        for (; pos < m_length; ++pos) {
+            CharType ch = m_input[pos];
+            if (ch < 256 ? m_pattern->m_startSet.get(ch) : m_pattern->m_startSetHasNonLatin1)
+                return pos;
+        }
+        return offsetNoMatch;
+    }
+
+    // Same widening as the interpreter's matchDotStarEnclosure(), for the unanchored form.
+    void expandDotStarEnclosure()
+    {
+        unsigned matchBegin = m_output[0];
+        while (matchBegin && !isNewline(matchBegin - 1))
+            --matchBegin;
+
+        unsigned matchEnd = m_output[1];
+        while (matchEnd != m_length && !isNewline(matchEnd))
+            ++matchEnd;
+
+        m_output[0] = matchBegin;
+        m_output[1] = matchEnd;
+    }
+
+    PikeVMPattern* m_pattern;
+    const Vector<PikeVMInstruction>& m_instructions;
+    const CharType* m_input;
+    unsigned m_length;
+    unsigned* m_output;
+    unsigned m_slotCount;
+    PikeVMThreadList& m_first;
+    PikeVMThreadList& m_second;
+    Vector<unsigned, 16> m_scratch;
+    Vector<StackEntry, 32> m_stack;
+};
+
+std::unique_ptr<PikeVMPattern> pikeVMCompile(YarrPattern& pattern)
+{
+    return PikeVMCompiler(pattern).compile();
+}
+
+unsigned pikeVMInterpret(PikeVMPattern* pattern, const String& input, unsigned start, unsigned* output)
+{
+    if (!pattern->m_matchState)
+        pattern->m_matchState = std::make_unique<PikeVMMatchState>(pattern->m_instructions.size(), pattern->m_threadCount, (pattern->m_numSubpatterns + 1) * 2);
+    PikeVMMatchState& state = *pattern->m_matchState;
+
+    if (input.is8Bit())
+        return PikeVM<LChar>(pattern, state, input.characters8(), input.length(), output).match(start);
+    return PikeVM<UChar>(pattern, state, input.characters16(), input.length(), output).match(start);
+}
+
+} } // namespace JSC::Yarr
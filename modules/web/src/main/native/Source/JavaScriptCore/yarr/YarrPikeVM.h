@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef YarrPikeVM_h
+#define YarrPikeVM_h
+
+#include "YarrPattern.h"
+#include <wtf/Bitmap.h>
+#include <wtf/Vector.h>
+
+namespace JSC { namespace Yarr {
+
+// A Pike VM runs every alternative of a pattern in lock step over the input, so
+// matching takes time proportional to the input length times the program size
+// no matter how the pattern is written. Threads are kept in priority order which
+// gives the same leftmost, backtracking-order result (including captures) as the
+// interpreter. Only patterns without backreferences, lookaround, unicode mode or
+// quantified groups that can match the empty string are compiled; pikeVMCompile()
+// returns nullptr for anything else and the caller falls back to byteCompile().
+
+struct PikeVMInstruction {
+    enum Opcode : uint8_t {
+        Character,
+        CasedCharacter,
+        Class,
+        Split,
+        Jump,
+        Save,
+        ClearCaptures,
+        AssertionBOL,
+        AssertionEOL,
+        AssertionWordBoundary,
+        Match,
+    };
+
+    PikeVMInstruction(Opcode opcode)
+        : opcode(opcode)
+    {
+    }
+
+    Opcode opcode;
+    bool invert { false };
+    UChar32 character { 0 };
+    UChar32 otherCase { 0 };
+    CharacterClass* characterClass { nullptr };
+    // Split prefers target over alternate; Jump only uses target.
+    unsigned target { 0 };
+    unsigned alternate { 0 };
+    // Save writes slot; ClearCaptures resets slots [slot, lastSlot).
+    unsigned slot { 0 };
+    unsigned lastSlot { 0 };
+};
+
+struct PikeVMMatchState;
+
+struct PikeVMPattern {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    PikeVMPattern(YarrPattern&, Vector<PikeVMInstruction>&&);
+    ~PikeVMPattern();
+
+    size_t estimatedSizeInBytes() const;
+
+    Vector<PikeVMInstruction> m_instructions;
+    // Maps instructions that consume input or report a match to their row in the
+    // per-match capture table; the other instructions never hold a thread.
+    Vector<unsigned> m_threadIndex;
+    unsigned m_threadCount { 0 };
+    // The thread lists and their capture tables, sized for this program, allocated by
+    // the first match and reused by every later one.
+    std::unique_ptr<PikeVMMatchState> m_matchState;
+    unsigned m_numSubpatterns;
+    bool m_multiline;
+    // Every alternative starts with ^ outside multiline mode, so only the start offset can match.
+    bool m_anchored { false };
+    // The pattern was /.*expr.*/ and the matched range is widened to the enclosing line.
+    bool m_dotStarEnclosure { false };
+
+    // Prefilters run before and between VM steps. m_firstCharacter must start every
+    // match; m_requiredCharacter must occur somewhere in it.
+    bool m_hasFirstCharacter { false };
+    bool m_hasRequiredCharacter { false };
+    UChar32 m_firstCharacter { 0 };
+    UChar32 m_requiredCharacter { 0 };
+    // Otherwise, the code units a match can start with, when no match can be empty.
+    bool m_hasStartSet { false };
+    bool m_startSetHasNonLatin1 { false };
+    WTF::Bitmap<256> m_startSet;
+
+    CharacterClass* newlineCharacterClass;
+    CharacterClass* wordcharCharacterClass;
+
+private:
+    Vector<std::unique_ptr<CharacterClass>> m_userCharacterClasses;
+};
+
+JS_EXPORT_PRIVATE std::unique_ptr<PikeVMPattern> pikeVMCompile(YarrPattern&);
+JS_EXPORT_PRIVATE unsigned pikeVMInterpret(PikeVMPattern*, const String& input, unsigned start, unsigned* output);
+
+} } // namespace JSC::Yarr
+
+#endif // YarrPikeVM_h
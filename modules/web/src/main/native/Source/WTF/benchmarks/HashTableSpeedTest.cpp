@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// On Mac, you can build this like so:
+// clang++ -o HashTableSpeedTest Source/WTF/benchmarks/HashTableSpeedTest.cpp -O3 -W -ISource/WTF -LWebKitBuild/Release -lWTF -framework Foundation -licucore -std=c++11
+
+#include "config.h"
+
+#include <wtf/CurrentTime.h>
+#include <wtf/HashSet.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/SwissHashTable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace {
+
+template<typename T> struct SwissTraits : HashTraits<T> {
+    static const bool useSwissTable = true;
+};
+
+unsigned numKeys;
+unsigned numIterations;
+
+NO_RETURN void usage()
+{
+    printf("Usage: HashTableSpeedTest int|pointer|string|all <num keys> <num iterations>\n");
+    exit(1);
+}
+
+template<typename SetType, typename KeyType>
+void runBenchmark(const char* name, const Vector<KeyType>& keys, const Vector<KeyType>& missingKeys)
+{
+    double insertTime = 0;
+    double hitTime = 0;
+    double missTime = 0;
+    double iterateTime = 0;
+    double eraseTime = 0;
+    unsigned found = 0;
+
+    for (unsigned iteration = numIterations; iteration--;) {
+        SetType set;
+
+        double before = monotonicallyIncreasingTimeMS();
+        for (const KeyType& key : keys)
+            set.add(key);
+        double afterInsert = monotonicallyIncreasingTimeMS();
+        for (const KeyType& key : keys)
+            found += set.contains(key);
+        double afterHit = monotonicallyIncreasingTimeMS();
+        for (const KeyType& key : missingKeys)
+            found += set.contains(key);
+        double afterMiss = monotonicallyIncreasingTimeMS();
+        for (auto& key : set)
+            found += !!&key;
+        double afterIterate = monotonicallyIncreasingTimeMS();
+        for (const KeyType& key : keys)
+            set.remove(key);
+        double afterErase = monotonicallyIncreasingTimeMS();
+
+        insertTime += afterInsert - before;
+        hitTime += afterHit - afterInsert;
+        missTime += afterMiss - afterHit;
+        iterateTime += afterIterate - afterMiss;
+        eraseTime += afterErase - afterIterate;
+    }
+
+    printf("%s: insert %.3lf ms, hit %.3lf ms, miss %.3lf ms, iterate %.3lf ms, erase %.3lf ms (%u).\n",
+        name, insertTime, hitTime, missTime, iterateTime, eraseTime, found);
+}
+
+template<typename KeyType>
+void runBenchmarks(const char* name, const Vector<KeyType>& keys, const Vector<KeyType>& missingKeys)
+{
+    typedef typename DefaultHash<KeyType>::Hash Hash;
+    printf("%s keys\n", name);
+    runBenchmark<HashSet<KeyType, Hash>>("    HashTable", keys, missingKeys);
+    runBenchmark<HashSet<KeyType, Hash, SwissTraits<KeyType>>>("    SwissHashTable", keys, missingKeys);
+}
+
+unsigned randomNumber(unsigned& seed)
+{
+    seed = seed * 1664525 + 1013904223;
+    return seed;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    WTF::initializeThreading();
+
+    if (argc != 4
+        || sscanf(argv[2], "%u", &numKeys) != 1
+        || sscanf(argv[3], "%u", &numIterations) != 1)
+        usage();
+
+    bool didRun = false;
+    unsigned seed = 1;
+    if (!strcmp(argv[1], "int") || !strcmp(argv[1], "all")) {
+        Vector<int> keys;
+        Vector<int> missingKeys;
+        for (unsigned i = 0; i < numKeys; ++i) {
+            // Odd keys are present and even ones missing. Both stay positive, away from
+            // 0 and -1, the empty and deleted values of HashTraits<int>.
+            keys.append((randomNumber(seed) % 0x3fffffff) * 2 + 1);
+            missingKeys.append((randomNumber(seed) % 0x3fffffff) * 2 + 2);
+        }
+        runBenchmarks("int", keys, missingKeys);
+        didRun = true;
+    }
+    if (!strcmp(argv[1], "pointer") || !strcmp(argv[1], "all")) {
+        Vector<std::unique_ptr<int>> objects;
+        Vector<int*> keys;
+        Vector<int*> missingKeys;
+        for (unsigned i = 0; i < numKeys * 2; ++i) {
+            objects.append(std::make_unique<int>(i));
+            (i % 2 ? keys : missingKeys).append(objects.last().get());
+        }
+        runBenchmarks("pointer", keys, missingKeys);
+        didRun = true;
+    }
+    if (!strcmp(argv[1], "string") || !strcmp(argv[1], "all")) {
+        Vector<String> keys;
+        Vector<String> missingKeys;
+        for (unsigned i = 0; i < numKeys; ++i) {
+            keys.append(String::format("key-%u", randomNumber(seed)));
+            missingKeys.append(String::format("missing-%u", randomNumber(seed)));
+        }
+        runBenchmarks("String", keys, missingKeys);
+        didRun = true;
+    }
+
+    if (!didRun)
+        usage();
+
+    return 0;
+}
@@ -57,7 +57,7 @@ private:
 
     typedef HashArg HashFunctions;
 
-    typedef HashTable<KeyType, KeyValuePairType, KeyValuePairKeyExtractor<KeyValuePairType>,
+    typedef HashTableForTraits<KeyType, KeyValuePairType, KeyValuePairKeyExtractor<KeyValuePairType>,
         HashFunctions, KeyValuePairTraits, KeyTraits> HashTableType;
 
     class HashMapKeysProxy;
@@ -43,7 +43,7 @@ namespace WTF {
         typedef typename ValueTraits::TraitType ValueType;
 
     private:
-        typedef HashTable<ValueType, ValueType, IdentityExtractor,
+        typedef HashTableForTraits<ValueType, ValueType, IdentityExtractor,
             HashFunctions, ValueTraits, ValueTraits> HashTableType;
 
     public:
@@ -1526,6 +1526,24 @@ namespace WTF {
         return a.m_impl != b.m_impl;
     }
 
+    // Tells whether a traits class opted in with a static useSwissTable member.
+    template<typename Traits> class HashTraitsUseSwissTable {
+        template<typename T> static std::integral_constant<bool, T::useSwissTable> test(int);
+        template<typename T> static std::false_type test(...);
+    public:
+        static const bool value = decltype(test<Traits>(0))::value;
+    };
+
+    // Defined in SwissHashTable.h, which the traits that opt in must include.
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    class SwissHashTable;
+
+    // The table HashSet and HashMap use for the given key traits.
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    using HashTableForTraits = typename std::conditional<HashTraitsUseSwissTable<KeyTraits>::value,
+        SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>,
+        HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>>::type;
+
 } // namespace WTF
 
 #include <wtf/HashIterators.h>
@@ -829,10 +829,14 @@
 /* The SamplingProfiler is the probabilistic and low-overhead profiler used by
  * JSC to measure where time is spent inside a JavaScript program.
  * In configurations other than Windows and Darwin, because layout of mcontext_t depends on standard libraries (like glibc),
- * sampling profiler is enabled if WebKit uses pthreads and glibc. */
+ * sampling profiler is enabled if WebKit uses pthreads and glibc.
+ * The Java port's C loop build reads the interpreter's frame and PC from the CLoop itself
+ * instead of from mcontext_t, so it does not need the JIT. */
 #if !defined(ENABLE_SAMPLING_PROFILER)
 #if (OS(DARWIN) || OS(WINDOWS) || PLATFORM(GTK) || PLATFORM(EFL)) && ENABLE(JIT)
 #define ENABLE_SAMPLING_PROFILER 1
+#elif PLATFORM(JAVA) && OS(LINUX) && ENABLE(LLINT_C_LOOP)
+#define ENABLE_SAMPLING_PROFILER 1
 #else
 #define ENABLE_SAMPLING_PROFILER 0
 #endif
@@ -0,0 +1,767 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WTF_SwissHashTable_h
+#define WTF_SwissHashTable_h
+
+#include <iterator>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include <wtf/Assertions.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/HashTable.h>
+#include <wtf/HashTraits.h>
+#include <wtf/MathExtras.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/ValueCheck.h>
+
+#if CPU(X86_64) || CPU(X86)
+#include <emmintrin.h>
+#endif
+
+#if COMPILER(MSVC)
+#include <intrin.h>
+#endif
+
+namespace WTF {
+
+// SwissHashTable is an alternative to HashTable with the same interface, which
+// HashSet and HashMap use instead when the key traits ask for it:
+//
+//     struct MyKeyTraits : HashTraits<MyKey> {
+//         static const bool useSwissTable = true;
+//     };
+//
+// HashTable.h only declares it, so code that opts in includes this header.
+//
+// Next to the buckets it keeps one control byte per bucket, holding either 7
+// bits of the key's hash or a marker for an empty or deleted bucket. Buckets
+// are probed 16 at a time: one SSE2 compare of the control bytes finds the
+// buckets whose key may match, so most lookups compare a single key and touch
+// a single cache line of control bytes, even in a table that is 7/8 full.
+//
+// Removing a key only leaves a tombstone when its group of 16 buckets has been
+// full since the last rehash, since only then may a probe have continued past
+// it. Buckets hold the empty value whether they are empty or deleted, so key
+// types do not need a deleted value that is cheap to test for.
+
+struct SwissHashTableControl {
+    static const int8_t empty = -128;
+    static const int8_t deleted = -2;
+    static const unsigned groupSize = 16;
+
+    static bool isFull(int8_t control) { return control >= 0; }
+
+    // Bits 25-31 of a multiplicative hash, so that they are not the bits that pick the group.
+    static int8_t tagForHash(unsigned hash) { return static_cast<int8_t>((hash * 0x9E3779B1U) >> 25); }
+};
+
+inline unsigned swissHashTableCountTrailingZeros(unsigned bits)
+{
+    ASSERT(bits);
+#if COMPILER(GCC_OR_CLANG)
+    return __builtin_ctz(bits);
+#elif COMPILER(MSVC)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return index;
+#else
+    unsigned count = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// The control bytes of 16 consecutive buckets. Each match function returns a
+// bitmask with bit i set when bucket i of the group matches.
+class SwissHashTableGroup {
+public:
+    explicit SwissHashTableGroup(const int8_t* control)
+#if CPU(X86_64) || CPU(X86)
+        : m_control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control)))
+#else
+        : m_control(control)
+#endif
+    {
+    }
+
+#if CPU(X86_64) || CPU(X86)
+    unsigned match(int8_t tag) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), m_control)); }
+    unsigned matchEmpty() const { return match(SwissHashTableControl::empty); }
+    // Empty and deleted are the only control bytes with the sign bit set.
+    unsigned matchEmptyOrDeleted() const { return _mm_movemask_epi8(m_control); }
+#else
+    unsigned match(int8_t tag) const
+    {
+        unsigned result = 0;
+        for (unsigned i = 0; i < SwissHashTableControl::groupSize; ++i)
+            result |= static_cast<unsigned>(m_control[i] == tag) << i;
+        return result;
+    }
+    unsigned matchEmpty() const { return match(SwissHashTableControl::empty); }
+    unsigned matchEmptyOrDeleted() const
+    {
+        unsigned result = 0;
+        for (unsigned i = 0; i < SwissHashTableControl::groupSize; ++i)
+            result |= static_cast<unsigned>(m_control[i] < 0) << i;
+        return result;
+    }
+#endif
+
+private:
+#if CPU(X86_64) || CPU(X86)
+    __m128i m_control;
+#else
+    const int8_t* m_control;
+#endif
+};
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+class SwissHashTableIterator;
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+class SwissHashTableConstIterator : public std::iterator<std::forward_iterator_tag, Value, std::ptrdiff_t, const Value*, const Value&> {
+private:
+    typedef SwissHashTableIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> iterator;
+    typedef SwissHashTableConstIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> const_iterator;
+    typedef Value ValueType;
+    typedef const ValueType& ReferenceType;
+    typedef const ValueType* PointerType;
+
+    friend class SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>;
+    friend class SwissHashTableIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>;
+
+    SwissHashTableConstIterator(PointerType position, const int8_t* control, PointerType endPosition)
+        : m_position(position)
+        , m_control(control)
+        , m_endPosition(endPosition)
+    {
+        skipEmptyBuckets();
+    }
+
+    SwissHashTableConstIterator(PointerType position, const int8_t* control, PointerType endPosition, HashItemKnownGoodTag)
+        : m_position(position)
+        , m_control(control)
+        , m_endPosition(endPosition)
+    {
+    }
+
+    void skipEmptyBuckets()
+    {
+        while (m_position != m_endPosition) {
+            if (SwissHashTableControl::isFull(*m_control))
+                return;
+            // Skip the rest of a group of empty buckets at once.
+            if (static_cast<size_t>(m_endPosition - m_position) >= SwissHashTableControl::groupSize
+                && SwissHashTableGroup(m_control).matchEmptyOrDeleted() == 0xFFFF) {
+                m_position += SwissHashTableControl::groupSize;
+                m_control += SwissHashTableControl::groupSize;
+                continue;
+            }
+            ++m_position;
+            ++m_control;
+        }
+    }
+
+public:
+    SwissHashTableConstIterator()
+        : m_position(nullptr)
+        , m_control(nullptr)
+        , m_endPosition(nullptr)
+    {
+    }
+
+    PointerType get() const { return m_position; }
+    ReferenceType operator*() const { return *get(); }
+    PointerType operator->() const { return get(); }
+
+    const_iterator& operator++()
+    {
+        ASSERT(m_position != m_endPosition);
+        ++m_position;
+        ++m_control;
+        skipEmptyBuckets();
+        return *this;
+    }
+
+    // postfix ++ intentionally omitted
+
+    bool operator==(const const_iterator& other) const { return m_position == other.m_position; }
+    bool operator!=(const const_iterator& other) const { return m_position != other.m_position; }
+    bool operator==(const iterator& other) const { return *this == static_cast<const_iterator>(other); }
+    bool operator!=(const iterator& other) const { return *this != static_cast<const_iterator>(other); }
+
+private:
+    PointerType m_position;
+    const int8_t* m_control;
+    PointerType m_endPosition;
+};
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+class SwissHashTableIterator : public std::iterator<std::forward_iterator_tag, Value, std::ptrdiff_t, Value*, Value&> {
+private:
+    typedef SwissHashTableIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> iterator;
+    typedef SwissHashTableConstIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> const_iterator;
+    typedef Value ValueType;
+    typedef ValueType& ReferenceType;
+    typedef ValueType* PointerType;
+
+    friend class SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>;
+
+    SwissHashTableIterator(PointerType position, const int8_t* control, PointerType end) : m_iterator(position, control, end) { }
+    SwissHashTableIterator(PointerType position, const int8_t* control, PointerType end, HashItemKnownGoodTag tag) : m_iterator(position, control, end, tag) { }
+
+public:
+    SwissHashTableIterator() { }
+
+    PointerType get() const { return const_cast<PointerType>(m_iterator.get()); }
+    ReferenceType operator*() const { return *get(); }
+    PointerType operator->() const { return get(); }
+
+    iterator& operator++() { ++m_iterator; return *this; }
+
+    // postfix ++ intentionally omitted
+
+    bool operator==(const iterator& other) const { return m_iterator == other.m_iterator; }
+    bool operator!=(const iterator& other) const { return m_iterator != other.m_iterator; }
+    bool operator==(const const_iterator& other) const { return m_iterator == other; }
+    bool operator!=(const const_iterator& other) const { return m_iterator != other; }
+
+    operator const_iterator() const { return m_iterator; }
+
+private:
+    const_iterator m_iterator;
+};
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+class SwissHashTable {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef SwissHashTableIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> iterator;
+    typedef SwissHashTableConstIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> const_iterator;
+    typedef Traits ValueTraits;
+    typedef Key KeyType;
+    typedef Value ValueType;
+    typedef IdentityHashTranslator<HashFunctions> IdentityTranslatorType;
+    typedef HashTableAddResult<iterator> AddResult;
+
+    SwissHashTable() { }
+    ~SwissHashTable()
+    {
+        if (m_table)
+            deallocateTable(m_table, m_tableSize);
+    }
+
+    SwissHashTable(const SwissHashTable&);
+    void swap(SwissHashTable&);
+    SwissHashTable& operator=(const SwissHashTable&);
+
+    SwissHashTable(SwissHashTable&&);
+    SwissHashTable& operator=(SwissHashTable&&);
+
+    iterator begin() { return isEmpty() ? end() : makeIterator(0); }
+    iterator end() { return makeKnownGoodIterator(m_tableSize); }
+    const_iterator begin() const { return isEmpty() ? end() : makeConstIterator(0); }
+    const_iterator end() const { return makeKnownGoodConstIterator(m_tableSize); }
+
+    unsigned size() const { return m_keyCount; }
+    unsigned capacity() const { return m_tableSize; }
+    bool isEmpty() const { return !m_keyCount; }
+
+    AddResult add(const ValueType& value) { return add<IdentityTranslatorType>(Extractor::extract(value), value); }
+    AddResult add(ValueType&& value) { return add<IdentityTranslatorType>(Extractor::extract(value), WTFMove(value)); }
+
+    template<typename HashTranslator, typename T, typename Extra> AddResult add(T&& key, Extra&&);
+    template<typename HashTranslator, typename T, typename Extra> AddResult addPassingHashCode(T&& key, Extra&&);
+
+    iterator find(const KeyType& key) { return find<IdentityTranslatorType>(key); }
+    const_iterator find(const KeyType& key) const { return find<IdentityTranslatorType>(key); }
+    bool contains(const KeyType& key) const { return contains<IdentityTranslatorType>(key); }
+
+    template<typename HashTranslator, typename T> iterator find(const T&);
+    template<typename HashTranslator, typename T> const_iterator find(const T&) const;
+    template<typename HashTranslator, typename T> bool contains(const T&) const;
+
+    void remove(const KeyType& key) { remove(find(key)); }
+    void remove(iterator it) { removeWithoutEntryConsistencyCheck(it); }
+    void removeWithoutEntryConsistencyCheck(iterator);
+    void removeWithoutEntryConsistencyCheck(const_iterator);
+    template<typename Functor>
+    void removeIf(const Functor&);
+    void clear();
+
+    ValueType* lookup(const Key& key) { return lookup<IdentityTranslatorType>(key); }
+    template<typename HashTranslator, typename T> ValueType* lookup(const T&);
+
+#if !ASSERT_DISABLED
+    void checkTableConsistency() const;
+#else
+    static void checkTableConsistency() { }
+#endif
+    static void internalCheckTableConsistency() { }
+    static void internalCheckTableConsistencyExceptSize() { }
+
+private:
+    static const unsigned minimumTableSize = SwissHashTableControl::groupSize;
+
+    void allocateTable(unsigned size);
+    static void deallocateTable(ValueType* table, unsigned size);
+    static void initializeBucket(ValueType& bucket) { HashTableBucketInitializer<Traits::emptyValueIsZero>::template initialize<Traits>(bucket); }
+
+    unsigned groupMask() const { return m_tableSize / SwissHashTableControl::groupSize - 1; }
+    template<typename HashTranslator, typename T> ValueType* lookupWithHash(const T&, unsigned hash);
+    template<typename HashTranslator, typename T, typename Extra> AddResult addWithHash(T&& key, Extra&&, unsigned hash, bool passHashCode);
+    unsigned findSlotForReinsertion(unsigned hash) const;
+    ValueType* reinsert(ValueType&&);
+
+    void deleteBucket(unsigned index);
+    void removeAt(unsigned index);
+
+    // Keep at least one empty bucket per probe sequence: grow past a load of 7/8 counting tombstones.
+    bool shouldExpand() const { return (m_keyCount + m_deletedCount) * 8 > m_tableSize * 7; }
+    bool mustRehashInPlace() const { return m_keyCount * 16 < m_tableSize * 7; }
+    bool shouldShrink() const { return m_keyCount * 6 < m_tableSize && m_tableSize > bestTableSize(KeyTraits::minimumTableSize); }
+    static unsigned bestTableSize(unsigned keyCount);
+    ValueType* expand(ValueType* entry = nullptr);
+    void shrink() { rehash(m_tableSize / 2, nullptr); }
+    ValueType* rehash(unsigned newTableSize, ValueType* entry);
+
+    iterator makeIterator(unsigned index) { return iterator(m_table + index, m_control + index, m_table + m_tableSize); }
+    const_iterator makeConstIterator(unsigned index) const { return const_iterator(m_table + index, m_control + index, m_table + m_tableSize); }
+    iterator makeKnownGoodIterator(unsigned index) { return iterator(m_table + index, m_control + index, m_table + m_tableSize, HashItemKnownGood); }
+    const_iterator makeKnownGoodConstIterator(unsigned index) const { return const_iterator(m_table + index, m_control + index, m_table + m_tableSize, HashItemKnownGood); }
+
+    // The control bytes live in the same allocation, right after the buckets.
+    ValueType* m_table { nullptr };
+    int8_t* m_control { nullptr };
+    unsigned m_tableSize { 0 };
+    unsigned m_keyCount { 0 };
+    unsigned m_deletedCount { 0 };
+};
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline unsigned SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::bestTableSize(unsigned keyCount)
+{
+    // Start below a load of 1/2 so that a copied table has room to grow.
+    unsigned size = std::max<unsigned>(roundUpToPowerOfTwo(keyCount) * 2, minimumTableSize);
+    return std::max<unsigned>(size, roundUpToPowerOfTwo(KeyTraits::minimumTableSize));
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::allocateTable(unsigned size)
+{
+    ASSERT(size >= minimumTableSize && !(size & (size - 1)));
+    size_t bucketsSize = static_cast<size_t>(size) * sizeof(ValueType);
+    void* memory;
+    if (Traits::emptyValueIsZero)
+        memory = fastZeroedMalloc(bucketsSize + size);
+    else {
+        memory = fastMalloc(bucketsSize + size);
+        ValueType* buckets = static_cast<ValueType*>(memory);
+        for (unsigned i = 0; i < size; ++i)
+            initializeBucket(buckets[i]);
+    }
+    m_table = static_cast<ValueType*>(memory);
+    m_control = static_cast<int8_t*>(memory) + bucketsSize;
+    memset(m_control, SwissHashTableControl::empty, size);
+    m_tableSize = size;
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::deallocateTable(ValueType* table, unsigned size)
+{
+    // Every bucket holds a constructed value, the empty value if it is not full.
+    for (unsigned i = 0; i < size; ++i)
+        table[i].~ValueType();
+    fastFree(table);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+template<typename HashTranslator, typename T>
+ALWAYS_INLINE auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::lookupWithHash(const T& key, unsigned hash) -> ValueType*
+{
+    ASSERT(m_table);
+    int8_t tag = SwissHashTableControl::tagForHash(hash);
+    unsigned mask = groupMask();
+    unsigned group = hash & mask;
+    for (unsigned step = 1; ; ++step) {
+        unsigned groupStart = group * SwissHashTableControl::groupSize;
+        SwissHashTableGroup controls(m_control + groupStart);
+        for (unsigned candidates = controls.match(tag); candidates; candidates &= candidates - 1) {
+            ValueType* entry = m_table + groupStart + swissHashTableCountTrailingZeros(candidates);
+            if (HashTranslator::equal(Extractor::extract(*entry), key))
+                return entry;
+        }
+        if (controls.matchEmpty())
+            return nullptr;
+        // Triangular probing visits every group of a power of two sized table.
+        group = (group + step) & mask;
+    }
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+template<typename HashTranslator, typename T>
+inline auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::lookup(const T& key) -> ValueType*
+{
+    if (!m_table)
+        return nullptr;
+    return lookupWithHash<HashTranslator>(key, HashTranslator::hash(key));
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+template<typename HashTranslator, typename T>
+inline auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::find(const T& key) -> iterator
+{
+    ValueType* entry = lookup<HashTranslator>(key);
+    if (!entry)
+        return end();
+    return makeKnownGoodIterator(entry - m_table);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+template<typename HashTranslator, typename T>
+inline auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::find(const T& key) const -> const_iterator
+{
+    ValueType* entry = const_cast<SwissHashTable*>(this)->lookup<HashTranslator>(key);
+    if (!entry)
+        return end();
+    return makeKnownGoodConstIterator(entry - m_table);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+template<typename HashTranslator, typename T>
+inline bool SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::contains(const T& key) const
+{
+    return const_cast<SwissHashTable*>(this)->lookup<HashTranslator>(key);
+}
+
+template<bool passHashCode> struct SwissHashTableTranslate;
+
+template<> struct SwissHashTableTranslate<false> {
+    template<typename HashTranslator, typename ValueType, typename T, typename Extra>
+    static void translate(ValueType& location, T&& key, Extra&& extra, unsigned)
+    {
+        HashTranslator::translate(location, std::forward<T>(key), std::forward<Extra>(extra));
+    }
+};
+
+template<> struct SwissHashTableTranslate<true> {
+    template<typename HashTranslator, typename ValueType, typename T, typename Extra>
+    static void translate(ValueType& location, T&& key, Extra&& extra, unsigned hash)
+    {
+        HashTranslator::translate(location, std::forward<T>(key), std::forward<Extra>(extra), hash);
+    }
+};
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+template<typename HashTranslator, typename T, typename Extra>
+ALWAYS_INLINE auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::add(T&& key, Extra&& extra) -> AddResult
+{
+    if (!m_table)
+        expand();
+
+    unsigned hash = HashTranslator::hash(key);
+    if (ValueType* entry = lookupWithHash<HashTranslator>(key, hash))
+        return AddResult(makeKnownGoodIterator(entry - m_table), false);
+
+    unsigned index = findSlotForReinsertion(hash);
+    if (m_control[index] == SwissHashTableControl::deleted)
+        --m_deletedCount;
+    m_control[index] = SwissHashTableControl::tagForHash(hash);
+    ValueType* entry = m_table + index;
+    SwissHashTableTranslate<false>::template translate<HashTranslator>(*entry, std::forward<T>(key), std::forward<Extra>(extra), hash);
+    ++m_keyCount;
+
+    if (shouldExpand())
+        entry = expand(entry);
+
+    return AddResult(makeKnownGoodIterator(entry - m_table), true);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+template<typename HashTranslator, typename T, typename Extra>
+inline auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::addPassingHashCode(T&& key, Extra&& extra) -> AddResult
+{
+    if (!m_table)
+        expand();
+
+    unsigned hash = HashTranslator::hash(key);
+    if (ValueType* entry = lookupWithHash<HashTranslator>(key, hash))
+        return AddResult(makeKnownGoodIterator(entry - m_table), false);
+
+    unsigned index = findSlotForReinsertion(hash);
+    if (m_control[index] == SwissHashTableControl::deleted)
+        --m_deletedCount;
+    m_control[index] = SwissHashTableControl::tagForHash(hash);
+    ValueType* entry = m_table + index;
+    SwissHashTableTranslate<true>::template translate<HashTranslator>(*entry, std::forward<T>(key), std::forward<Extra>(extra), hash);
+    ++m_keyCount;
+
+    if (shouldExpand())
+        entry = expand(entry);
+
+    return AddResult(makeKnownGoodIterator(entry - m_table), true);
+}
+
+// Returns the first empty or deleted bucket on the probe sequence of the hash.
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline unsigned SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::findSlotForReinsertion(unsigned hash) const
+{
+    unsigned mask = groupMask();
+    unsigned group = hash & mask;
+    for (unsigned step = 1; ; ++step) {
+        unsigned groupStart = group * SwissHashTableControl::groupSize;
+        if (unsigned available = SwissHashTableGroup(m_control + groupStart).matchEmptyOrDeleted())
+            return groupStart + swissHashTableCountTrailingZeros(available);
+        group = (group + step) & mask;
+    }
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::reinsert(ValueType&& value) -> ValueType*
+{
+    unsigned hash = HashFunctions::hash(Extractor::extract(value));
+    unsigned index = findSlotForReinsertion(hash);
+    ASSERT(m_control[index] == SwissHashTableControl::empty);
+    m_control[index] = SwissHashTableControl::tagForHash(hash);
+    ValueType* entry = m_table + index;
+    entry->~ValueType();
+    new (NotNull, entry) ValueType(WTFMove(value));
+    return entry;
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::deleteBucket(unsigned index)
+{
+    ASSERT(SwissHashTableControl::isFull(m_control[index]));
+
+    // A probe only ever continued past this group if it was full at some point. A group
+    // that still has an empty bucket never was, so nothing depends on this bucket.
+    unsigned groupStart = index & ~(SwissHashTableControl::groupSize - 1);
+    if (SwissHashTableGroup(m_control + groupStart).matchEmpty())
+        m_control[index] = SwissHashTableControl::empty;
+    else {
+        m_control[index] = SwissHashTableControl::deleted;
+        ++m_deletedCount;
+    }
+
+    ValueType& bucket = m_table[index];
+    bucket.~ValueType();
+    initializeBucket(bucket);
+    --m_keyCount;
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::removeAt(unsigned index)
+{
+    deleteBucket(index);
+    if (shouldShrink())
+        shrink();
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::removeWithoutEntryConsistencyCheck(iterator it)
+{
+    if (it == end())
+        return;
+    removeAt(it.m_iterator.m_position - m_table);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::removeWithoutEntryConsistencyCheck(const_iterator it)
+{
+    if (it == end())
+        return;
+    removeAt(it.m_position - m_table);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+template<typename Functor>
+inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::removeIf(const Functor& functor)
+{
+    for (unsigned i = m_tableSize; i--;) {
+        if (!SwissHashTableControl::isFull(m_control[i]))
+            continue;
+        if (!functor(m_table[i]))
+            continue;
+        deleteBucket(i);
+    }
+
+    if (shouldShrink())
+        shrink();
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::expand(ValueType* entry) -> ValueType*
+{
+    unsigned newSize;
+    if (!m_tableSize)
+        newSize = bestTableSize(KeyTraits::minimumTableSize);
+    else if (mustRehashInPlace())
+        newSize = m_tableSize;
+    else
+        newSize = m_tableSize * 2;
+
+    return rehash(newSize, entry);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::rehash(unsigned newTableSize, ValueType* entry) -> ValueType*
+{
+    unsigned oldTableSize = m_tableSize;
+    ValueType* oldTable = m_table;
+    const int8_t* oldControl = m_control;
+
+    allocateTable(newTableSize);
+    m_deletedCount = 0;
+
+    ValueType* newEntry = nullptr;
+    for (unsigned i = 0; i < oldTableSize; ++i) {
+        if (!SwissHashTableControl::isFull(oldControl[i])) {
+            ASSERT(&oldTable[i] != entry);
+            continue;
+        }
+
+        ValueType* reinsertedEntry = reinsert(WTFMove(oldTable[i]));
+        if (&oldTable[i] == entry) {
+            ASSERT(!newEntry);
+            newEntry = reinsertedEntry;
+        }
+    }
+
+    if (oldTable)
+        deallocateTable(oldTable, oldTableSize);
+
+    return newEntry;
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::clear()
+{
+    if (!m_table)
+        return;
+
+    deallocateTable(m_table, m_tableSize);
+    m_table = nullptr;
+    m_control = nullptr;
+    m_tableSize = 0;
+    m_keyCount = 0;
+    m_deletedCount = 0;
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::SwissHashTable(const SwissHashTable& other)
+{
+    if (!other.m_keyCount)
+        return;
+
+    allocateTable(bestTableSize(other.m_keyCount));
+    for (unsigned i = 0; i < other.m_tableSize; ++i) {
+        if (!SwissHashTableControl::isFull(other.m_control[i]))
+            continue;
+        ValueType copy(other.m_table[i]);
+        reinsert(WTFMove(copy));
+    }
+    m_keyCount = other.m_keyCount;
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::swap(SwissHashTable& other)
+{
+    std::swap(m_table, other.m_table);
+    std::swap(m_control, other.m_control);
+    std::swap(m_tableSize, other.m_tableSize);
+    std::swap(m_keyCount, other.m_keyCount);
+    std::swap(m_deletedCount, other.m_deletedCount);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::operator=(const SwissHashTable& other) -> SwissHashTable&
+{
+    SwissHashTable temp(other);
+    swap(temp);
+    return *this;
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::SwissHashTable(SwissHashTable&& other)
+{
+    swap(other);
+}
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+inline auto SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::operator=(SwissHashTable&& other) -> SwissHashTable&
+{
+    SwissHashTable temp = WTFMove(other);
+    swap(temp);
+    return *this;
+}
+
+#if !ASSERT_DISABLED
+
+template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::checkTableConsistency() const
+{
+    if (!m_table)
+        return;
+
+    unsigned count = 0;
+    unsigned deletedCount = 0;
+    for (unsigned i = 0; i < m_tableSize; ++i) {
+        int8_t control = m_control[i];
+        if (control == SwissHashTableControl::deleted) {
+            ++deletedCount;
+            continue;
+        }
+        if (!SwissHashTableControl::isFull(control)) {
+            ASSERT(control == SwissHashTableControl::empty);
+            continue;
+        }
+
+        const ValueType& entry = m_table[i];
+        ASSERT(control == SwissHashTableControl::tagForHash(HashFunctions::hash(Extractor::extract(entry))));
+        const_iterator it = find(Extractor::extract(entry));
+        ASSERT_UNUSED(entry, &entry == it.m_position);
+        ++count;
+
+        ValueCheck<Key>::checkConsistency(Extractor::extract(entry));
+    }
+
+    ASSERT(count == m_keyCount);
+    ASSERT(deletedCount == m_deletedCount);
+    ASSERT(!shouldExpand());
+}
+
+#endif // !ASSERT_DISABLED
+
+} // namespace WTF
+
+using WTF::SwissHashTable;
+
+#endif // WTF_SwissHashTable_h
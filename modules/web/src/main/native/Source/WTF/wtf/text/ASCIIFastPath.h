@@ -27,7 +27,7 @@
 #include <wtf/StdLibExtras.h>
 #include <wtf/text/LChar.h>
 
-#if OS(DARWIN) && (CPU(X86) || CPU(X86_64))
+#if CPU(X86_64) || (OS(DARWIN) && CPU(X86))
 #include <emmintrin.h>
 #endif
 
@@ -192,6 +192,68 @@ inline void copyLCharsFromUCharSource(LChar* destination, const UChar* source, s
 #endif
 }
 
+// JSON strings must escape '"', '\\' and control characters, and in practice are mostly long
+// runs of characters that need no escaping. These skip over such runs a vector (or machine word)
+// at a time, stopping at or before the first character that needs escaping; the caller deals
+// with the remaining characters one at a time.
+inline const LChar* skipCharactersNotNeedingJSONEscape(const LChar* characters, const LChar* end)
+{
+#if CPU(X86_64)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lastControlCharacter = _mm_set1_epi8(0x1f);
+    for (; end - characters >= 16; characters += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+        __m128i stop = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+        stop = _mm_or_si128(stop, _mm_cmpeq_epi8(_mm_max_epu8(chunk, lastControlCharacter), lastControlCharacter));
+        if (_mm_movemask_epi8(stop))
+            break;
+    }
+#else
+    const MachineWord ones = static_cast<MachineWord>(-1) / 0xff;
+    const MachineWord highBits = ones * 0x80;
+    for (; end - characters >= static_cast<ptrdiff_t>(sizeof(MachineWord)); characters += sizeof(MachineWord)) {
+        MachineWord word;
+        memcpy(&word, characters, sizeof(MachineWord));
+        MachineWord quotes = word ^ (ones * '"');
+        MachineWord backslashes = word ^ (ones * '\\');
+        if ((((word - ones * 0x20) & ~word) | ((quotes - ones) & ~quotes) | ((backslashes - ones) & ~backslashes)) & highBits)
+            break;
+    }
+#endif
+    return characters;
+}
+
+inline const UChar* skipCharactersNotNeedingJSONEscape(const UChar* characters, const UChar* end)
+{
+#if CPU(X86_64)
+    const __m128i quote = _mm_set1_epi16('"');
+    const __m128i backslash = _mm_set1_epi16('\\');
+    const __m128i lastControlCharacter = _mm_set1_epi16(0x1f);
+    const __m128i zero = _mm_setzero_si128();
+    for (; end - characters >= 8; characters += 8) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+        __m128i stop = _mm_or_si128(_mm_cmpeq_epi16(chunk, quote), _mm_cmpeq_epi16(chunk, backslash));
+        stop = _mm_or_si128(stop, _mm_cmpeq_epi16(_mm_subs_epu16(chunk, lastControlCharacter), zero));
+        if (_mm_movemask_epi8(stop))
+            break;
+    }
+#else
+    const MachineWord ones = static_cast<MachineWord>(-1) / 0xffff;
+    const MachineWord highBits = ones * 0x8000;
+    const size_t charactersPerWord = sizeof(MachineWord) / sizeof(UChar);
+    for (; end - characters >= static_cast<ptrdiff_t>(charactersPerWord); characters += charactersPerWord) {
+        MachineWord word;
+        memcpy(&word, characters, sizeof(MachineWord));
+        MachineWord quotes = word ^ (ones * '"');
+        MachineWord backslashes = word ^ (ones * '\\');
+        if ((((word - ones * 0x20) & ~word) | ((quotes - ones) & ~quotes) | ((backslashes - ones) & ~backslashes)) & highBits)
+            break;
+    }
+#endif
+    return characters;
+}
+
 } // namespace WTF
 
 #endif // ASCIIFastPath_h
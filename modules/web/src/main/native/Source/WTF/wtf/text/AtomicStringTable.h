@@ -24,24 +24,34 @@
 #define WTF_AtomicStringTable_h
 
 #include <wtf/HashSet.h>
+#include <wtf/SwissHashTable.h>
 #include <wtf/WTFThreadData.h>
+#include <wtf/text/StringHash.h>
 
 namespace WTF {
 
 class StringImpl;
 
+// Every string atomization probes this table, most of them for strings that are
+// already in it, so it uses the group probing of SwissHashTable.
+struct AtomicStringTableTraits : HashTraits<StringImpl*> {
+    static const bool useSwissTable = true;
+};
+
 class AtomicStringTable {
     WTF_MAKE_FAST_ALLOCATED;
 public:
+    typedef HashSet<StringImpl*, StringHash, AtomicStringTableTraits> StringTableImpl;
+
     WTF_EXPORT_PRIVATE ~AtomicStringTable();
 
     static void create(WTFThreadData&);
-    HashSet<StringImpl*>& table() { return m_table; }
+    StringTableImpl& table() { return m_table; }
 
 private:
     static void destroy(AtomicStringTable*);
 
-    HashSet<StringImpl*> m_table;
+    StringTableImpl m_table;
 };
 
 }
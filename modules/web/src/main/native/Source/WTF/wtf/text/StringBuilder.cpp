@@ -27,6 +27,7 @@
 #include "config.h"
 #include "StringBuilder.h"
 
+#include "ASCIIFastPath.h"
 #include "IntegerToStringConversion.h"
 #include "MathExtras.h"
 #include "WTFString.h"
@@ -365,6 +366,14 @@ template <typename OutputCharacterType, typename InputCharacterType>
 static void appendQuotedJSONStringInternal(OutputCharacterType*& output, const InputCharacterType* input, unsigned length)
 {
     for (const InputCharacterType* end = input + length; input != end; ++input) {
+        const InputCharacterType* runEnd = skipCharactersNotNeedingJSONEscape(input, end);
+        if (runEnd != input) {
+            StringImpl::copyChars(output, input, runEnd - input);
+            output += runEnd - input;
+            input = runEnd;
+            if (input == end)
+                break;
+        }
         if (LIKELY(*input > 0x1F)) {
             if (*input == '"' || *input == '\\')
                 *output++ = '\\';
@@ -26,6 +26,7 @@
 #ifndef StringCommon_h
 #define StringCommon_h
 
+#include <string.h>
 #include <unicode/uchar.h>
 #include <wtf/ASCIICType.h>
 
@@ -517,6 +518,32 @@ ALWAYS_INLINE static size_t findInner(const SearchCharacterType* searchCharacter
     return index + i;
 }
 
+// For 8-bit strings, let memchr find the candidates for the first character and compare the
+// rest with memcmp; both are vectorized by the C library. When the candidates cost more
+// comparing than scanning would, as with runs of the same character or other periodic
+// patterns, fall back to the running hash above, which doesn't go quadratic on them.
+ALWAYS_INLINE static size_t findInner(const LChar* searchCharacters, const LChar* matchCharacters, unsigned index, unsigned searchLength, unsigned matchLength)
+{
+    ASSERT(matchLength && matchLength <= searchLength);
+
+    const LChar* lastCandidate = searchCharacters + (searchLength - matchLength);
+    LChar firstCharacter = matchCharacters[0];
+    // memcmp doesn't say where it stopped, so charge each false candidate the whole comparison.
+    size_t comparedCharacters = 0;
+    for (const LChar* position = searchCharacters; position <= lastCandidate; ++position) {
+        position = static_cast<const LChar*>(memchr(position, firstCharacter, lastCandidate - position + 1));
+        if (!position)
+            return notFound;
+        if (!memcmp(position + 1, matchCharacters + 1, matchLength - 1))
+            return index + (position - searchCharacters);
+        unsigned offset = position - searchCharacters;
+        comparedCharacters += matchLength - 1;
+        if (comparedCharacters > 64 + static_cast<size_t>(offset) * 4 && position < lastCandidate)
+            return findInner<LChar, LChar>(position + 1, matchCharacters, index + offset + 1, searchLength - offset - 1, matchLength);
+    }
+    return notFound;
+}
+
 template<typename CharacterType>
 inline size_t find(const CharacterType* characters, unsigned length, CharacterType matchCharacter, unsigned index = 0)
 {
@@ -528,6 +555,17 @@ inline size_t find(const CharacterType* characters, unsigned length, CharacterTy
     return notFound;
 }
 
+template<>
+inline size_t find(const LChar* characters, unsigned length, LChar matchCharacter, unsigned index)
+{
+    if (index >= length)
+        return notFound;
+    const LChar* found = static_cast<const LChar*>(memchr(characters + index, matchCharacter, length - index));
+    if (!found)
+        return notFound;
+    return found - characters;
+}
+
 ALWAYS_INLINE size_t find(const UChar* characters, unsigned length, LChar matchCharacter, unsigned index = 0)
 {
     return find(characters, length, static_cast<UChar>(matchCharacter), index);
@@ -0,0 +1,5 @@
+#ifndef WebCore_FWD_YarrPikeVM_h
+#define WebCore_FWD_YarrPikeVM_h
+#include <JavaScriptCore/YarrPikeVM.h>
+#endif
+
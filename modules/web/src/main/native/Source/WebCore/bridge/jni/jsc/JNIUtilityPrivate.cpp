@@ -29,6 +29,7 @@
 
 #if ENABLE(JAVA_BRIDGE)
 
+#include "JSDOMBinding.h"
 #include "JavaArrayJSC.h"
 #include "JavaInstanceJSC.h"
 #include "JavaRuntimeObject.h"
@@ -36,8 +37,12 @@
 #include "runtime_array.h"
 #include "runtime_object.h"
 #include "runtime_root.h"
+#include <runtime/Error.h>
 #include <runtime/JSArray.h>
+#include <runtime/JSArrayBufferView.h>
 #include <runtime/JSLock.h>
+#include <runtime/TypedArrayInlines.h>
+#include <runtime/TypedArrays.h>
 
 
     #include "JSNode.h"
@@ -49,6 +54,52 @@ namespace JSC {
 
 namespace Bindings {
 
+// Element traits for moving a whole Java primitive array with a single JNI call.
+template<typename JavaElement> struct JavaArrayRegion;
+
+#define DEFINE_JAVA_ARRAY_REGION(JavaElement, ArrayType, Name) \
+template<> struct JavaArrayRegion<JavaElement> { \
+    static jarray create(JNIEnv* env, jsize length) { return env->New##Name##Array(length); } \
+    static void get(JNIEnv* env, jarray array, jsize length, JavaElement* buffer) \
+    { \
+        env->Get##Name##ArrayRegion(static_cast<ArrayType>(array), 0, length, buffer); \
+    } \
+    static void set(JNIEnv* env, jarray array, jsize length, const JavaElement* buffer) \
+    { \
+        env->Set##Name##ArrayRegion(static_cast<ArrayType>(array), 0, length, buffer); \
+    } \
+};
+
+DEFINE_JAVA_ARRAY_REGION(jboolean, jbooleanArray, Boolean)
+DEFINE_JAVA_ARRAY_REGION(jbyte, jbyteArray, Byte)
+DEFINE_JAVA_ARRAY_REGION(jchar, jcharArray, Char)
+DEFINE_JAVA_ARRAY_REGION(jshort, jshortArray, Short)
+DEFINE_JAVA_ARRAY_REGION(jint, jintArray, Int)
+DEFINE_JAVA_ARRAY_REGION(jlong, jlongArray, Long)
+DEFINE_JAVA_ARRAY_REGION(jfloat, jfloatArray, Float)
+DEFINE_JAVA_ARRAY_REGION(jdouble, jdoubleArray, Double)
+
+#undef DEFINE_JAVA_ARRAY_REGION
+
+template<typename JavaElement>
+static jarray createJavaArray(const Vector<JavaElement>& buffer)
+{
+    JNIEnv* env = getJNIEnv();
+    jarray array = JavaArrayRegion<JavaElement>::create(env, buffer.size());
+    if (array)
+        JavaArrayRegion<JavaElement>::set(env, array, buffer.size(), buffer.data());
+    return array;
+}
+
+template<typename JavaElement>
+static jarray convertArrayElements(ExecState* exec, JSArray* jsArray, unsigned length)
+{
+    Vector<JavaElement> buffer(length);
+    for (unsigned i = 0; i < length; i++)
+        buffer[i] = (JavaElement)jsArray->get(exec, i).toNumber(exec);
+    return createJavaArray(buffer);
+}
+
 static jobject convertArrayInstanceToJavaArray(ExecState* exec, JSArray* jsArray, const char* javaClassName)
 {
     JNIEnv* env = getJNIEnv();
@@ -56,116 +107,69 @@ static jobject convertArrayInstanceToJavaArray(ExecState* exec, JSArray* jsArray
     // the requested Java Array type requested, unless the array type is some object array
     // other than a string.
     unsigned length = jsArray->length();
-    jobjectArray jarray = 0;
+    jarray javaArray = 0;
 
-    // Build the correct array type
+    // Build the correct array type. Primitive elements are converted into a
+    // native buffer first so the Java array is filled with one JNI call.
     switch (javaTypeFromPrimitiveType(javaClassName[1])) {
     case JavaTypeObject:
-            {
+        {
             // Only support string object types
             if (!strcmp("[Ljava.lang.String;", javaClassName)) {
-                jarray = (jobjectArray)env->NewObjectArray(length,
+                javaArray = env->NewObjectArray(length,
                     env->FindClass("java/lang/String"),
                     env->NewStringUTF(""));
                 for (unsigned i = 0; i < length; i++) {
                     JSValue item = jsArray->get(exec, i);
                     String stringValue = item.toString(exec)->value(exec);
-                    env->SetObjectArrayElement(jarray, i, stringValue.toJavaString(env).releaseLocal());
+                    env->SetObjectArrayElement(static_cast<jobjectArray>(javaArray), i, stringValue.toJavaString(env).releaseLocal());
                 }
             }
             break;
         }
 
     case JavaTypeBoolean:
-        {
-            jarray = (jobjectArray)env->NewBooleanArray(length);
-            for (unsigned i = 0; i < length; i++) {
-                JSValue item = jsArray->get(exec, i);
-                jboolean value = (jboolean)item.toNumber(exec);
-                env->SetBooleanArrayRegion((jbooleanArray)jarray, (jsize)i, (jsize)1, &value);
-            }
-            break;
-        }
+        javaArray = convertArrayElements<jboolean>(exec, jsArray, length);
+        break;
 
     case JavaTypeByte:
-        {
-            jarray = (jobjectArray)env->NewByteArray(length);
-            for (unsigned i = 0; i < length; i++) {
-                JSValue item = jsArray->get(exec, i);
-                jbyte value = (jbyte)item.toNumber(exec);
-                env->SetByteArrayRegion((jbyteArray)jarray, (jsize)i, (jsize)1, &value);
-            }
-            break;
-        }
+        javaArray = convertArrayElements<jbyte>(exec, jsArray, length);
+        break;
 
     case JavaTypeChar:
         {
-            jarray = (jobjectArray)env->NewCharArray(length);
+            Vector<jchar> buffer(length);
             for (unsigned i = 0; i < length; i++) {
                 JSValue item = jsArray->get(exec, i);
                 String stringValue = item.toString(exec)->value(exec);
                 jchar value = 0;
                 if (stringValue.length() > 0)
                     value = (const jchar)StringView(stringValue)[0];
-                env->SetCharArrayRegion((jcharArray)jarray, (jsize)i, (jsize)1, &value);
+                buffer[i] = value;
             }
+            javaArray = createJavaArray(buffer);
             break;
         }
 
     case JavaTypeShort:
-        {
-            jarray = (jobjectArray)env->NewShortArray(length);
-            for (unsigned i = 0; i < length; i++) {
-                JSValue item = jsArray->get(exec, i);
-                jshort value = (jshort)item.toNumber(exec);
-                env->SetShortArrayRegion((jshortArray)jarray, (jsize)i, (jsize)1, &value);
-            }
-            break;
-        }
+        javaArray = convertArrayElements<jshort>(exec, jsArray, length);
+        break;
 
     case JavaTypeInt:
-        {
-            jarray = (jobjectArray)env->NewIntArray(length);
-            for (unsigned i = 0; i < length; i++) {
-                JSValue item = jsArray->get(exec, i);
-                jint value = (jint)item.toNumber(exec);
-                env->SetIntArrayRegion((jintArray)jarray, (jsize)i, (jsize)1, &value);
-            }
-            break;
-        }
+        javaArray = convertArrayElements<jint>(exec, jsArray, length);
+        break;
 
     case JavaTypeLong:
-        {
-            jarray = (jobjectArray)env->NewLongArray(length);
-            for (unsigned i = 0; i < length; i++) {
-                JSValue item = jsArray->get(exec, i);
-                jlong value = (jlong)item.toNumber(exec);
-                env->SetLongArrayRegion((jlongArray)jarray, (jsize)i, (jsize)1, &value);
-            }
-            break;
-        }
+        javaArray = convertArrayElements<jlong>(exec, jsArray, length);
+        break;
 
     case JavaTypeFloat:
-        {
-            jarray = (jobjectArray)env->NewFloatArray(length);
-            for (unsigned i = 0; i < length; i++) {
-                JSValue item = jsArray->get(exec, i);
-                jfloat value = (jfloat)item.toNumber(exec);
-                env->SetFloatArrayRegion((jfloatArray)jarray, (jsize)i, (jsize)1, &value);
-            }
-            break;
-        }
+        javaArray = convertArrayElements<jfloat>(exec, jsArray, length);
+        break;
 
     case JavaTypeDouble:
-        {
-            jarray = (jobjectArray)env->NewDoubleArray(length);
-            for (unsigned i = 0; i < length; i++) {
-                JSValue item = jsArray->get(exec, i);
-                jdouble value = (jdouble)item.toNumber(exec);
-                env->SetDoubleArrayRegion((jdoubleArray)jarray, (jsize)i, (jsize)1, &value);
-            }
-            break;
-        }
+        javaArray = convertArrayElements<jdouble>(exec, jsArray, length);
+        break;
 
     case JavaTypeArray: // don't handle embedded arrays
     case JavaTypeVoid: // Don't expect arrays of void objects
@@ -174,7 +178,194 @@ static jobject convertArrayInstanceToJavaArray(ExecState* exec, JSArray* jsArray
     }
 
     // if it was not one of the cases handled, then null is returned
-    return jarray;
+    return javaArray;
+}
+
+template<typename JavaElement, typename TypedElement>
+static void copyTypedArrayElements(JNIEnv* env, jarray array, const TypedElement* elements, unsigned length)
+{
+    // Java booleans must be 0 or 1, so Uint8Array contents are never copied as is.
+    if (std::is_same<JavaElement, TypedElement>::value && !std::is_same<JavaElement, jboolean>::value) {
+        JavaArrayRegion<JavaElement>::set(env, array, length, reinterpret_cast<const JavaElement*>(elements));
+        return;
+    }
+
+    Vector<JavaElement> buffer(length);
+    for (unsigned i = 0; i < length; i++) {
+        if (std::is_same<JavaElement, jboolean>::value)
+            buffer[i] = elements[i] ? JNI_TRUE : JNI_FALSE;
+        else
+            buffer[i] = (JavaElement)elements[i];
+    }
+    JavaArrayRegion<JavaElement>::set(env, array, length, buffer.data());
+}
+
+template<typename JavaElement>
+static void copyTypedArrayElements(JNIEnv* env, jarray array, JSArrayBufferView* view)
+{
+    const void* vector = view->vector();
+    unsigned length = view->length();
+    switch (view->classInfo()->typedArrayStorageType) {
+    case TypeInt8:
+        copyTypedArrayElements<JavaElement>(env, array, static_cast<const int8_t*>(vector), length);
+        break;
+    case TypeUint8:
+    case TypeUint8Clamped:
+        copyTypedArrayElements<JavaElement>(env, array, static_cast<const uint8_t*>(vector), length);
+        break;
+    case TypeInt16:
+        copyTypedArrayElements<JavaElement>(env, array, static_cast<const int16_t*>(vector), length);
+        break;
+    case TypeUint16:
+        copyTypedArrayElements<JavaElement>(env, array, static_cast<const uint16_t*>(vector), length);
+        break;
+    case TypeInt32:
+        copyTypedArrayElements<JavaElement>(env, array, static_cast<const int32_t*>(vector), length);
+        break;
+    case TypeUint32:
+        copyTypedArrayElements<JavaElement>(env, array, static_cast<const uint32_t*>(vector), length);
+        break;
+    case TypeFloat32:
+        copyTypedArrayElements<JavaElement>(env, array, static_cast<const float*>(vector), length);
+        break;
+    case TypeFloat64:
+        copyTypedArrayElements<JavaElement>(env, array, static_cast<const double*>(vector), length);
+        break;
+    case NotTypedArray:
+    case TypeDataView:
+        ASSERT_NOT_REACHED();
+        break;
+    }
+}
+
+bool copyTypedArrayToJavaArray(JSArrayBufferView* view, jarray array, JavaType elementType)
+{
+    if (!isTypedView(view->classInfo()->typedArrayStorageType))
+        return false;
+
+    JNIEnv* env = getJNIEnv();
+    if (static_cast<unsigned>(env->GetArrayLength(array)) < view->length())
+        return false;
+
+    switch (elementType) {
+    case JavaTypeBoolean:
+        copyTypedArrayElements<jboolean>(env, array, view);
+        return true;
+    case JavaTypeByte:
+        copyTypedArrayElements<jbyte>(env, array, view);
+        return true;
+    case JavaTypeChar:
+        copyTypedArrayElements<jchar>(env, array, view);
+        return true;
+    case JavaTypeShort:
+        copyTypedArrayElements<jshort>(env, array, view);
+        return true;
+    case JavaTypeInt:
+        copyTypedArrayElements<jint>(env, array, view);
+        return true;
+    case JavaTypeLong:
+        copyTypedArrayElements<jlong>(env, array, view);
+        return true;
+    case JavaTypeFloat:
+        copyTypedArrayElements<jfloat>(env, array, view);
+        return true;
+    case JavaTypeDouble:
+        copyTypedArrayElements<jdouble>(env, array, view);
+        return true;
+    default:
+        return false;
+    }
+}
+
+static jobject convertTypedArrayToJavaArray(JSArrayBufferView* view, const char* javaClassName)
+{
+    if (!isTypedView(view->classInfo()->typedArrayStorageType))
+        return 0;
+
+    JNIEnv* env = getJNIEnv();
+    unsigned length = view->length();
+    jarray array = 0;
+    JavaType elementType = javaTypeFromPrimitiveType(javaClassName[1]);
+    switch (elementType) {
+    case JavaTypeBoolean:
+        array = JavaArrayRegion<jboolean>::create(env, length);
+        break;
+    case JavaTypeByte:
+        array = JavaArrayRegion<jbyte>::create(env, length);
+        break;
+    case JavaTypeChar:
+        array = JavaArrayRegion<jchar>::create(env, length);
+        break;
+    case JavaTypeShort:
+        array = JavaArrayRegion<jshort>::create(env, length);
+        break;
+    case JavaTypeInt:
+        array = JavaArrayRegion<jint>::create(env, length);
+        break;
+    case JavaTypeLong:
+        array = JavaArrayRegion<jlong>::create(env, length);
+        break;
+    case JavaTypeFloat:
+        array = JavaArrayRegion<jfloat>::create(env, length);
+        break;
+    case JavaTypeDouble:
+        array = JavaArrayRegion<jdouble>::create(env, length);
+        break;
+    default:
+        return 0;
+    }
+
+    if (array)
+        copyTypedArrayToJavaArray(view, array, elementType);
+    return array;
+}
+
+template<typename Adaptor, typename JavaElement>
+static JSValue convertJavaArrayToTypedArray(ExecState* exec, jarray array, unsigned length)
+{
+    typedef typename Adaptor::Type TypedElement;
+
+    RefPtr<GenericTypedArrayView<Adaptor>> view = GenericTypedArrayView<Adaptor>::createUninitialized(length);
+    if (!view)
+        return exec->vm().throwException(exec, createOutOfMemoryError(exec));
+
+    JNIEnv* env = getJNIEnv();
+    if (std::is_same<JavaElement, TypedElement>::value)
+        JavaArrayRegion<JavaElement>::get(env, array, length, reinterpret_cast<JavaElement*>(view->data()));
+    else {
+        Vector<JavaElement> buffer(length);
+        JavaArrayRegion<JavaElement>::get(env, array, length, buffer.data());
+        TypedElement* elements = view->data();
+        for (unsigned i = 0; i < length; i++)
+            elements[i] = static_cast<TypedElement>(buffer[i]);
+    }
+    return WebCore::toJS(exec, exec->lexicalGlobalObject(), view.get());
+}
+
+JSValue convertJavaArrayToTypedArray(ExecState* exec, jarray array, JavaType elementType, unsigned length)
+{
+    switch (elementType) {
+    case JavaTypeBoolean:
+        return convertJavaArrayToTypedArray<Uint8Adaptor, jboolean>(exec, array, length);
+    case JavaTypeByte:
+        return convertJavaArrayToTypedArray<Int8Adaptor, jbyte>(exec, array, length);
+    case JavaTypeChar:
+        return convertJavaArrayToTypedArray<Uint16Adaptor, jchar>(exec, array, length);
+    case JavaTypeShort:
+        return convertJavaArrayToTypedArray<Int16Adaptor, jshort>(exec, array, length);
+    case JavaTypeInt:
+        return convertJavaArrayToTypedArray<Int32Adaptor, jint>(exec, array, length);
+    case JavaTypeLong:
+        // There is no 64-bit integer typed array; longs lose precision as they
+        // do when read one at a time.
+        return convertJavaArrayToTypedArray<Float64Adaptor, jlong>(exec, array, length);
+    case JavaTypeFloat:
+        return convertJavaArrayToTypedArray<Float32Adaptor, jfloat>(exec, array, length);
+    case JavaTypeDouble:
+        return convertJavaArrayToTypedArray<Float64Adaptor, jdouble>(exec, array, length);
+    default:
+        return JSValue();
+    }
 }
 
 static jchar toJCharValue(const JSValue& value, ExecState* exec)
@@ -242,6 +433,12 @@ jvalue convertValueToJValue(ExecState* exec, RootObject* rootObject, JSValue val
                         return result;
                     }
                     result.l = array->javaArray();
+                } else if (javaType == JavaTypeArray && isJSArray(object)) {
+                    // Input is a JavaScript Array, copy it into a new Java Array.
+                    result.l = convertArrayInstanceToJavaArray(exec, asArray(object), javaClassName);
+                } else if (javaType == JavaTypeArray && jsDynamicCast<JSArrayBufferView*>(object)) {
+                    // Input is a typed array, copy it into a new Java primitive array.
+                    result.l = convertTypedArrayToJavaArray(jsCast<JSArrayBufferView*>(object), javaClassName);
                 } else if ((!result.l && (!strcmp(javaClassName, "java.lang.Object")))
                            || (!strcmp(javaClassName, "netscape.javascript.JSObject"))) {
                     // Wrap objects in JSObject instances.
@@ -442,16 +639,17 @@ jthrowable dispatchJNICall(int count, RootObject* rootObject, jobject obj, bool
     }
 
     JNIEnv* env = getJNIEnv();
+    static JGClass utilityCls(env->FindClass("com/sun/webkit/Utilities"));
+    static JGClass objectCls(env->FindClass("java/lang/Object"));
+    static jmethodID invokeMethod =
+        env->GetStaticMethodID(utilityCls, "fwkInvokeWithContext",
+                               "(Ljava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;Ljava/security/AccessControlContext;)Ljava/lang/Object;");
+
     jclass objClass = env->GetObjectClass(obj);
     jobject rmethod = env->ToReflectedMethod(objClass, methodId, isStatic);
-    jclass utilityCls = env->FindClass("com/sun/webkit/Utilities");
-    jclass objectCls = env->FindClass("java/lang/Object");
     jobjectArray argsArray = env->NewObjectArray(count, objectCls, NULL);
     for (int i = 0;  i < count; i++)
       env->SetObjectArrayElement(argsArray, i, args[i]);
-    jmethodID invokeMethod =
-        env->GetStaticMethodID(utilityCls, "fwkInvokeWithContext",
-                               "(Ljava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;Ljava/security/AccessControlContext;)Ljava/lang/Object;");
     jobject r = env->CallStaticObjectMethod(utilityCls, invokeMethod,
                                             rmethod, obj, argsArray,
                                             accessControlContext);
@@ -507,6 +705,85 @@ jthrowable dispatchJNICall(int count, RootObject* rootObject, jobject obj, bool
     return ex;
 }
 
+// Without a security manager the access control context in
+// fwkInvokeWithContext restricts nothing, so a public method of a public
+// non-JDK class can be called straight through JNI with the same result.
+bool canDispatchJNICallDirectly()
+{
+    JNIEnv* env = getJNIEnv();
+    static JGClass systemCls(env->FindClass("java/lang/System"));
+    static jmethodID getSecurityManager =
+        env->GetStaticMethodID(systemCls, "getSecurityManager", "()Ljava/lang/SecurityManager;");
+
+    // A security manager can be installed at any time, so this is checked on
+    // every call.
+    jobject securityManager = env->CallStaticObjectMethod(systemCls, getSecurityManager);
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+        return false;
+    }
+    if (!securityManager)
+        return true;
+    env->DeleteLocalRef(securityManager);
+    return false;
+}
+
+jthrowable dispatchJNICallDirect(jobject obj, JavaType returnType, jmethodID methodId, jvalue* args, jvalue& result)
+{
+    // Since obj is WeakGlobalRef, creating a localref to safeguard instance() from GC
+    JLObject jlinstance(obj, true);
+
+    if (!jlinstance) {
+        LOG_ERROR("Could not get javaInstance for %p in JNIUtilityPrivate::dispatchJNICallDirect", (jobject)jlinstance);
+        return NULL;
+    }
+
+    JNIEnv* env = getJNIEnv();
+    switch (returnType) {
+    case JavaTypeVoid:
+        env->CallVoidMethodA(obj, methodId, args);
+        break;
+    case JavaTypeArray:
+    case JavaTypeObject:
+        result.l = env->CallObjectMethodA(obj, methodId, args);
+        break;
+    case JavaTypeChar:
+        // Callers expect a boxed Character, as returned by reflection.
+        result.c = env->CallCharMethodA(obj, methodId, args);
+        if (!env->ExceptionCheck())
+            result.l = jvalueToJObject(result, JavaTypeChar);
+        break;
+    case JavaTypeBoolean:
+        result.z = env->CallBooleanMethodA(obj, methodId, args);
+        break;
+    case JavaTypeByte:
+        result.b = env->CallByteMethodA(obj, methodId, args);
+        break;
+    case JavaTypeShort:
+        result.s = env->CallShortMethodA(obj, methodId, args);
+        break;
+    case JavaTypeInt:
+        result.i = env->CallIntMethodA(obj, methodId, args);
+        break;
+    case JavaTypeLong:
+        result.j = env->CallLongMethodA(obj, methodId, args);
+        break;
+    case JavaTypeFloat:
+        result.f = env->CallFloatMethodA(obj, methodId, args);
+        break;
+    case JavaTypeDouble:
+        result.d = env->CallDoubleMethodA(obj, methodId, args);
+        break;
+    case JavaTypeInvalid:
+        /* Nothing to do */
+        break;
+    }
+
+    jthrowable ex = env->ExceptionOccurred();
+    env->ExceptionClear();
+    return ex;
+}
+
 } // end of namespace Bindings
 
 } // end of namespace JSC
@@ -35,6 +35,7 @@
 namespace JSC {
 
 class ExecState;
+class JSArrayBufferView;
 class JSObject;
 
 namespace Bindings {
@@ -44,7 +45,13 @@ class RootObject;
 jvalue convertValueToJValue(ExecState*, RootObject*, JSValue, JavaType, const char* javaClassName);
 jobject convertUndefinedToJObject();
 
+// Bulk transfers between Java primitive arrays and typed arrays, one JNI call each.
+JSValue convertJavaArrayToTypedArray(ExecState*, jarray, JavaType elementType, unsigned length);
+bool copyTypedArrayToJavaArray(JSArrayBufferView*, jarray, JavaType elementType);
+
  jthrowable dispatchJNICall(int, RootObject *rootObject, jobject, bool isStatic, JavaType returnType, jmethodID, jobject* args, jvalue& result, jobject accessControlContext);
+bool canDispatchJNICallDirectly();
+jthrowable dispatchJNICallDirect(jobject, JavaType returnType, jmethodID, jvalue* args, jvalue& result);
 
 jobject jvalueToJObject(jvalue value, JavaType);
 
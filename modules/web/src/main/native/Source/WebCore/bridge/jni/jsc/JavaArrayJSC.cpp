@@ -273,4 +273,30 @@ unsigned int JavaArray::getLength() const
     return m_length;
 }
 
+JSValue JavaArray::copyToTypedArray(ExecState* exec) const
+{
+    // Since javaArray() is WeakGlobalRef, creating a localref to safeguard instance() from GC
+    JLObject jlinstance(javaArray(), true);
+
+    if (!jlinstance) {
+        LOG_ERROR("Could not get javaInstance for %p in JavaArray::copyToTypedArray", (jobject)jlinstance);
+        return JSValue();
+    }
+
+    return convertJavaArrayToTypedArray(exec, static_cast<jarray>(javaArray()), javaTypeFromPrimitiveType(m_type[1]), m_length);
+}
+
+bool JavaArray::copyFromTypedArray(ExecState*, JSArrayBufferView* view) const
+{
+    // Since javaArray() is WeakGlobalRef, creating a localref to safeguard instance() from GC
+    JLObject jlinstance(javaArray(), true);
+
+    if (!jlinstance) {
+        LOG_ERROR("Could not get javaInstance for %p in JavaArray::copyFromTypedArray", (jobject)jlinstance);
+        return false;
+    }
+
+    return copyTypedArrayToJavaArray(view, static_cast<jarray>(javaArray()), javaTypeFromPrimitiveType(m_type[1]));
+}
+
 #endif // ENABLE(JAVA_BRIDGE)
@@ -49,6 +49,9 @@ public:
     virtual JSValue valueAt(ExecState*, unsigned int index) const;
     virtual unsigned int getLength() const;
 
+    virtual JSValue copyToTypedArray(ExecState*) const;
+    virtual bool copyFromTypedArray(ExecState*, JSArrayBufferView*) const;
+
     jobject javaArray() const { return m_array->instance(); }
     jobject accessControlContext() const { return m_accessControlContext->instance(); }
 
@@ -34,10 +34,130 @@
 #include "JNIUtilityPrivate.h"
 #include <runtime/Identifier.h>
 #include <runtime/JSLock.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
 
 using namespace JSC;
 using namespace JSC::Bindings;
 
+namespace {
+
+struct JavaClassCacheEntry {
+    jweak classRef;
+    RefPtr<JavaClass> javaClass;
+    double reflectionTime;
+};
+
+// Buckets are keyed by the identity hash of the java.lang.Class, and the weak
+// references tell apart classes that share a hash and classes that were unloaded.
+typedef HashMap<uint64_t, Vector<JavaClassCacheEntry>, WTF::IntHash<uint64_t>, WTF::UnsignedWithZeroKeyHashTraits<uint64_t>> JavaClassCache;
+
+const unsigned missesBetweenSweeps = 256;
+
+}
+
+static StaticLock javaClassCacheLock;
+static JavaClass::CacheStatistics javaClassCacheStatistics;
+static unsigned javaClassCacheMissesSinceSweep;
+
+static JavaClassCache& javaClassCache()
+{
+    static NeverDestroyed<JavaClassCache> cache;
+    return cache;
+}
+
+static bool isUnloaded(JNIEnv* env, const JavaClassCacheEntry& entry)
+{
+    if (!env->IsSameObject(entry.classRef, NULL))
+        return false;
+    env->DeleteWeakGlobalRef(entry.classRef);
+    return true;
+}
+
+static void sweepUnloadedClasses(JNIEnv* env)
+{
+    Vector<uint64_t> emptyBuckets;
+    for (auto& bucket : javaClassCache()) {
+        bucket.value.removeAllMatching([env] (const JavaClassCacheEntry& entry) {
+            return isUnloaded(env, entry);
+        });
+        if (bucket.value.isEmpty())
+            emptyBuckets.append(bucket.key);
+    }
+    for (uint64_t key : emptyBuckets)
+        javaClassCache().remove(key);
+}
+
+static JavaClassCacheEntry* findCachedClass(JNIEnv* env, Vector<JavaClassCacheEntry>& bucket, jclass aClass)
+{
+    for (size_t i = 0; i < bucket.size(); ) {
+        if (isUnloaded(env, bucket[i])) {
+            bucket.remove(i);
+            continue;
+        }
+        if (env->IsSameObject(bucket[i].classRef, aClass))
+            return &bucket[i];
+        ++i;
+    }
+    return nullptr;
+}
+
+Ref<JavaClass> JavaClass::classForInstance(jobject anInstance, RootObject* rootObject, jobject accessControlContext)
+{
+    // Since anInstance is WeakGlobalRef, creating a localref to safeguard instance() from GC
+    JLObject jlinstance(anInstance, true);
+
+    // Under a security manager what reflection returns depends on the access
+    // control context, so each instance reflects its class itself.
+    if (!jlinstance || !canDispatchJNICallDirectly())
+        return adoptRef(*new JavaClass(anInstance, rootObject, accessControlContext));
+
+    JNIEnv* env = getJNIEnv();
+    static JGClass systemCls(env->FindClass("java/lang/System"));
+    static jmethodID identityHashCode = env->GetStaticMethodID(systemCls, "identityHashCode", "(Ljava/lang/Object;)I");
+
+    JLClass aClass(env->GetObjectClass(anInstance));
+    uint64_t key = static_cast<uint32_t>(env->CallStaticIntMethod(systemCls, identityHashCode, static_cast<jclass>(aClass)));
+
+    {
+        std::lock_guard<StaticLock> lock(javaClassCacheLock);
+        auto it = javaClassCache().find(key);
+        if (it != javaClassCache().end()) {
+            if (JavaClassCacheEntry* entry = findCachedClass(env, it->value, aClass)) {
+                javaClassCacheStatistics.hits++;
+                javaClassCacheStatistics.reflectionSecondsSaved += entry->reflectionTime;
+                return *entry->javaClass;
+            }
+        }
+    }
+
+    // Reflect without holding the lock, since it calls back into Java.
+    double start = monotonicallyIncreasingTime();
+    Ref<JavaClass> javaClass = adoptRef(*new JavaClass(anInstance, rootObject, accessControlContext));
+    double reflectionTime = monotonicallyIncreasingTime() - start;
+
+    std::lock_guard<StaticLock> lock(javaClassCacheLock);
+    javaClassCacheStatistics.misses++;
+    if (++javaClassCacheMissesSinceSweep >= missesBetweenSweeps) {
+        javaClassCacheMissesSinceSweep = 0;
+        sweepUnloadedClasses(env);
+    }
+
+    Vector<JavaClassCacheEntry>& bucket = javaClassCache().add(key, Vector<JavaClassCacheEntry>()).iterator->value;
+    // Another thread may have reflected the same class in the meantime.
+    if (JavaClassCacheEntry* entry = findCachedClass(env, bucket, aClass))
+        return *entry->javaClass;
+    bucket.append(JavaClassCacheEntry { env->NewWeakGlobalRef(aClass), javaClass.ptr(), reflectionTime });
+    return javaClass;
+}
+
+JavaClass::CacheStatistics JavaClass::cacheStatistics()
+{
+    std::lock_guard<StaticLock> lock(javaClassCacheLock);
+    return javaClassCacheStatistics;
+}
+
 JavaClass::JavaClass(jobject anInstance, RootObject* rootObject, jobject accessControlContext)
 {
     // Since anInstance is WeakGlobalRef, creating a localref to safeguard instance() from GC
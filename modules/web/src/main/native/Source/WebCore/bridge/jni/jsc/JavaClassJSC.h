@@ -31,14 +31,26 @@
 #include "BridgeJSC.h"
 #include "JNIUtility.h"
 #include <wtf/HashMap.h>
+#include <wtf/ThreadSafeRefCounted.h>
 
 namespace JSC {
 
 namespace Bindings {
 
-class JavaClass : public Class {
+class JavaClass : public Class, public ThreadSafeRefCounted<JavaClass> {
+    WTF_MAKE_FAST_ALLOCATED;
 public:
-    JavaClass(jobject, RootObject*, jobject accessControlContext);
+    // Reflects the class of the instance once and shares the result with every
+    // later instance of the same class, until the class is unloaded.
+    static Ref<JavaClass> classForInstance(jobject, RootObject*, jobject accessControlContext);
+
+    struct CacheStatistics {
+        uint64_t hits;
+        uint64_t misses;
+        double reflectionSecondsSaved;
+    };
+    static CacheStatistics cacheStatistics();
+
     ~JavaClass();
 
     virtual Method* methodNamed(PropertyName, Instance*) const;
@@ -50,6 +62,8 @@ public:
     bool isStringClass() const;
 
 private:
+    JavaClass(jobject, RootObject*, jobject accessControlContext);
+
     jobject createDummyObject();
     const char* m_name;
     mutable FieldMap m_fields;
@@ -65,22 +65,123 @@ JavaField::JavaField(JNIEnv* env, jobject aField)
     m_name = JavaString(env, fieldName);
     env->DeleteLocalRef(fieldName);
 
-    m_field = JobjectWrapper::create(aField);
+    // The reflected Field is only weakly reachable from here, so keep its ID,
+    // which stays valid for as long as the class is loaded.
+    m_fieldID = env->FromReflectedField(aField);
+
+    jint modifiers = callJNIMethod<jint>(aField, "getModifiers", "()I");
+    m_isStatic = (modifiers & 0x8) != 0;
+
+    // Field.get and Field.set allow any caller to access a public field of a
+    // public class, except for setting a final field, so those can skip
+    // reflection. Static fields go through reflection as well, since they are
+    // read without an instance.
+    m_isDirectlyReadable = false;
+    m_isDirectlyWritable = false;
+    if (jobject declaringClass = callJNIMethod<jobject>(aField, "getDeclaringClass", "()Ljava/lang/Class;")) {
+        jint classModifiers = callJNIMethod<jint>(declaringClass, "getModifiers", "()I");
+        m_isDirectlyReadable = !m_isStatic && (modifiers & 0x1) && (classModifiers & 0x1);
+        m_isDirectlyWritable = m_isDirectlyReadable && !(modifiers & 0x10);
+        env->DeleteLocalRef(declaringClass);
+    }
 }
 
-JSValue JavaField::valueFromInstance(ExecState* exec, const Instance* i) const
+jobject JavaField::reflectedField(JNIEnv* env, jobject instance) const
 {
-    const JavaInstance* instance = static_cast<const JavaInstance*>(i);
+    JLClass instanceClass(env->GetObjectClass(instance));
+    return env->ToReflectedField(instanceClass, m_fieldID, m_isStatic);
+}
 
-    JSValue jsresult = jsUndefined();
-    jobject jfield = m_field->instance();
-    // Since jfield is WeakGlobalRef, creating a localref to safeguard instance() from GC
-    JLObject jlfield(jfield, true);
+jvalue JavaField::directValue(JNIEnv* env, jobject instance) const
+{
+    jvalue result;
+    result.l = 0;
+    switch (m_type) {
+    case JavaTypeArray:
+    case JavaTypeObject:
+        result.l = env->GetObjectField(instance, m_fieldID);
+        break;
+    case JavaTypeChar:
+        // Boxed into a Character, as Field.get returns it.
+        result.c = env->GetCharField(instance, m_fieldID);
+        result.l = jvalueToJObject(result, JavaTypeChar);
+        break;
+    case JavaTypeBoolean:
+        result.z = env->GetBooleanField(instance, m_fieldID);
+        break;
+    case JavaTypeByte:
+        result.b = env->GetByteField(instance, m_fieldID);
+        break;
+    case JavaTypeShort:
+        result.s = env->GetShortField(instance, m_fieldID);
+        break;
+    case JavaTypeInt:
+        result.i = env->GetIntField(instance, m_fieldID);
+        break;
+    case JavaTypeLong:
+        result.j = env->GetLongField(instance, m_fieldID);
+        break;
+    case JavaTypeFloat:
+        result.f = env->GetFloatField(instance, m_fieldID);
+        break;
+    case JavaTypeDouble:
+        result.d = env->GetDoubleField(instance, m_fieldID);
+        break;
+    default:
+        break;
+    }
+    return result;
+}
 
+jvalue JavaField::reflectedValue(JNIEnv* env, jobject instance) const
+{
+    jvalue result;
+    result.l = 0;
+    JLObject jlfield(reflectedField(env, instance));
     if (!jlfield) {
-        LOG_ERROR("Could not get javaInstance for %p in JavaField::valueFromInstance", (jobject)jlfield);
-        return jsresult;
+        LOG_ERROR("Could not get reflected field for %p in JavaField::reflectedValue", instance);
+        return result;
     }
+    jobject jfield = jlfield;
+
+    switch (m_type) {
+    case JavaTypeArray:
+    case JavaTypeObject:
+    case JavaTypeChar:
+        result.l = callJNIMethod<jobject>(jfield, "get", "(Ljava/lang/Object;)Ljava/lang/Object;", instance);
+        break;
+    case JavaTypeBoolean:
+        result.z = callJNIMethod<jboolean>(jfield, "getBoolean", "(Ljava/lang/Object;)Z", instance);
+        break;
+    case JavaTypeByte:
+        result.b = callJNIMethod<jbyte>(jfield, "getByte", "(Ljava/lang/Object;)B", instance);
+        break;
+    case JavaTypeShort:
+        result.s = callJNIMethod<jshort>(jfield, "getShort", "(Ljava/lang/Object;)S", instance);
+        break;
+    case JavaTypeInt:
+        result.i = callJNIMethod<jint>(jfield, "getInt", "(Ljava/lang/Object;)I", instance);
+        break;
+    case JavaTypeLong:
+        result.j = callJNIMethod<jlong>(jfield, "getLong", "(Ljava/lang/Object;)J", instance);
+        break;
+    case JavaTypeFloat:
+        result.f = callJNIMethod<jfloat>(jfield, "getFloat", "(Ljava/lang/Object;)F", instance);
+        break;
+    case JavaTypeDouble:
+        result.d = callJNIMethod<jdouble>(jfield, "getDouble", "(Ljava/lang/Object;)D", instance);
+        break;
+    default:
+        break;
+    }
+    return result;
+}
+
+JSValue JavaField::valueFromInstance(ExecState* exec, const Instance* i) const
+{
+    const JavaInstance* instance = static_cast<const JavaInstance*>(i);
+
+    JSValue jsresult = jsUndefined();
 
     jobject jinstance = instance->javaInstance();
     // Since jinstance is WeakGlobalRef, creating a localref to safeguard instance() from GC
@@ -91,6 +192,9 @@ JSValue JavaField::valueFromInstance(ExecState* exec, const Instance* i) const
         return jsresult;
     }
 
+    JNIEnv* env = getJNIEnv();
+    jvalue value = m_isDirectlyReadable ? directValue(env, jlinstance) : reflectedValue(env, jlinstance);
+
     switch (m_type) {
     case JavaTypeArray:
     case JavaTypeObject:
@@ -98,7 +202,7 @@ JSValue JavaField::valueFromInstance(ExecState* exec, const Instance* i) const
     // to treat it as JS foreign object.
     case JavaTypeChar:
         {
-            jobject anObject = callJNIMethod<jobject>(jfield, "get", "(Ljava/lang/Object;)Ljava/lang/Object;", jinstance);
+            jobject anObject = value.l;
             if (!anObject)
                 return jsNull();
 
@@ -112,30 +216,30 @@ JSValue JavaField::valueFromInstance(ExecState* exec, const Instance* i) const
         break;
 
     case JavaTypeBoolean:
-        jsresult = jsBoolean(callJNIMethod<jboolean>(jfield, "getBoolean", "(Ljava/lang/Object;)Z", jinstance));
+        jsresult = jsBoolean(value.z);
         break;
 
     case JavaTypeByte:
-        jsresult = jsNumber(callJNIMethod<jbyte>(jfield, "getByte", "(Ljava/lang/Object;)B", jinstance));
+        jsresult = jsNumber(value.b);
         break;
 
     case JavaTypeShort:
-        jsresult = jsNumber(callJNIMethod<jshort>(jfield, "getShort", "(Ljava/lang/Object;)S", jinstance));
+        jsresult = jsNumber(value.s);
         break;
 
     case JavaTypeInt:
-        jsresult = jsNumber(static_cast<int>(callJNIMethod<jint>(jfield, "getInt", "(Ljava/lang/Object;)I", jinstance)));
+        jsresult = jsNumber(static_cast<int>(value.i));
         break;
 
     case JavaTypeLong:
-        jsresult = jsNumber(static_cast<double>(callJNIMethod<jlong>(jfield, "getLong", "(Ljava/lang/Object;)J", jinstance)));
+        jsresult = jsNumber(static_cast<double>(value.j));
         break;
     case JavaTypeFloat:
-        jsresult = jsNumber(static_cast<double>(callJNIMethod<jfloat>(jfield, "getFloat", "(Ljava/lang/Object;)F", jinstance)));
+        jsresult = jsNumber(static_cast<double>(value.f));
         break;
 
     case JavaTypeDouble:
-        jsresult = jsNumber(static_cast<double>(callJNIMethod<jdouble>(jfield, "getDouble", "(Ljava/lang/Object;)D", jinstance)));
+        jsresult = jsNumber(static_cast<double>(value.d));
         break;
 
     default:
@@ -153,15 +257,6 @@ void JavaField::setValueToInstance(ExecState* exec, const Instance* i, JSValue a
     jvalue javaValue = convertValueToJValue(exec, i->rootObject(), aValue, m_type, typeClassName());
     LOG(LiveConnect, "JavaField::setValueToInstance setting value %s to %s", String(name().impl()).utf8().data(), aValue.toString(exec)->value(exec).ascii().data());
 
-    jobject jfield = m_field->instance();
-    // Since jfield is WeakGlobalRef, creating a localref to safeguard instance() from GC
-    JLObject jlfield(jfield, true);
-
-    if (!jlfield) {
-        LOG_ERROR("Could not get Instance for %p in JavaField::setValueToInstance", (jobject)jlfield);
-        return;
-    }
-
     jobject jinstance = instance->javaInstance();
     // Since jinstance is WeakGlobalRef, creating a localref to safeguard javaInstance() from GC
     JLObject jlinstance(jinstance, true);
@@ -170,6 +265,20 @@ void JavaField::setValueToInstance(ExecState* exec, const Instance* i, JSValue a
         LOG_ERROR("Could not get javaInstance for %p in JavaField::setValueToInstance", (jobject)jlinstance);
         return;
     }
+    jinstance = jlinstance;
+
+    JNIEnv* env = getJNIEnv();
+    if (m_isDirectlyWritable) {
+        setValueDirectly(env, jinstance, javaValue);
+        return;
+    }
+
+    JLObject jlfield(reflectedField(env, jinstance));
+    if (!jlfield) {
+        LOG_ERROR("Could not get reflected field for %p in JavaField::setValueToInstance", jinstance);
+        return;
+    }
+    jobject jfield = jlfield;
 
     switch (m_type) {
     case JavaTypeArray:
@@ -214,4 +323,40 @@ void JavaField::setValueToInstance(ExecState* exec, const Instance* i, JSValue a
     }
 }
 
+void JavaField::setValueDirectly(JNIEnv* env, jobject instance, jvalue value) const
+{
+    switch (m_type) {
+    case JavaTypeArray:
+    case JavaTypeObject:
+        env->SetObjectField(instance, m_fieldID, value.l);
+        break;
+    case JavaTypeBoolean:
+        env->SetBooleanField(instance, m_fieldID, value.z);
+        break;
+    case JavaTypeByte:
+        env->SetByteField(instance, m_fieldID, value.b);
+        break;
+    case JavaTypeChar:
+        env->SetCharField(instance, m_fieldID, value.c);
+        break;
+    case JavaTypeShort:
+        env->SetShortField(instance, m_fieldID, value.s);
+        break;
+    case JavaTypeInt:
+        env->SetIntField(instance, m_fieldID, value.i);
+        break;
+    case JavaTypeLong:
+        env->SetLongField(instance, m_fieldID, value.j);
+        break;
+    case JavaTypeFloat:
+        env->SetFloatField(instance, m_fieldID, value.f);
+        break;
+    case JavaTypeDouble:
+        env->SetDoubleField(instance, m_fieldID, value.d);
+        break;
+    default:
+        abort();
+    }
+}
+
 #endif // ENABLE(JAVA_BRIDGE)
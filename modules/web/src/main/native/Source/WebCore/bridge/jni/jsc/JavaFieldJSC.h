@@ -51,10 +51,18 @@ public:
     JavaType type() const { return m_type; }
 
 private:
+    jobject reflectedField(JNIEnv*, jobject instance) const;
+    jvalue directValue(JNIEnv*, jobject instance) const;
+    jvalue reflectedValue(JNIEnv*, jobject instance) const;
+    void setValueDirectly(JNIEnv*, jobject instance, jvalue) const;
+
     JavaString m_name;
     JavaString m_typeClassName;
     JavaType m_type;
-    RefPtr<JobjectWrapper> m_field;
+    jfieldID m_fieldID;
+    bool m_isStatic;
+    bool m_isDirectlyReadable;
+    bool m_isDirectlyWritable;
 };
 
 } // namespace Bindings
@@ -55,13 +55,11 @@ JavaInstance::JavaInstance(jobject instance, PassRefPtr<RootObject> rootObject,
     : Instance(rootObject)
 {
     m_instance = JobjectWrapper::create(instance);
-    m_class = 0;
     m_accessControlContext = JobjectWrapper::create(accessControlContext, true);
 }
 
 JavaInstance::~JavaInstance()
 {
-    delete m_class;
 }
 
 RuntimeObject* JavaInstance::newRuntimeObject(ExecState* exec)
@@ -85,9 +83,9 @@ Class* JavaInstance::getClass() const
 {
     if (!m_class) {
         jobject acc = accessControlContext();
-        m_class = new JavaClass(m_instance->instance(), rootObject(), acc);
+        m_class = JavaClass::classForInstance(m_instance->instance(), rootObject(), acc);
     }
-    return m_class;
+    return m_class.get();
 }
 
 JSValue JavaInstance::stringValue(ExecState* exec) const
@@ -293,14 +291,11 @@ JSValue JavaInstance::invokeMethod(ExecState* exec, RuntimeMethod* runtimeMethod
         return jsUndefined();
     }
 
-    Vector<jobject> jArgs(count);
+    Vector<jvalue> jValues(count);
 
     for (int i = 0; i < count; i++) {
-        CString javaClassName = jMethod->parameterAt(i).utf8();
-        JavaType jtype = javaTypeFromClassName(javaClassName.data());
-        jvalue jarg = convertValueToJValue(exec, m_rootObject.get(),
-            exec->argument(i), jtype, javaClassName.data());
-        jArgs[i] = jvalueToJObject(jarg, jtype);
+        jValues[i] = convertValueToJValue(exec, m_rootObject.get(),
+            exec->argument(i), jMethod->parameterTypeAt(i), jMethod->parameterClassNameAt(i));
         LOG(LiveConnect, "JavaInstance::invokeMethod arg[%d] = %s", i, exec->argument(i).toString(exec)->value(exec).ascii().data());
     }
 
@@ -327,13 +322,21 @@ JSValue JavaInstance::invokeMethod(ExecState* exec, RuntimeMethod* runtimeMethod
         }
 
         // const char *callingURL = 0; // FIXME, need to propagate calling URL to Java
-        jmethodID methodId = getMethodID(obj, jMethod->name().utf8().data(), jMethod->signature());
-
-        jthrowable ex = dispatchJNICall(exec->argumentCount(), rootObject,
-                                        obj, jMethod->isStatic(),
-                                        jMethod->returnType(), methodId,
-                                        jArgs.data(), result,
-                                        accessControlContext());
+        jthrowable ex;
+        if (jMethod->isDirectlyCallable() && canDispatchJNICallDirectly()) {
+            ex = dispatchJNICallDirect(obj, jMethod->returnType(), jMethod->methodID(),
+                                       jValues.data(), result);
+        } else {
+            Vector<jobject> jArgs(count);
+            for (int i = 0; i < count; i++)
+                jArgs[i] = jvalueToJObject(jValues[i], jMethod->parameterTypeAt(i));
+
+            ex = dispatchJNICall(exec->argumentCount(), rootObject,
+                                 obj, jMethod->isStatic(),
+                                 jMethod->returnType(), jMethod->methodID(),
+                                 jArgs.data(), result,
+                                 accessControlContext());
+        }
         if (ex != NULL) {
           JSValue exceptionDescription
             = (JavaInstance::create(ex, rootObject, accessControlContext())
@@ -72,7 +72,7 @@ protected:
     virtual void virtualEnd();
 
     RefPtr<JobjectWrapper> m_instance;
-    mutable JavaClass* m_class;
+    mutable RefPtr<JavaClass> m_class;
     RefPtr<JobjectWrapper> m_accessControlContext;
 };
 
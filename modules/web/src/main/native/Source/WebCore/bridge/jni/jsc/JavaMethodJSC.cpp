@@ -66,6 +66,8 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
             if (!parameterName)
                 parameterName = env->NewStringUTF("<Unknown>");
             m_parameters.append(JavaString(env, parameterName).impl());
+            m_parameterClassNames.append(m_parameters.last().utf8());
+            m_parameterTypes.append(javaTypeFromClassName(m_parameterClassNames.last().data()));
             env->DeleteLocalRef(aParameter);
             env->DeleteLocalRef(parameterName);
         }
@@ -77,6 +79,37 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
 
     jint modifiers = callJNIMethod<jint>(aMethod, "getModifiers", "()I");
     m_isStatic = (modifiers & 0x8) != 0;
+
+    m_methodID = env->FromReflectedMethod(aMethod);
+
+    m_isDirectlyCallable = false;
+    if (jobject declaringClass = callJNIMethod<jobject>(aMethod, "getDeclaringClass", "()Ljava/lang/Class;")) {
+        jint classModifiers = callJNIMethod<jint>(declaringClass, "getModifiers", "()I");
+        if (jstring declaringClassName = static_cast<jstring>(callJNIMethod<jobject>(declaringClass, "getName", "()Ljava/lang/String;"))) {
+            m_isDirectlyCallable = !m_isStatic && (modifiers & 0x1) && (classModifiers & 0x1)
+                && !isPlatformClass(JavaString(env, declaringClassName).impl());
+            env->DeleteLocalRef(declaringClassName);
+        }
+        env->DeleteLocalRef(declaringClass);
+    }
+}
+
+// fwkInvokeWithContext calls through sun.reflect.misc.Trampoline, so a
+// caller-sensitive platform method such as AccessibleObject.setAccessible,
+// Field.get or Class.newInstance sees an unprivileged caller. Called straight
+// through JNI it would see the javafx.web frame instead, and the Trampoline
+// also refuses Method, AccessController and java.lang.invoke outright. Methods
+// declared by platform classes therefore always stay on the reflective path.
+bool JavaMethod::isPlatformClass(const String& declaringClassName)
+{
+    static const char* const platformPackages[] = {
+        "java.", "javax.", "javafx.", "jdk.", "sun.", "com.sun."
+    };
+    for (const char* package : platformPackages) {
+        if (declaringClassName.startsWith(package))
+            return true;
+    }
+    return false;
 }
 
 JavaMethod::~JavaMethod()
@@ -111,14 +144,14 @@ const char* JavaMethod::signature() const
         StringBuilder signatureBuilder;
         signatureBuilder.append('(');
         for (unsigned int i = 0; i < m_parameters.size(); i++) {
-            CString javaClassName = parameterAt(i).utf8();
-            JavaType type = javaTypeFromClassName(javaClassName.data());
+            const char* javaClassName = parameterClassNameAt(i);
+            JavaType type = parameterTypeAt(i);
             if (type == JavaTypeArray)
-                appendClassName(signatureBuilder, javaClassName.data());
+                appendClassName(signatureBuilder, javaClassName);
             else {
                 signatureBuilder.append(signatureFromJavaType(type));
                 if (type == JavaTypeObject) {
-                    appendClassName(signatureBuilder, javaClassName.data());
+                    appendClassName(signatureBuilder, javaClassName);
                     signatureBuilder.append(';');
                 }
             }
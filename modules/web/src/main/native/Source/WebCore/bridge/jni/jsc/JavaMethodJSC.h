@@ -32,6 +32,7 @@
 #include "Bridge.h"
 #include "JavaStringJSC.h"
 #include "JavaType.h"
+#include <wtf/text/CString.h>
 
 namespace JSC {
 
@@ -47,20 +48,32 @@ public:
     const String name() const { return m_name.impl(); }
     RuntimeType returnTypeClassName() const { return m_returnTypeClassName.utf8(); }
     const String parameterAt(int i) const { return m_parameters[i]; }
+    JavaType parameterTypeAt(int i) const { return m_parameterTypes[i]; }
+    const char* parameterClassNameAt(int i) const { return m_parameterClassNames[i].data(); }
     const char* signature() const;
     JavaType returnType() const { return m_returnType; }
     bool isStatic() const { return m_isStatic; }
+    jmethodID methodID() const { return m_methodID; }
+    // Public instance methods of public application classes can skip reflection
+    // when no security manager is installed.
+    bool isDirectlyCallable() const { return m_isDirectlyCallable; }
 
     // Method implementation
     int numParameters() const { return m_parameters.size(); }
 
 private:
+    static bool isPlatformClass(const String& declaringClassName);
+
     Vector<WTF::String> m_parameters;
+    Vector<JavaType> m_parameterTypes;
+    Vector<CString> m_parameterClassNames;
     JavaString m_name;
     mutable char* m_signature;
     JavaString m_returnTypeClassName;
     JavaType m_returnType;
+    jmethodID m_methodID;
     bool m_isStatic;
+    bool m_isDirectlyCallable;
 };
 
 } // namespace Bindings
@@ -38,6 +38,7 @@ namespace JSC  {
 
 class ArgList;
 class Identifier;
+class JSArrayBufferView;
 class JSGlobalObject;
 class PropertyNameArray;
 class RuntimeMethod;
@@ -128,6 +129,11 @@ public:
     virtual JSValue valueAt(ExecState*, unsigned index) const = 0;
     virtual unsigned int getLength() const = 0;
 
+    // Bulk copies to and from a typed array. Arrays that have no typed array
+    // representation return an empty value and false.
+    virtual JSValue copyToTypedArray(ExecState*) const { return JSValue(); }
+    virtual bool copyFromTypedArray(ExecState*, JSArrayBufferView*) const { return false; }
+
 protected:
     RefPtr<RootObject> m_rootObject;
 };
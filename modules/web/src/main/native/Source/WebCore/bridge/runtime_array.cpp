@@ -28,6 +28,7 @@
 
 #include <runtime/ArrayPrototype.h>
 #include <runtime/Error.h>
+#include <runtime/JSArrayBufferView.h>
 #include <runtime/PropertyNameArray.h>
 #include "JSDOMBinding.h"
 
@@ -37,6 +38,51 @@ namespace JSC {
 
 const ClassInfo RuntimeArray::s_info = { "RuntimeArray", &Base::s_info, 0, CREATE_METHOD_TABLE(RuntimeArray) };
 
+static EncodedJSValue JSC_HOST_CALL runtimeArrayProtoFuncToTypedArray(ExecState*);
+static EncodedJSValue JSC_HOST_CALL runtimeArrayProtoFuncCopyFrom(ExecState*);
+
+// Runtime arrays keep the Array prototype methods and add bulk copies to and
+// from typed arrays, which avoid a bridge call per element.
+JSObject* RuntimeArray::createPrototype(VM& vm, JSGlobalObject* globalObject)
+{
+    JSObject* prototype = JSFinalObject::create(vm, JSFinalObject::createStructure(vm, globalObject, globalObject->arrayPrototype(), JSFinalObject::defaultInlineCapacity()));
+    prototype->putDirectNativeFunction(vm, globalObject, Identifier::fromString(&vm, "toTypedArray"), 0, runtimeArrayProtoFuncToTypedArray, NoIntrinsic, DontEnum);
+    prototype->putDirectNativeFunction(vm, globalObject, Identifier::fromString(&vm, "copyFrom"), 1, runtimeArrayProtoFuncCopyFrom, NoIntrinsic, DontEnum);
+    return prototype;
+}
+
+// Returns a typed array holding a copy of the elements. Later writes to either
+// array are not reflected in the other; use copyFrom() to write back.
+EncodedJSValue JSC_HOST_CALL runtimeArrayProtoFuncToTypedArray(ExecState* exec)
+{
+    RuntimeArray* thisObject = jsDynamicCast<RuntimeArray*>(exec->thisValue());
+    if (!thisObject)
+        return throwVMTypeError(exec);
+
+    JSValue result = thisObject->getConcreteArray()->copyToTypedArray(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+    if (!result)
+        return throwVMTypeError(exec, "Array has no typed array representation");
+    return JSValue::encode(result);
+}
+
+EncodedJSValue JSC_HOST_CALL runtimeArrayProtoFuncCopyFrom(ExecState* exec)
+{
+    RuntimeArray* thisObject = jsDynamicCast<RuntimeArray*>(exec->thisValue());
+    if (!thisObject)
+        return throwVMTypeError(exec);
+
+    JSArrayBufferView* view = jsDynamicCast<JSArrayBufferView*>(exec->argument(0));
+    if (!view)
+        return throwVMTypeError(exec, "Argument is not a typed array");
+    if (view->length() > thisObject->getLength())
+        return throwVMRangeError(exec, "Typed array is longer than the array");
+    if (!thisObject->getConcreteArray()->copyFromTypedArray(exec, view))
+        return throwVMTypeError(exec, "Array has no typed array representation");
+    return JSValue::encode(jsUndefined());
+}
+
 RuntimeArray::RuntimeArray(ExecState* exec, Structure* structure)
     : JSArray(exec->vm(), structure, 0)
     , m_array(0)
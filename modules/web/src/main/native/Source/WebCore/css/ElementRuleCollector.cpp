@@ -43,6 +43,7 @@
 #include "SVGElement.h"
 #include "SelectorCompiler.h"
 #include "SelectorFilter.h"
+#include "SelectorProgram.h"
 #include "ShadowRoot.h"
 #include "StyleProperties.h"
 #include "StyledElement.h"
@@ -445,9 +446,18 @@ inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData, unsigned
                 return false;
         }
 #endif
-        // Slow path.
-        SelectorChecker selectorChecker(m_element.document());
-        selectorMatches = selectorChecker.match(*selector, m_element, context, specificity);
+#if !ENABLE(CSS_SELECTOR_JIT)
+        const SelectorProgram* selectorProgram = selector == ruleData.selector() && context.pseudoId == NOPSEUDO ? ruleData.selectorProgram() : nullptr;
+        if (selectorProgram) {
+            specificity = selectorProgram->specificity();
+            selectorMatches = selectorProgram->matches(m_element, context);
+        } else
+#endif
+        {
+            // Slow path.
+            SelectorChecker selectorChecker(m_element.document());
+            selectorMatches = selectorChecker.match(*selector, m_element, context, specificity);
+        }
     }
 
     commitStyleRelations(context.styleRelations);
@@ -24,6 +24,7 @@
 
 #include "RuleFeature.h"
 #include "SelectorCompiler.h"
+#include "SelectorProgram.h"
 #include "StyleRule.h"
 #include <wtf/Forward.h>
 #include <wtf/HashMap.h>
@@ -102,6 +103,16 @@ public:
     }
     void compiledSelectorUsed() const { m_compiledSelectorUseCount++; }
 #endif
+#else
+    // Compiled on first use, null if the selector needs SelectorChecker.
+    const SelectorProgram* selectorProgram() const
+    {
+        if (!m_selectorProgramCompiled) {
+            m_selectorProgram = SelectorProgram::compile(*selector());
+            m_selectorProgramCompiled = true;
+        }
+        return m_selectorProgram.get();
+    }
 #endif // ENABLE(CSS_SELECTOR_JIT)
 
 private:
@@ -116,6 +127,9 @@ private:
     unsigned m_containsUncommonAttributeSelector : 1;
     unsigned m_linkMatchType : 2; //  SelectorChecker::LinkMatchMask
     unsigned m_propertyWhitelistType : 2;
+#if !ENABLE(CSS_SELECTOR_JIT)
+    mutable unsigned m_selectorProgramCompiled : 1;
+#endif
     // Use plain array instead of a Vector to minimize memory overhead.
     unsigned m_descendantSelectorIdentifierHashes[maximumIdentifierCount];
 #if ENABLE(CSS_SELECTOR_JIT)
@@ -124,6 +138,8 @@ private:
 #if CSS_SELECTOR_JIT_PROFILING
     mutable unsigned m_compiledSelectorUseCount;
 #endif
+#else
+    mutable RefPtr<SelectorProgram> m_selectorProgram;
 #endif // ENABLE(CSS_SELECTOR_JIT)
 };
 
@@ -135,6 +151,8 @@ struct SameSizeAsRuleData {
 #if CSS_SELECTOR_JIT_PROFILING
     unsigned compiledSelectorUseCount;
 #endif
+#else
+    void* selectorProgram;
 #endif // ENABLE(CSS_SELECTOR_JIT)
 
     void* a;
@@ -411,7 +411,7 @@ SelectorChecker::MatchResult SelectorChecker::matchRecursively(CheckingContext&
     return MatchResult::fails(Match::SelectorFailsCompletely);
 }
 
-static bool attributeValueMatches(const Attribute& attribute, CSSSelector::Match match, const AtomicString& selectorValue, bool caseSensitive)
+bool SelectorChecker::attributeValueMatches(const Attribute& attribute, CSSSelector::Match match, const AtomicString& selectorValue, bool caseSensitive)
 {
     const AtomicString& value = attribute.value();
     ASSERT(!value.isNull());
@@ -512,7 +512,7 @@ static bool anyAttributeMatches(const Element& element, const CSSSelector& selec
         if (!attribute.matches(selectorAttr.prefix(), element.isHTMLElement() ? selector.attributeCanonicalLocalName() : selectorAttr.localName(), selectorAttr.namespaceURI()))
             continue;
 
-        if (attributeValueMatches(attribute, selector.match(), selector.value(), caseSensitive))
+        if (SelectorChecker::attributeValueMatches(attribute, selector.match(), selector.value(), caseSensitive))
             return true;
     }
 
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SelectorProgram.h"
+
+#if !ENABLE(CSS_SELECTOR_JIT)
+
+#include "CSSSelector.h"
+#include "Document.h"
+#include "Element.h"
+#include "HTMLDocument.h"
+
+namespace WebCore {
+
+RefPtr<SelectorProgram> SelectorProgram::compile(const CSSSelector& firstSelector)
+{
+    bool specificityIsStatic = true;
+    unsigned specificity = firstSelector.staticSpecificity(specificityIsStatic);
+    if (!specificityIsStatic)
+        return nullptr;
+
+    Vector<Instruction> instructions;
+    for (const CSSSelector* selector = &firstSelector; selector; selector = selector->tagHistory()) {
+        Instruction instruction = { Opcode::Matched, false, false, selector, nullptr, nullptr };
+
+        switch (selector->match()) {
+        case CSSSelector::Tag: {
+            // *|* parses with a non-null prefix, so it is not anyQName() but matches anything too.
+            const QualifiedName& tagQName = selector->tagQName();
+            bool matchesAnyLocalName = tagQName.localName() == starAtom;
+            bool matchesAnyNamespace = tagQName.namespaceURI() == starAtom;
+            if (matchesAnyLocalName && matchesAnyNamespace)
+                break;
+            if (matchesAnyNamespace) {
+                instruction.opcode = Opcode::MatchLocalName;
+                instruction.name = tagQName.localName().impl();
+                instruction.htmlName = selector->tagLowercaseLocalName().impl();
+            } else
+                instruction.opcode = Opcode::MatchTag;
+            instructions.append(instruction);
+            break;
+        }
+        case CSSSelector::Id:
+            instruction.opcode = Opcode::MatchId;
+            instruction.name = selector->value().impl();
+            instructions.append(instruction);
+            break;
+        case CSSSelector::Class:
+            instruction.opcode = Opcode::MatchClass;
+            instructions.append(instruction);
+            break;
+        case CSSSelector::Exact:
+        case CSSSelector::Set:
+        case CSSSelector::List:
+        case CSSSelector::Hyphen:
+        case CSSSelector::Contain:
+        case CSSSelector::Begin:
+        case CSSSelector::End:
+            instruction.opcode = Opcode::MatchAttribute;
+            instruction.valueIsAlwaysCaseInsensitive = selector->attributeValueMatchingIsCaseInsensitive();
+            instruction.valueIsCaseSensitiveInHTML = HTMLDocument::isCaseSensitiveAttribute(selector->attribute());
+            instructions.append(instruction);
+            break;
+        case CSSSelector::PseudoClass:
+        case CSSSelector::PseudoElement:
+        case CSSSelector::PagePseudoClass:
+        case CSSSelector::Unknown:
+            return nullptr;
+        }
+
+        if (!selector->tagHistory())
+            break;
+
+        switch (selector->relation()) {
+        case CSSSelector::SubSelector:
+            continue;
+        case CSSSelector::Descendant:
+            instruction.opcode = Opcode::Descendant;
+            break;
+        case CSSSelector::Child:
+            instruction.opcode = Opcode::Child;
+            break;
+        case CSSSelector::DirectAdjacent:
+            instruction.opcode = Opcode::DirectAdjacent;
+            break;
+        case CSSSelector::IndirectAdjacent:
+            instruction.opcode = Opcode::IndirectAdjacent;
+            break;
+        case CSSSelector::ShadowDescendant:
+            return nullptr;
+        }
+        instructions.append(instruction);
+    }
+    instructions.append({ Opcode::Matched, false, false, nullptr, nullptr, nullptr });
+    instructions.shrinkToFit();
+
+    return adoptRef(new SelectorProgram(WTFMove(instructions), specificity));
+}
+
+SelectorProgram::SelectorProgram(Vector<Instruction>&& instructions, unsigned specificity)
+    : m_instructions(WTFMove(instructions))
+    , m_specificity(specificity)
+{
+}
+
+bool SelectorProgram::hasChildCombinatorBetween(unsigned start, unsigned end) const
+{
+    for (unsigned i = start + 1; i < end; ++i) {
+        if (m_instructions[i].opcode == Opcode::Child)
+            return true;
+    }
+    return false;
+}
+
+static inline void addStyleRelation(SelectorChecker::CheckingContext& checkingContext, const Element& element, SelectorChecker::StyleRelation::Type type)
+{
+    checkingContext.styleRelations.append({ const_cast<Element&>(element), type, 1 });
+}
+
+static inline bool tagMatches(const Element& element, const CSSSelector& selector, bool documentIsHTML)
+{
+    const QualifiedName& tagQName = selector.tagQName();
+    const AtomicString& localName = (element.isHTMLElement() && documentIsHTML) ? selector.tagLowercaseLocalName() : tagQName.localName();
+    if (localName != starAtom && localName != element.localName())
+        return false;
+    const AtomicString& namespaceURI = tagQName.namespaceURI();
+    return namespaceURI == starAtom || namespaceURI == element.namespaceURI();
+}
+
+static inline bool attributeMatches(const Element& element, const CSSSelector& selector, bool caseSensitive)
+{
+    if (!element.hasAttributes())
+        return false;
+
+    const QualifiedName& selectorAttribute = selector.attribute();
+    const AtomicString& localName = element.isHTMLElement() ? selector.attributeCanonicalLocalName() : selectorAttribute.localName();
+    for (const Attribute& attribute : element.attributesIterator()) {
+        if (!attribute.matches(selectorAttribute.prefix(), localName, selectorAttribute.namespaceURI()))
+            continue;
+        if (SelectorChecker::attributeValueMatches(attribute, selector.match(), selector.value(), caseSensitive))
+            return true;
+    }
+    return false;
+}
+
+// This follows SelectorChecker::matchRecursively(). Its ancestor and sibling loops become
+// backtracking entries, and the way it narrows failures down is kept so that a failed
+// search cuts off the searches it was nested in just as early.
+bool SelectorProgram::matches(const Element& element, SelectorChecker::CheckingContext& checkingContext) const
+{
+    struct Backtrack {
+        unsigned combinatorIndex;
+        const Element* element;
+    };
+    Vector<Backtrack, 8> backtracks;
+
+    bool documentIsHTML = element.document().isHTMLDocument();
+    bool resolvingStyle = checkingContext.resolvingMode == SelectorChecker::Mode::ResolvingStyle;
+
+    const Element* currentElement = &element;
+    unsigned index = 0;
+    while (true) {
+        const Instruction& instruction = m_instructions[index];
+        Failure failure = Failure::Locally;
+
+        switch (instruction.opcode) {
+        case Opcode::MatchLocalName: {
+            const AtomicStringImpl* localName = (currentElement->isHTMLElement() && documentIsHTML) ? instruction.htmlName : instruction.name;
+            if (localName == currentElement->localName().impl()) {
+                ++index;
+                continue;
+            }
+            break;
+        }
+        case Opcode::MatchTag:
+            if (tagMatches(*currentElement, *instruction.selector, documentIsHTML)) {
+                ++index;
+                continue;
+            }
+            break;
+        case Opcode::MatchId:
+            if (currentElement->hasID() && currentElement->idForStyleResolution().impl() == instruction.name) {
+                ++index;
+                continue;
+            }
+            break;
+        case Opcode::MatchClass:
+            if (currentElement->hasClass() && currentElement->classNames().contains(instruction.selector->value())) {
+                ++index;
+                continue;
+            }
+            break;
+        case Opcode::MatchAttribute: {
+            bool caseSensitive = !instruction.valueIsAlwaysCaseInsensitive
+                && (instruction.valueIsCaseSensitiveInHTML || !documentIsHTML || !currentElement->isHTMLElement());
+            if (attributeMatches(*currentElement, *instruction.selector, caseSensitive)) {
+                ++index;
+                continue;
+            }
+            break;
+        }
+        case Opcode::Descendant:
+            if (const Element* parent = currentElement->parentElement()) {
+                backtracks.append({ index, parent });
+                currentElement = parent;
+                ++index;
+                continue;
+            }
+            failure = Failure::Completely;
+            break;
+        case Opcode::Child:
+            if (const Element* parent = currentElement->parentElement()) {
+                currentElement = parent;
+                ++index;
+                continue;
+            }
+            failure = Failure::Completely;
+            break;
+        case Opcode::DirectAdjacent:
+            if (resolvingStyle)
+                addStyleRelation(checkingContext, *currentElement, SelectorChecker::StyleRelation::AffectedByPreviousSibling);
+            if (const Element* previous = currentElement->previousElementSibling()) {
+                if (resolvingStyle)
+                    addStyleRelation(checkingContext, *previous, SelectorChecker::StyleRelation::AffectsNextSibling);
+                currentElement = previous;
+                ++index;
+                continue;
+            }
+            failure = Failure::AllSiblings;
+            break;
+        case Opcode::IndirectAdjacent:
+            if (resolvingStyle)
+                addStyleRelation(checkingContext, *currentElement, SelectorChecker::StyleRelation::AffectedByPreviousSibling);
+            if (const Element* previous = currentElement->previousElementSibling()) {
+                if (resolvingStyle)
+                    addStyleRelation(checkingContext, *previous, SelectorChecker::StyleRelation::AffectsNextSibling);
+                backtracks.append({ index, previous });
+                currentElement = previous;
+                ++index;
+                continue;
+            }
+            failure = Failure::AllSiblings;
+            break;
+        case Opcode::Matched:
+            return true;
+        }
+
+        // Return the failure through the innermost loops until one of them has another candidate.
+        unsigned failureIndex = index;
+        while (true) {
+            if (backtracks.isEmpty())
+                return false;
+            Backtrack& backtrack = backtracks.last();
+
+            // A child combinator fails for all siblings when its parent does not match.
+            if (failure == Failure::Locally && hasChildCombinatorBetween(backtrack.combinatorIndex, failureIndex))
+                failure = Failure::AllSiblings;
+
+            if (m_instructions[backtrack.combinatorIndex].opcode == Opcode::Descendant) {
+                if (failure != Failure::Completely) {
+                    if (const Element* parent = backtrack.element->parentElement()) {
+                        backtrack.element = parent;
+                        break;
+                    }
+                    failure = Failure::Completely;
+                }
+            } else {
+                ASSERT(m_instructions[backtrack.combinatorIndex].opcode == Opcode::IndirectAdjacent);
+                if (failure == Failure::Locally) {
+                    if (const Element* previous = backtrack.element->previousElementSibling()) {
+                        if (resolvingStyle)
+                            addStyleRelation(checkingContext, *previous, SelectorChecker::StyleRelation::AffectsNextSibling);
+                        backtrack.element = previous;
+                        break;
+                    }
+                    failure = Failure::AllSiblings;
+                }
+            }
+            failureIndex = backtrack.combinatorIndex;
+            backtracks.removeLast();
+        }
+
+        currentElement = backtracks.last().element;
+        index = backtracks.last().combinatorIndex + 1;
+    }
+}
+
+} // namespace WebCore
+
+#endif // !ENABLE(CSS_SELECTOR_JIT)
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SelectorProgram_h
+#define SelectorProgram_h
+
+#if !ENABLE(CSS_SELECTOR_JIT)
+
+#include "SelectorChecker.h"
+#include <wtf/RefCounted.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class CSSSelector;
+class Element;
+
+// Without the selector JIT, every selector goes through SelectorChecker, which recurses
+// once per simple selector and re-decodes each CSSSelector on every match. Selectors made
+// of type, id, class and attribute selectors joined by the tree combinators are compiled
+// instead into a flat list of instructions, matched right to left by an interpreter that
+// keeps the ancestor and sibling loops on an explicit stack. The results, including the
+// style relations recorded while resolving style, are the same as SelectorChecker's.
+//
+// Instructions point into the selector they were compiled from, which must outlive the
+// program. The RuleData or SelectorData holding the program keeps it alive.
+class SelectorProgram : public RefCounted<SelectorProgram> {
+public:
+    // Returns null for selectors that need SelectorChecker.
+    static RefPtr<SelectorProgram> compile(const CSSSelector&);
+
+    bool matches(const Element&, SelectorChecker::CheckingContext&) const;
+    unsigned specificity() const { return m_specificity; }
+
+private:
+    enum class Opcode : uint8_t {
+        // Simple selectors, matched against the current element.
+        MatchLocalName,
+        MatchTag,
+        MatchId,
+        MatchClass,
+        MatchAttribute,
+
+        // Combinators, which move to another element.
+        Descendant,
+        Child,
+        DirectAdjacent,
+        IndirectAdjacent,
+
+        Matched
+    };
+
+    struct Instruction {
+        Opcode opcode;
+        bool valueIsAlwaysCaseInsensitive;
+        bool valueIsCaseSensitiveInHTML;
+        const CSSSelector* selector;
+        // The local name, id or class to compare with, and the local name to use
+        // for HTML elements in HTML documents.
+        const AtomicStringImpl* name;
+        const AtomicStringImpl* htmlName;
+    };
+
+    enum class Failure { Locally, AllSiblings, Completely };
+
+    SelectorProgram(Vector<Instruction>&&, unsigned specificity);
+
+    bool hasChildCombinatorBetween(unsigned start, unsigned end) const;
+
+    Vector<Instruction> m_instructions;
+    unsigned m_specificity;
+};
+
+} // namespace WebCore
+
+#endif // !ENABLE(CSS_SELECTOR_JIT)
+
+#endif // SelectorProgram_h
@@ -114,20 +114,20 @@ SelectorDataList::SelectorDataList(const CSSSelectorList& selectorList)
 
 inline bool SelectorDataList::selectorMatches(const SelectorData& selectorData, Element& element, const ContainerNode& rootNode) const
 {
-    SelectorChecker selectorChecker(element.document());
     SelectorChecker::CheckingContext selectorCheckingContext(SelectorChecker::Mode::QueryingRules);
     selectorCheckingContext.scope = rootNode.isDocumentNode() ? nullptr : &rootNode;
+#if !ENABLE(CSS_SELECTOR_JIT)
+    if (selectorData.program)
+        return selectorData.program->matches(element, selectorCheckingContext);
+#endif
+    SelectorChecker selectorChecker(element.document());
     unsigned ignoredSpecificity;
     return selectorChecker.match(*selectorData.selector, element, selectorCheckingContext, ignoredSpecificity);
 }
 
 inline Element* SelectorDataList::selectorClosest(const SelectorData& selectorData, Element& element, const ContainerNode& rootNode) const
 {
-    SelectorChecker selectorChecker(element.document());
-    SelectorChecker::CheckingContext selectorCheckingContext(SelectorChecker::Mode::QueryingRules);
-    selectorCheckingContext.scope = rootNode.isDocumentNode() ? nullptr : &rootNode;
-    unsigned ignoredSpecificity;
-    if (!selectorChecker.match(*selectorData.selector, element, selectorCheckingContext, ignoredSpecificity))
+    if (!selectorMatches(selectorData, element, rootNode))
         return nullptr;
     return &element;
 }
@@ -29,6 +29,7 @@
 #include "CSSSelectorList.h"
 #include "NodeList.h"
 #include "SelectorCompiler.h"
+#include "SelectorProgram.h"
 #include <wtf/HashMap.h>
 #include <wtf/Vector.h>
 #include <wtf/text/AtomicStringHash.h>
@@ -59,6 +60,9 @@ private:
             : selector(selector)
 #if ENABLE(CSS_SELECTOR_JIT) && CSS_SELECTOR_JIT_PROFILING
             , m_compiledSelectorUseCount(0)
+#endif
+#if !ENABLE(CSS_SELECTOR_JIT)
+            , program(SelectorProgram::compile(*selector))
 #endif
         {
         }
@@ -76,6 +80,8 @@ private:
         mutable unsigned m_compiledSelectorUseCount;
         void compiledSelectorUsed() const { m_compiledSelectorUseCount++; }
 #endif
+#else
+        RefPtr<SelectorProgram> program;
 #endif // ENABLE(CSS_SELECTOR_JIT)
     };
 
@@ -192,12 +192,14 @@ private:
 
     struct CachedFrameData {
         bool complete;
-        IntSize size;
+        IntSize size; // Size of the decoded, possibly subsampled, frame.
         float duration;
         bool hasAlpha;
+        SubsamplingLevel subsamplingLevel { 0 };
     };
     Vector<CachedFrameData> m_frameInfos;
     bool isMetaDataExists(size_t) const;
+    IntSize decodedFrameSizeAtIndex(size_t) const;
 #endif
 };
 
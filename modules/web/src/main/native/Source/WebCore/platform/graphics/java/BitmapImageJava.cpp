@@ -6,6 +6,7 @@
 #include "NotImplemented.h"
 
 #include "BitmapImage.h"
+#include "GeometryUtilities.h"
 #include "GraphicsContext.h"
 #include "ImageObserver.h"
 #include "JavaEnv.h"
@@ -53,13 +54,63 @@ void BitmapImage::checkForSolidColor()
 
 void BitmapImage::determineMinimumSubsamplingLevel() const
 {
-    m_minimumSubsamplingLevel = 0;
+    // Frames are decoded no larger than they are drawn (see draw()), but not
+    // below this area: smaller images save little memory by being subsampled,
+    // and have to be decoded again whenever they are drawn larger.
+    const int cMinimumSubsampledImageArea = 256 * 256;
+    const SubsamplingLevel maxSubsamplingLevel = 3;
+
+    SubsamplingLevel currentLevel = 0;
+    if (m_source.allowSubsamplingOfFrameAtIndex(0)) {
+        for ( ; currentLevel < maxSubsamplingLevel; ++currentLevel) {
+            IntSize frameSize = m_source.frameSizeAtIndex(0, currentLevel + 1);
+            if (frameSize.area() < cMinimumSubsampledImageArea)
+                break;
+        }
+    }
+
+    m_minimumSubsamplingLevel = currentLevel;
+}
+
+static float devicePixelScale()
+{
+    static float scale = 0;
+    if (!scale) {
+        WC_GETJAVAENV_CHKRET(env, 1);
+        static jmethodID midGetDevicePixelScale = env->GetMethodID(
+            PG_GetGraphicsManagerClass(env),
+            "getDevicePixelScale",
+            "()F");
+        ASSERT(midGetDevicePixelScale);
+
+        scale = env->CallFloatMethod(PL_GetGraphicsManager(env), midGetDevicePixelScale);
+        if (CheckAndClearException(env) || scale <= 0)
+            scale = 1;
+    }
+    return scale;
 }
 
 void BitmapImage::draw(GraphicsContext& gc, const FloatRect& dstRect, const FloatRect& srcRect,
                        CompositeOperator co, BlendMode bm, ImageOrientationDescription id) // todo tav new param
 {
-    Image::drawImage(gc, dstRect, srcRect, co, bm);
+    if (!gc.paintingDisabled() && !srcRect.isEmpty()) {
+        // The CTM does not include the device scale, which is applied
+        // when the rendering queue is decoded.
+        FloatRect transformedDstRect = gc.getCTM().mapRect(dstRect);
+        float subsamplingScale = std::min<float>(1, devicePixelScale() * std::max(
+            transformedDstRect.width() / srcRect.width(),
+            transformedDstRect.height() / srcRect.height()));
+
+        NativeImagePtr frame = frameAtIndex(m_currentFrame, subsamplingScale);
+        if (frame) {
+            // srcRect is in the coordinates of the unsubsampled image, so we have to map it to the subsampled image.
+            FloatRect scaledSrcRect = srcRect;
+            IntSize frameSize = m_source.decodedFrameSizeAtIndex(m_currentFrame);
+            if (m_frames[m_currentFrame].m_subsamplingLevel && frameSize != m_size && !frameSize.isEmpty())
+                scaledSrcRect = mapRect(srcRect, FloatRect(FloatPoint(), m_size), FloatRect(FloatPoint(), frameSize));
+            drawNativeImage(gc, frame, dstRect, scaledSrcRect);
+        }
+    }
     startAnimation();
 }
 
@@ -62,14 +62,17 @@ void Image::drawPattern(GraphicsContext& gc, const FloatRect& srcRect, const Aff
 void Image::drawImage(GraphicsContext& gc, const FloatRect &dstRect, const FloatRect &srcRect,
                        CompositeOperator, BlendMode)
 {
-    JNIEnv* env = WebCore_GetJavaEnv();
-
     if (gc.paintingDisabled()) {
         return;
     }
 
-    NativeImagePtr currFrame = nativeImageForCurrentFrame();
-    if (!currFrame) {
+    drawNativeImage(gc, nativeImageForCurrentFrame(), dstRect, srcRect);
+}
+
+void Image::drawNativeImage(GraphicsContext& gc, NativeImagePtr currFrame,
+                            const FloatRect &dstRect, const FloatRect &srcRect)
+{
+    if (gc.paintingDisabled() || !currFrame) {
         return;
     }
 
@@ -13,6 +13,7 @@
 #include "JavaEnv.h"
 #include "Logging.h"
 #include "MemoryCache.h"
+#include <wtf/MathExtras.h>
 
 namespace WebCore {
 
@@ -77,14 +78,29 @@ void ImageSource::setData(SharedBuffer *data, bool allDataReceived)
         "([B)V");
     ASSERT(midAddImageData);
 
+    static jmethodID midAddImageDataBuffer = env->GetMethodID(
+        PG_GetGraphicsImageDecoderClass(env),
+        "addImageData",
+        "(Ljava/nio/ByteBuffer;)V");
+    ASSERT(midAddImageDataBuffer);
+
     const char* segment;
     while (unsigned length = data->getSomeData(segment, m_dataSize)) {
-        JLByteArray jArray(env->NewByteArray(length));
-        if (jArray && !CheckAndClearException(env)) {
-            // not OOME in Java
-            env->SetByteArrayRegion(jArray, 0, length, (const jbyte*)segment);
-            env->CallVoidMethod(m_decoder, midAddImageData, (jbyteArray)jArray);
+        // The decoder copies the segment straight out of a direct buffer,
+        // which saves copying it into a Java array first. The buffer is
+        // only used during the call, so it can wrap the segment in place.
+        JLObject buffer(env->NewDirectByteBuffer(const_cast<char*>(segment), length));
+        if (buffer && !CheckAndClearException(env)) {
+            env->CallVoidMethod(m_decoder, midAddImageDataBuffer, (jobject)buffer);
             CheckAndClearException(env);
+        } else {
+            JLByteArray jArray(env->NewByteArray(length));
+            if (jArray && !CheckAndClearException(env)) {
+                // not OOME in Java
+                env->SetByteArrayRegion(jArray, 0, length, (const jbyte*)segment);
+                env->CallVoidMethod(m_decoder, midAddImageData, (jbyteArray)jArray);
+                CheckAndClearException(env);
+            }
         }
         m_dataSize += length;
     }
@@ -94,9 +110,21 @@ void ImageSource::setData(SharedBuffer *data, bool allDataReceived)
     }
 }
 
-SubsamplingLevel ImageSource::subsamplingLevelForScale(float) const
+SubsamplingLevel ImageSource::subsamplingLevelForScale(float scale) const
 {
-    return 0;
+    // There are four subsampling levels: 0 = 1x, 1 = 0.5x, 2 = 0.25x, 3 = 0.125x.
+    // Round down, so that a frame is never decoded smaller than it is drawn.
+    float clampedScale = std::max<float>(0.125, std::min<float>(1, scale));
+    int result = floorf(log2f(1 / clampedScale));
+    ASSERT(result >= 0 && result <= 3);
+    return result;
+}
+
+bool ImageSource::allowSubsamplingOfFrameAtIndex(size_t) const
+{
+    // The decoder reports the level it actually decoded a frame at,
+    // and only subsamples complete single frame images.
+    return true;
 }
 
 bool ImageSource::isSizeAvailable()
@@ -144,7 +172,7 @@ size_t ImageSource::frameCount() const
         : count;
 }
 
-PassNativeImagePtr ImageSource::createFrameAtIndex(size_t idx, SubsamplingLevel /* = 0*/)
+PassNativeImagePtr ImageSource::createFrameAtIndex(size_t idx, SubsamplingLevel subsamplingLevel /* = 0*/)
 {
     JNIEnv* env = WebCore_GetJavaEnv();
     ASSERT(m_decoder);
@@ -152,10 +180,10 @@ PassNativeImagePtr ImageSource::createFrameAtIndex(size_t idx, SubsamplingLevel
     static jmethodID midGetFrame = env->GetMethodID(
         PG_GetGraphicsImageDecoderClass(env),
         "getFrame",
-        "(I[I)Lcom/sun/webkit/graphics/WCImageFrame;");
+        "(II[I)Lcom/sun/webkit/graphics/WCImageFrame;");
     ASSERT(midGetFrame);
 
-    JLocalRef<jintArray> jbuf(env->NewIntArray(5));
+    JLocalRef<jintArray> jbuf(env->NewIntArray(6));
     CheckAndClearException(env); // OOME
     ASSERT(jbuf);
 
@@ -163,6 +191,7 @@ PassNativeImagePtr ImageSource::createFrameAtIndex(size_t idx, SubsamplingLevel
         m_decoder,
         midGetFrame,
         idx,
+        subsamplingLevel,
         (jintArray)jbuf));
     CheckAndClearException(env);
 
@@ -175,6 +204,7 @@ PassNativeImagePtr ImageSource::createFrameAtIndex(size_t idx, SubsamplingLevel
     m_frameInfos[idx].size.setHeight(buf[2]);
     m_frameInfos[idx].duration = buf[3] / 1000.0f;
     m_frameInfos[idx].hasAlpha = buf[4];
+    m_frameInfos[idx].subsamplingLevel = buf[5];
     env->ReleasePrimitiveArrayCritical(jbuf, buf, 0);
 
     return RQRef::create(frame);
@@ -205,17 +235,36 @@ IntSize ImageSource::size(ImageOrientationDescription d) const
 
 IntSize ImageSource::frameSizeAtIndex(
     size_t idx,
-    SubsamplingLevel, //XXX: check for usage
+    SubsamplingLevel subsamplingLevel,
     ImageOrientationDescription d) const
 {
-    if (!isMetaDataExists(idx))
-        return size();
-
     // The JPEG and TIFF decoders need to be taught how to read EXIF, XMP, or IPTC data.
     if (d.respectImageOrientation() == RespectImageOrientation)
         notImplemented();
 
-    ASSERT(idx < m_frameInfos.size());
+    IntSize frameSize = size();
+    if (isMetaDataExists(idx)) {
+        ASSERT(idx < m_frameInfos.size());
+        if (m_frameInfos[idx].subsamplingLevel == subsamplingLevel)
+            return m_frameInfos[idx].size;
+        // Only complete single frame images are subsampled, so a subsampled
+        // frame is the whole image.
+        if (!m_frameInfos[idx].subsamplingLevel)
+            frameSize = m_frameInfos[idx].size;
+    }
+
+    // The decoder rounds subsampled sizes up, like CG does.
+    int scale = 1 << subsamplingLevel;
+    return IntSize(
+        (frameSize.width() + scale - 1) / scale,
+        (frameSize.height() + scale - 1) / scale);
+}
+
+IntSize ImageSource::decodedFrameSizeAtIndex(size_t idx) const
+{
+    if (!isMetaDataExists(idx))
+        return size();
+
     return m_frameInfos[idx].size;
 }
 
@@ -242,7 +291,8 @@ unsigned ImageSource::frameBytesAtIndex(size_t idx, SubsamplingLevel) const
     if (!isMetaDataExists(idx))
         return 0;
 
-    //utatodo: need support for variable frame size.
+    // Account for the frame as it was actually decoded, which is smaller
+    // than the image when it was subsampled.
     ASSERT(idx < m_frameInfos.size());
     return m_frameInfos[idx].size.width() * m_frameInfos[idx].size.height() * 4;
 }
@@ -48,7 +48,9 @@
 #include "InspectorController.h"
 #include "inspector/InspectorAgentBase.h"
 #include "JSContextRefPrivate.h"
+#include "JSDOMWindowBase.h"
 #include "JSContextRef.h"
+#include "JavaClassJSC.h"
 #include "JavaEnv.h"
 #include <wtf/java/JavaRef.h>
 #include "Logging.h"
@@ -93,6 +95,8 @@
 #include <runtime/JSCJSValue.h>
 #include <runtime/Options.h>
 #include <JSLock.h>
+#include <runtime/SamplingProfiler.h>
+#include <wtf/Stopwatch.h>
 #include <API/APICast.h>
 #include <API/JSStringRef.h>
 
@@ -2383,6 +2387,92 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkDoJSCGarbageCollection
     GCController::singleton().garbageCollectNow();
 }
 
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_WebPage_twkStartJavaScriptSampling
+  (JNIEnv*, jclass, jint intervalMicros)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    JSC::VM& vm = JSDOMWindowBase::commonVM();
+    JSC::JSLockHolder lock(vm);
+
+    RefPtr<Stopwatch> stopwatch = Stopwatch::create();
+    stopwatch->start();
+    vm.ensureSamplingProfiler(WTFMove(stopwatch));
+
+    JSC::SamplingProfiler& samplingProfiler = *vm.samplingProfiler();
+    LockHolder locker(samplingProfiler.getLock());
+    if (intervalMicros > 0)
+        samplingProfiler.setTimingInterval(std::chrono::microseconds(intervalMicros));
+    samplingProfiler.noticeCurrentThreadAsJSCExecutionThread(locker);
+    samplingProfiler.start(locker);
+    return JNI_TRUE;
+#else
+    UNUSED_PARAM(intervalMicros);
+    return JNI_FALSE;
+#endif
+}
+
+JNIEXPORT jstring JNICALL Java_com_sun_webkit_WebPage_twkStopJavaScriptSampling
+  (JNIEnv* env, jclass, jboolean includeBytecodeOffsets)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    JSC::VM& vm = JSDOMWindowBase::commonVM();
+    JSC::SamplingProfiler* samplingProfiler = vm.samplingProfiler();
+    if (!samplingProfiler) {
+        return NULL;
+    }
+
+    JSC::JSLockHolder lock(vm);
+    samplingProfiler->stop();
+    return samplingProfiler->stackTracesAsFoldedStacks(includeBytecodeOffsets == JNI_TRUE)
+            .toJavaString(env).releaseLocal();
+#else
+    UNUSED_PARAM(env);
+    UNUSED_PARAM(includeBytecodeOffsets);
+    return NULL;
+#endif
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkSetJavaScriptHeapPolicy
+  (JNIEnv*, jclass, jlong targetHeapSize, jdouble growthFactor, jlong hardLimit)
+{
+    JSC::VM& vm = JSDOMWindowBase::commonVM();
+    JSC::JSLockHolder lock(vm);
+
+    JSC::HeapPolicy policy;
+    policy.targetHeapSize = targetHeapSize > 0 ? static_cast<size_t>(targetHeapSize) : 0;
+    policy.growthFactor = growthFactor > 1 ? growthFactor : 0;
+    policy.hardLimit = hardLimit > 0 ? static_cast<size_t>(hardLimit) : 0;
+    vm.heap.setPolicy(policy);
+}
+
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_WebPage_twkCollectJavaScriptGarbageWhenIdle
+  (JNIEnv*, jclass, jint idleMillis)
+{
+    JSC::VM& vm = JSDOMWindowBase::commonVM();
+    JSC::JSLockHolder lock(vm);
+    return bool_to_jbool(vm.heap.collectDuringIdleTime(idleMillis / 1000.0));
+}
+
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_WebPage_twkHasJavaScriptHeapExceededLimit
+  (JNIEnv*, jclass)
+{
+    return bool_to_jbool(JSDOMWindowBase::commonVM().heap.hasExceededHardLimit());
+}
+
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_WebPage_twkGetJavaClassCacheStatistics
+  (JNIEnv* env, jclass)
+{
+    JSC::Bindings::JavaClass::CacheStatistics statistics = JSC::Bindings::JavaClass::cacheStatistics();
+    jlong values[] = {
+        static_cast<jlong>(statistics.hits),
+        static_cast<jlong>(statistics.misses),
+        static_cast<jlong>(statistics.reflectionSecondsSaved * 1e9)
+    };
+    jlongArray jArray = env->NewLongArray(WTF_ARRAY_LENGTH(values));
+    env->SetLongArrayRegion(jArray, 0, WTF_ARRAY_LENGTH(values), values);
+    return jArray;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -350,6 +350,59 @@ TEST(WTF, StringImplFindIgnoringASCIICaseWithPatternLongerThanReference)
     EXPECT_EQ(static_cast<size_t>(1), pattern->findIgnoringASCIICase(reference.get()));
 }
 
+TEST(WTF, StringImplFindBasic)
+{
+    RefPtr<StringImpl> reference = stringFromUTF8("name,value;name=other,value");
+    EXPECT_EQ(static_cast<size_t>(0), reference->find(StringImpl::createFromLiteral("name").ptr()));
+    EXPECT_EQ(static_cast<size_t>(4), reference->find(','));
+    EXPECT_EQ(static_cast<size_t>(21), reference->find(',', 5));
+    EXPECT_EQ(static_cast<size_t>(11), reference->find(StringImpl::createFromLiteral("name").ptr(), 1));
+    EXPECT_EQ(static_cast<size_t>(22), reference->find(StringImpl::createFromLiteral("value").ptr(), 6));
+    EXPECT_EQ(static_cast<size_t>(WTF::notFound), reference->find(StringImpl::createFromLiteral("values").ptr()));
+    EXPECT_EQ(static_cast<size_t>(WTF::notFound), reference->find(StringImpl::createFromLiteral("name").ptr(), 12));
+    EXPECT_EQ(static_cast<size_t>(WTF::notFound), reference->find('!'));
+    EXPECT_EQ(static_cast<size_t>(WTF::notFound), reference->find(',', 27));
+}
+
+TEST(WTF, StringImplFindWithRepetitivePattern)
+{
+    // Every position is a candidate for the first character, which is the worst case for
+    // a search that looks for the first character and then compares the rest.
+    Vector<LChar> characters(4096, 'a');
+    characters.append('b');
+    RefPtr<StringImpl> reference = StringImpl::create(characters.data(), characters.size());
+
+    Vector<LChar> patternCharacters(64, 'a');
+    patternCharacters.append('b');
+    RefPtr<StringImpl> pattern = StringImpl::create(patternCharacters.data(), patternCharacters.size());
+    EXPECT_EQ(static_cast<size_t>(4096 - 64), reference->find(pattern.get()));
+    EXPECT_EQ(static_cast<size_t>(4096 - 64), reference->find(pattern.get(), 100));
+
+    patternCharacters.last() = 'c';
+    pattern = StringImpl::create(patternCharacters.data(), patternCharacters.size());
+    EXPECT_EQ(static_cast<size_t>(WTF::notFound), reference->find(pattern.get()));
+
+    // A periodic pattern has a candidate every period, each of which compares almost the whole
+    // pattern before failing.
+    characters.clear();
+    for (unsigned i = 0; i < 2048; ++i)
+        characters.append(i % 2 ? 'b' : 'a');
+    characters.append('c');
+    reference = StringImpl::create(characters.data(), characters.size());
+
+    patternCharacters.clear();
+    for (unsigned i = 0; i < 64; ++i)
+        patternCharacters.append(i % 2 ? 'b' : 'a');
+    patternCharacters.append('c');
+    pattern = StringImpl::create(patternCharacters.data(), patternCharacters.size());
+    EXPECT_EQ(static_cast<size_t>(2048 - 64), reference->find(pattern.get()));
+    EXPECT_EQ(static_cast<size_t>(2048 - 64), reference->find(pattern.get(), 101));
+
+    patternCharacters.last() = 'd';
+    pattern = StringImpl::create(patternCharacters.data(), patternCharacters.size());
+    EXPECT_EQ(static_cast<size_t>(WTF::notFound), reference->find(pattern.get()));
+}
+
 TEST(WTF, StringImplStartsWithIgnoringASCIICaseBasic)
 {
     RefPtr<StringImpl> reference = stringFromUTF8("aBcéX");
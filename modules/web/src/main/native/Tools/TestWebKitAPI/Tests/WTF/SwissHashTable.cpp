@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2016 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "MoveOnly.h"
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/SwissHashTable.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace TestWebKitAPI {
+
+struct SwissIntTraits : WTF::UnsignedWithZeroKeyHashTraits<int> {
+    static const bool useSwissTable = true;
+};
+
+struct SwissStringTraits : HashTraits<String> {
+    static const bool useSwissTable = true;
+};
+
+struct SwissMoveOnlyTraits : HashTraits<MoveOnly> {
+    static const bool useSwissTable = true;
+};
+
+typedef HashSet<int, DefaultHash<int>::Hash, SwissIntTraits> SwissIntSet;
+
+// Always lands in the same group, so every probe goes through the collision path.
+struct CollidingIntHash {
+    static unsigned hash(int) { return 0; }
+    static bool equal(int a, int b) { return a == b; }
+    static const bool safeToCompareToEmptyOrDeleted = true;
+};
+
+TEST(WTF_SwissHashTable, SelectedByTraits)
+{
+    static_assert(WTF::HashTraitsUseSwissTable<SwissIntTraits>::value, "opted in");
+    static_assert(!WTF::HashTraitsUseSwissTable<HashTraits<int>>::value, "not opted in");
+}
+
+TEST(WTF_SwissHashTable, AddContainsRemove)
+{
+    SwissIntSet set;
+    EXPECT_EQ(0u, set.capacity());
+
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_TRUE(set.add(i).isNewEntry);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_FALSE(set.add(i).isNewEntry);
+    EXPECT_EQ(1000u, set.size());
+
+    // Zero is a valid key with these traits, and is also the empty value.
+    EXPECT_TRUE(set.contains(0));
+
+    for (int i = 0; i < 1000; i += 2)
+        EXPECT_TRUE(set.remove(i));
+    EXPECT_EQ(500u, set.size());
+
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(!!(i % 2), set.contains(i));
+    EXPECT_FALSE(set.contains(1000));
+}
+
+TEST(WTF_SwissHashTable, LoadFactor)
+{
+    SwissIntSet set;
+    set.add(0);
+    unsigned initialCapacity = set.capacity();
+    EXPECT_EQ(16u, initialCapacity);
+
+    // The table only grows past a load of 7/8.
+    for (unsigned i = 1; i < initialCapacity * 7 / 8; ++i) {
+        set.add(i);
+        EXPECT_EQ(initialCapacity, set.capacity());
+    }
+    set.add(initialCapacity);
+    EXPECT_GT(set.capacity(), initialCapacity);
+}
+
+TEST(WTF_SwissHashTable, Shrink)
+{
+    SwissIntSet set;
+    for (int i = 0; i < 4096; ++i)
+        set.add(i);
+    unsigned largeCapacity = set.capacity();
+
+    for (int i = 0; i < 4090; ++i)
+        set.remove(i);
+    EXPECT_LT(set.capacity(), largeCapacity);
+    for (int i = 4090; i < 4096; ++i)
+        EXPECT_TRUE(set.contains(i));
+}
+
+TEST(WTF_SwissHashTable, Collisions)
+{
+    HashSet<int, CollidingIntHash, SwissIntTraits> set;
+
+    for (int i = 0; i < 300; ++i)
+        set.add(i);
+
+    // Remove from the middle of the probe sequence and refill the holes.
+    for (int i = 0; i < 300; i += 3)
+        set.remove(i);
+    for (int i = 0; i < 300; ++i)
+        EXPECT_EQ(!!(i % 3), set.contains(i));
+    for (int i = 0; i < 300; i += 3)
+        EXPECT_TRUE(set.add(i).isNewEntry);
+    for (int i = 0; i < 300; ++i)
+        EXPECT_TRUE(set.contains(i));
+    EXPECT_EQ(300u, set.size());
+}
+
+TEST(WTF_SwissHashTable, ChurnMatchesHashTable)
+{
+    SwissIntSet swissSet;
+    HashSet<int, DefaultHash<int>::Hash, WTF::UnsignedWithZeroKeyHashTraits<int>> referenceSet;
+
+    unsigned seed = 1;
+    for (unsigned i = 0; i < 100000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int key = (seed >> 8) % 2048;
+        if (seed & 0x10000) {
+            EXPECT_EQ(referenceSet.add(key).isNewEntry, swissSet.add(key).isNewEntry);
+        } else
+            EXPECT_EQ(referenceSet.remove(key), swissSet.remove(key));
+    }
+
+    EXPECT_EQ(referenceSet.size(), swissSet.size());
+    unsigned count = 0;
+    for (int key : swissSet) {
+        EXPECT_TRUE(referenceSet.contains(key));
+        ++count;
+    }
+    EXPECT_EQ(referenceSet.size(), count);
+}
+
+TEST(WTF_SwissHashTable, Iteration)
+{
+    SwissIntSet set;
+    for (int i = 0; i < 100; ++i)
+        set.add(i * 37);
+    for (int i = 1; i < 100; i += 2)
+        set.remove(i * 37);
+
+    unsigned count = 0;
+    int sum = 0;
+    for (int value : set) {
+        EXPECT_EQ(0, value % 2);
+        sum += value;
+        ++count;
+    }
+    EXPECT_EQ(50u, count);
+    EXPECT_EQ(37 * 2 * (49 * 50 / 2), sum);
+
+    set.clear();
+    EXPECT_TRUE(set.begin() == set.end());
+}
+
+TEST(WTF_SwissHashTable, StringKeys)
+{
+    HashMap<String, int, StringHash, SwissStringTraits> map;
+    for (int i = 0; i < 500; ++i)
+        map.add(String::number(i), i);
+
+    for (int i = 0; i < 500; ++i)
+        EXPECT_EQ(i, map.get(String::number(i)));
+    EXPECT_FALSE(map.contains("not a number"));
+
+    map.remove("250");
+    EXPECT_FALSE(map.contains("250"));
+    EXPECT_EQ(499u, map.size());
+
+    HashMap<String, int, StringHash, SwissStringTraits> copy = map;
+    EXPECT_EQ(499u, copy.size());
+    EXPECT_EQ(42, copy.get("42"));
+}
+
+TEST(WTF_SwissHashTable, MoveOnly)
+{
+    HashSet<MoveOnly, DefaultHash<MoveOnly>::Hash, SwissMoveOnlyTraits> hashSet;
+
+    for (size_t i = 0; i < 100; ++i)
+        hashSet.add(MoveOnly(i + 1));
+
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_TRUE(hashSet.take(MoveOnly(i + 1)) == MoveOnly(i + 1));
+
+    EXPECT_TRUE(hashSet.isEmpty());
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.javafx.webkit.prism;
+
+import java.awt.image.BufferedImage;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.util.Arrays;
+import javax.imageio.ImageIO;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+
+/**
+ * A unit test for the {@link WCImageDecoderImpl} class.
+ */
+public class WCImageDecoderImplTest {
+
+    private static byte[] createPNG(int width, int height) throws IOException {
+        BufferedImage image = new BufferedImage(width, height, BufferedImage.TYPE_INT_RGB);
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        ImageIO.write(image, "png", out);
+        return out.toByteArray();
+    }
+
+    private static WCImageDecoderImpl createDecoder(byte[] png) {
+        WCImageDecoderImpl decoder = new WCImageDecoderImpl();
+        decoder.addImageData(png);
+        decoder.addImageData((byte[]) null);
+        return decoder;
+    }
+
+    /**
+     * Tests that the image size is read from the header of partial data.
+     */
+    @Test
+    public void testImageSizeFromHeader() throws IOException {
+        byte[] png = createPNG(1200, 900);
+        WCImageDecoderImpl decoder = new WCImageDecoderImpl();
+        decoder.addImageData(Arrays.copyOf(png, 33));
+        int[] size = new int[2];
+        decoder.getImageSize(size);
+        assertEquals(1200, size[0]);
+        assertEquals(900, size[1]);
+        decoder.destroy();
+    }
+
+    /**
+     * Tests that a large image is decoded at the subsampling level it is
+     * asked for, and at full size again when that is asked for later.
+     */
+    @Test
+    public void testLargeImageDecodedAtRequestedLevel() throws IOException {
+        WCImageDecoderImpl decoder = createDecoder(createPNG(1200, 900));
+        int[] size = new int[2];
+        decoder.getImageSize(size);
+        assertEquals(1200, size[0]);
+        assertEquals(900, size[1]);
+
+        int[] data = new int[6];
+        assertNotNull(decoder.getFrame(0, 2, data));
+        assertEquals(300, data[1]);
+        assertEquals(225, data[2]);
+        assertEquals(2, data[5]);
+
+        assertNotNull(decoder.getFrame(0, 0, data));
+        assertEquals(1200, data[1]);
+        assertEquals(900, data[2]);
+        assertEquals(0, data[5]);
+        decoder.destroy();
+    }
+
+    /**
+     * Tests that an image too small to be subsampled, which is decoded in
+     * the background as soon as its data is complete, has its full size
+     * frame.
+     */
+    @Test
+    public void testSmallImageDecodedAtFullSize() throws IOException {
+        WCImageDecoderImpl decoder = createDecoder(createPNG(300, 200));
+        int[] data = new int[6];
+        assertNotNull(decoder.getFrame(0, 0, data));
+        assertEquals(300, data[1]);
+        assertEquals(200, data[2]);
+        assertEquals(0, data[5]);
+        decoder.destroy();
+    }
+}
@@ -415,6 +415,49 @@ public class DOMTest extends TestBase {
         });
     }
 
+    @Test public void testSelectorCombinators() {
+        loadContent(
+                "<style>ul > li.b ~ li { color: rgb(0, 128, 0); }" +
+                "*|*.x { background-color: rgb(0, 0, 255); }</style>" +
+                "<div id='d' class='x'><section><ul>" +
+                "<li class='a'>1</li><li class='b' title='Foo Bar'>2</li>" +
+                "<li>3</li><li><span lang='en-US'>4</span></li>" +
+                "</ul></section></div>" +
+                "<div><ul><li class='b'>5</li></ul></div>");
+        submit(() -> {
+            assertEquals("Descendant and child", 4,
+                    executeScript("document.querySelectorAll('div.x ul > li').length"));
+            assertEquals("Child", 1,
+                    executeScript("document.querySelectorAll('div > ul > li').length"));
+            assertEquals("Descendant after child", 1,
+                    executeScript("document.querySelectorAll('#d section > ul li span').length"));
+            assertEquals("Direct adjacent", "3",
+                    executeScript("document.querySelector('li.b + li').textContent"));
+            assertEquals("Indirect adjacent", 3,
+                    executeScript("document.querySelectorAll('li.a ~ li').length"));
+            assertEquals("Attribute", 1,
+                    executeScript("document.querySelectorAll('li[title~=Bar] ~ li [lang|=en]').length"));
+            assertEquals("Case insensitive attribute", 1,
+                    executeScript("document.querySelectorAll('[title^=\"foo\" i]').length"));
+            assertEquals("Matches", true,
+                    executeScript("document.querySelector('span').matches('div span')"));
+            assertEquals("Closest", "d",
+                    executeScript("document.querySelector('span').closest('#d').id"));
+            assertEquals("Style from sibling combinator", "rgb(0, 128, 0)",
+                    executeScript("getComputedStyle(document.querySelector('span')).color"));
+            assertEquals("Style not matched", "rgb(0, 0, 0)",
+                    executeScript("getComputedStyle(document.querySelector('li.a')).color"));
+            assertEquals("Any element in any namespace", 2,
+                    executeScript("document.querySelectorAll('div > *|*').length"));
+            assertEquals("Element in any namespace", 5,
+                    executeScript("document.querySelectorAll('ul *|li').length"));
+            assertEquals("Class on any element in any namespace", 1,
+                    executeScript("document.querySelectorAll('*|*.x').length"));
+            assertEquals("Style on any element in any namespace", "rgb(0, 0, 255)",
+                    executeScript("getComputedStyle(document.getElementById('d')).backgroundColor"));
+        });
+    }
+
     // helper methods
 
     private void verifyChildRemoved(Node parent,
@@ -25,6 +25,12 @@
 
 package javafx.scene.web;
 
+import com.sun.webkit.WebPage;
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
 import netscape.javascript.JSException;
 import netscape.javascript.JSObject;
 import static org.junit.Assert.*;
@@ -682,4 +688,218 @@ public class JavaScriptBridgeTest extends TestBase {
             executeShouldFail(web, "sb['append(char[],,int)'](1, 2)");
         });
     }
+
+    public static class PrimitiveCalls {
+        public int calls;
+        public void touch() { calls++; }
+        public boolean isEven(int i) { return i % 2 == 0; }
+        public byte toByte(int i) { return (byte) i; }
+        public short toShort(int i) { return (short) i; }
+        public int add(int a, int b) { calls++; return a + b; }
+        public long twice(long l) { return l * 2; }
+        public float half(float f) { return f / 2; }
+        public double scale(double d, int factor) { return d * factor; }
+        public char firstChar(String s) { return s.charAt(0); }
+        public String concat(String a, String b) { return a + b; }
+        public Object self() { return this; }
+        public int[] pair(int a, int b) { return new int[] { a, b }; }
+    }
+
+    public @Test void testRepeatedMethodCalls() throws InterruptedException {
+        final WebEngine web = getEngine();
+
+        submit(() -> {
+            PrimitiveCalls test = new PrimitiveCalls();
+            bind("test", test);
+            assertEquals(Integer.valueOf(49995000), web.executeScript(
+                "var sum = 0; for (var i = 0; i < 10000; i++) sum = test.add(sum, i); sum"));
+            assertEquals(10000, test.calls);
+            web.executeScript("for (var i = 0; i < 1000; i++) test.touch()");
+            assertEquals(11000, test.calls);
+
+            assertEquals(Boolean.TRUE, web.executeScript("test.isEven(4)"));
+            assertEquals(Integer.valueOf(-1), web.executeScript("test.toByte(255)"));
+            assertEquals(Integer.valueOf(-32768), web.executeScript("test.toShort(32768)"));
+            assertEquals(Double.valueOf(1.0E10), web.executeScript("test.twice(5000000000)"));
+            assertEquals(Double.valueOf(1.25), web.executeScript("test.half(2.5)"));
+            assertEquals(Double.valueOf(7.5), web.executeScript("test.scale(2.5, 3)"));
+            assertEquals("ab", web.executeScript("test.concat('a', 'b')"));
+            assertEquals("null!", web.executeScript("test.concat(null, '!')"));
+            assertEquals(Character.valueOf('x'), web.executeScript("test.firstChar('xyz')"));
+            assertSame(test, web.executeScript("test.self()"));
+            assertEquals(Integer.valueOf(3), web.executeScript("test.pair(3, 4)[0]"));
+
+            // Exceptions thrown by the method still reach the script.
+            assertEquals("caught", web.executeScript(
+                "try { test.firstChar(''); 'not caught' } catch (e) { 'caught' }"));
+        });
+    }
+
+    public static class Item {
+        private final int id;
+        public Item(int id) { this.id = id; }
+        public int getId() { return id; }
+    }
+
+    public static class ItemSource {
+        public Item[] items(int count) {
+            Item[] items = new Item[count];
+            for (int i = 0; i < count; i++)
+                items[i] = new Item(i);
+            return items;
+        }
+    }
+
+    public @Test void testClassMetadataIsShared() throws InterruptedException {
+        final WebEngine web = getEngine();
+
+        submit(() -> {
+            bind("source", new ItemSource());
+            long hitsBefore = WebPage.getJavaClassCacheStatistics()[0];
+            assertEquals(Integer.valueOf(499500), web.executeScript(
+                "var items = source.items(1000), sum = 0;" +
+                "for (var i = 0; i < items.length; i++) sum += items[i].getId();" +
+                "sum"));
+            // Only the first Item reflects its class.
+            assertTrue(WebPage.getJavaClassCacheStatistics()[0] - hitsBefore >= 999);
+        });
+    }
+
+    public static class NumericData {
+        public double sum(double[] values) {
+            double sum = 0;
+            for (double value : values)
+                sum += value;
+            return sum;
+        }
+        public int length(int[] values) { return values == null ? -1 : values.length; }
+        public boolean[] flags;
+        public void setFlags(boolean[] flags) { this.flags = flags; }
+    }
+
+    public @Test void testBridgeTypedArrays() throws InterruptedException {
+        final WebEngine web = getEngine();
+
+        submit(() -> {
+            NumericData data = new NumericData();
+            bind("data", data);
+            double[] samples = { 0.5, 1.5, 2.5 };
+            bind("samples", samples);
+
+            // Java primitive arrays copy out to a typed array of the same element type.
+            assertEquals(Boolean.TRUE, web.executeScript(
+                "samples.toTypedArray() instanceof Float64Array"));
+            assertEquals(Double.valueOf(4.5), web.executeScript(
+                "var view = samples.toTypedArray(); view[0] + view[1] + view[2]"));
+
+            // Writes to the copy only reach Java through copyFrom().
+            web.executeScript("view[0] = 10.25");
+            assertEquals(0.5, samples[0], 0);
+            web.executeScript("samples.copyFrom(view)");
+            assertEquals(10.25, samples[0], 0);
+            assertEquals("caught", web.executeScript(
+                "try { samples.copyFrom(new Float64Array(4)); 'not caught' } catch (e) { 'caught' }"));
+
+            // Typed arrays and JavaScript arrays convert to Java primitive arrays.
+            assertEquals(Double.valueOf(6.5), web.executeScript(
+                "data.sum(new Float64Array([1, 2, 3.5]))"));
+            assertEquals(Double.valueOf(6.5), web.executeScript(
+                "data.sum(new Int32Array([1, 2, 3])) + 0.5"));
+            assertEquals(Double.valueOf(6.5), web.executeScript(
+                "data.sum([1, 2, 3.5])"));
+            assertEquals(Integer.valueOf(100000), web.executeScript(
+                "data.length(new Int32Array(100000))"));
+            web.executeScript("data.setFlags(new Uint8Array([0, 2, 1]))");
+            assertEquals(3, data.flags.length);
+            assertTrue(!data.flags[0] && data.flags[1] && data.flags[2]);
+        });
+    }
+
+    public @Test void testRestrictedReflectionFromScript() throws Exception {
+        final WebEngine web = getEngine();
+        final PrimitiveCalls test = new PrimitiveCalls();
+        final Method touch = PrimitiveCalls.class.getMethod("touch");
+        final MethodHandle touchHandle = MethodHandles.publicLookup().findVirtual(
+                PrimitiveCalls.class, "touch", MethodType.methodType(void.class));
+
+        submit(() -> {
+            bind("test", test);
+            bind("touch", touch);
+            bind("touchHandle", touchHandle);
+            bind("noArguments", new Object[0]);
+            bind("testArgument", new Object[] { test });
+
+            // The reflective path refuses to invoke methods of Method and of
+            // java.lang.invoke, and public methods that are otherwise called
+            // directly through JNI must not get around that.
+            web.executeScript("for (var i = 0; i < 100; i++) test.touch()");
+            assertEquals(100, test.calls);
+            assertEquals("caught", web.executeScript(
+                "try { touch.invoke(test, noArguments); 'not caught' } catch (e) { 'caught' }"));
+            assertEquals("caught", web.executeScript(
+                "try { touchHandle.invokeWithArguments(testArgument); 'not caught' } catch (e) { 'caught' }"));
+            assertEquals(100, test.calls);
+        });
+    }
+
+    public @Test void testCallerSensitiveReflectionFromScript() throws Exception {
+        final WebEngine web = getEngine();
+        final Field pageField = WebEngine.class.getDeclaredField("page");
+        pageField.setAccessible(true);
+        final WebPage page = (WebPage) pageField.get(web);
+        final Field widthField = WebPage.class.getDeclaredField("width");
+
+        submit(() -> {
+            bind("page", page);
+            bind("widthField", widthField);
+
+            // Field.get checks the access of its caller. Called straight
+            // through JNI its caller would be WebPage itself, which may read
+            // its own private fields, so platform methods must stay on the
+            // reflective path where the caller is unprivileged.
+            assertEquals("caught", web.executeScript(
+                "try { widthField.getInt(page); 'not caught' } catch (e) { 'caught' }"));
+            assertEquals("caught", web.executeScript(
+                "try { widthField.setInt(page, 1); 'not caught' } catch (e) { 'caught' }"));
+        });
+    }
+
+    public static class FieldHolder {
+        public int count;
+        public String label;
+        public char letter;
+    }
+
+    public @Test void testFieldAccessAfterJavaGC() throws InterruptedException {
+        final WebEngine web = getEngine();
+
+        submit(() -> {
+            FieldHolder first = new FieldHolder();
+            first.count = 1;
+            bind("first", first);
+            assertEquals(Integer.valueOf(1), web.executeScript("first.count"));
+        });
+
+        // The reflected fields of FieldHolder are shared by every instance,
+        // and they must still work once Java has collected whatever garbage
+        // reflection left behind.
+        for (int i = 0; i < 10; i++) {
+            System.gc();
+        }
+
+        submit(() -> {
+            FieldHolder second = new FieldHolder();
+            second.count = 5;
+            second.label = "five";
+            second.letter = 'v';
+            bind("second", second);
+            assertEquals(Integer.valueOf(5), web.executeScript("second.count"));
+            assertEquals("five", web.executeScript("second.label"));
+            assertEquals(Character.valueOf('v'), web.executeScript("second.letter"));
+
+            web.executeScript("second.count = 6; second.label = 'six'");
+            assertEquals(6, second.count);
+            assertEquals("six", second.label);
+        });
+    }
 }
@@ -250,6 +250,86 @@ public class MiscellaneousTest extends TestBase {
         });
     }
 
+    @Test public void testImageDecodedFromDataURL() {
+        // A 3x2 PNG image, all red.
+        loadContent(
+                "<img id='image' src='data:image/png;base64," +
+                "iVBORw0KGgoAAAANSUhEUgAAAAMAAAACCAIAAAASFvFNAAAAEElEQVR4nGP4" +
+                "z8AAQQxwFgBB0gX7h/C5SAAAAABJRU5ErkJggg=='>" +
+                "<canvas id='canvas' width='3' height='2'></canvas>");
+        assertEquals(3, executeScript("document.getElementById('image').naturalWidth"));
+        assertEquals(2, executeScript("document.getElementById('image').naturalHeight"));
+        assertEquals("255,0,0,255", executeScript(
+                "var context = document.getElementById('canvas').getContext('2d');" +
+                "context.drawImage(document.getElementById('image'), 0, 0);" +
+                "Array.prototype.join.call(context.getImageData(2, 1, 1, 1).data)"));
+    }
+
+    @Test public void testImageDrawnScaledDown() {
+        // A 1024x1024 PNG image, red on the left half and blue on the right.
+        loadContent(
+                "<img id='image' src='data:image/png;base64," +
+                "iVBORw0KGgoAAAANSUhEUgAABAAAAAQAAQMAAABF07nAAAAABlBMVEX/AAAA" +
+                "AP9sof2OAAACHElEQVR42u3OMQEAAAwCIPuX3kJ4+EACktKVIiAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAgICAg" +
+                "ICAgICAgILAOPOnBDvK+4/kKAAAAAElFTkSuQmCC'>" +
+                "<canvas id='small' width='128' height='128'></canvas>" +
+                "<canvas id='large' width='1024' height='1024'></canvas>");
+        assertEquals(1024, executeScript("document.getElementById('image').naturalWidth"));
+        assertEquals(1024, executeScript("document.getElementById('image').naturalHeight"));
+        // Drawn at an eighth of its size, the frame is decoded subsampled to
+        // 256x256, the smallest size WebKit subsamples to. It must still
+        // cover the whole image.
+        executeScript(
+                "var small = document.getElementById('small').getContext('2d');" +
+                "small.drawImage(document.getElementById('image'), 0, 0, 128, 128);");
+        assertEquals("255,0,0,255", executeScript(
+                "Array.prototype.join.call(small.getImageData(15, 64, 1, 1).data)"));
+        assertEquals("0,0,255,255", executeScript(
+                "Array.prototype.join.call(small.getImageData(112, 64, 1, 1).data)"));
+        // Drawing at full size afterwards needs the full size frame again.
+        executeScript(
+                "var large = document.getElementById('large').getContext('2d');" +
+                "large.drawImage(document.getElementById('image'), 0, 0);");
+        assertEquals("255,0,0,255", executeScript(
+                "Array.prototype.join.call(large.getImageData(511, 1023, 1, 1).data)"));
+        assertEquals("0,0,255,255", executeScript(
+                "Array.prototype.join.call(large.getImageData(512, 0, 1, 1).data)"));
+    }
+
+    @Test public void testImageDrawnSlightlyScaledDown() {
+        // A 512x512 PNG image, red on the left half and blue on the right.
+        loadContent(
+                "<img id='image' src='data:image/png;base64," +
+                "iVBORw0KGgoAAAANSUhEUgAAAgAAAAIAAQMAAADOtka5AAAABlBMVEX/AAAA" +
+                "AP9sof2OAAAAjUlEQVR42u3MMQ0AAAwDoPo3vUno3QQEkBRXRCAQCAQCgUAg" +
+                "EAgEAoFAIBAIBAKBQCAQCAQCgUAgEAgEAoFAIBAIBAKBQCAQCAQCgUAgEAgE" +
+                "AoFAIBAIBAKBQCAQCAQCgUAgEAgEAoFAIBAIBAKBQCAQCAQCgUAgEAgEAoFA" +
+                "IBAIBAKBQCAQCAQCgWA7eCC5w7IWiOh+AAAAAElFTkSuQmCC'>" +
+                "<canvas id='canvas' width='448' height='448'></canvas>");
+        assertEquals(512, executeScript("document.getElementById('image').naturalWidth"));
+        // Drawn at 7/8 of its size, the edge falls between canvas pixels
+        // 223 and 224. Both stay pure colors only if the frame is decoded
+        // at full size rather than subsampled and scaled back up.
+        executeScript(
+                "var context = document.getElementById('canvas').getContext('2d');" +
+                "context.drawImage(document.getElementById('image'), 0, 0, 448, 448);");
+        assertEquals("255,0,0,255", executeScript(
+                "Array.prototype.join.call(context.getImageData(223, 200, 1, 1).data)"));
+        assertEquals("0,0,255,255", executeScript(
+                "Array.prototype.join.call(context.getImageData(224, 200, 1, 1).data)"));
+    }
+
     // This test case will be removed once we implement Websql feature.
     @Test public void testWebSQLUndefined() {
         final WebEngine webEngine = createWebEngine();
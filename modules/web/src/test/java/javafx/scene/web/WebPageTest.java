@@ -28,7 +28,10 @@ package javafx.scene.web;
 import com.sun.webkit.WebPage;
 import java.util.concurrent.Callable;
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
 import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeTrue;
 import org.junit.Test;
 
 public class WebPageTest extends TestBase {
@@ -62,4 +65,69 @@ public class WebPageTest extends TestBase {
         WebPage page = getEngine().getPage();
         assertEquals(null, page.getHtml(1));
     }
+
+    @Test public void testJavaScriptSamplingFoldedStacks() throws Exception {
+        loadContent(PLAIN);
+        assumeTrue("Sampling profiler is not available",
+                submit(() -> WebPage.startJavaScriptSampling(100)));
+
+        executeScript("function hot(n) { var s = 0; for (var i = 0; i < n; i++) s += i % 7; return s; }"
+                + "for (var j = 0; j < 200; j++) hot(100000);");
+
+        String folded = submit(() -> WebPage.stopJavaScriptSampling(false));
+        assertNotNull("Folded stacks", folded);
+        int hotSamples = 0;
+        for (String line : folded.split("\n")) {
+            if (!line.isEmpty()) {
+                assertTrue("Malformed folded stack: " + line, line.matches(".+ \\d+"));
+                // Frames are labeled "name (url:line)", innermost last.
+                if (line.matches("(.*;)?hot \\([^;]*\\) \\d+")) {
+                    hotSamples += Integer.parseInt(line.substring(line.lastIndexOf(' ') + 1));
+                }
+            }
+        }
+        assertTrue("No samples in the hot function:\n" + folded, hotSamples > 0);
+    }
+
+    @Test public void testJavaScriptHeapHardLimit() throws Exception {
+        loadContent(PLAIN);
+        submit(() -> {
+            WebPage.setJavaScriptHeapPolicy(0, 0, 64 * 1024 * 1024);
+            return null;
+        });
+        try {
+            Object message = executeScript("var keep = [];"
+                    + "try { for (var i = 0; ; i++) keep.push({ index: i, values: [i, i + 1, i + 2] }); }"
+                    + "catch (e) { e.message; }");
+            assertEquals("Error thrown at the hard limit", "Out of memory", message);
+            assertTrue("Heap is over the limit after the error",
+                    submit(() -> WebPage.hasJavaScriptHeapExceededLimit()));
+
+            // A collection made while no script runs leaves the heap over the
+            // limit, but must not throw at the next script.
+            assertTrue("Collected while idle",
+                    submit(() -> WebPage.collectJavaScriptGarbageWhenIdle(Integer.MAX_VALUE)));
+            assertTrue("Heap is still over the limit",
+                    submit(() -> WebPage.hasJavaScriptHeapExceededLimit()));
+            Object sum = executeScript("var sum = 0; for (var i = 0; i < 1000; i++) sum += i; sum;");
+            assertEquals("Unrelated script ran", 499500, ((Number) sum).intValue());
+            executeScript("keep = null;");
+
+            // With the limit still in place, a full collection frees what the
+            // script dropped, and the page can allocate again without an error.
+            assertTrue("Collected while idle",
+                    submit(() -> WebPage.collectJavaScriptGarbageWhenIdle(Integer.MAX_VALUE)));
+            assertTrue("Heap is back under the limit",
+                    !submit(() -> WebPage.hasJavaScriptHeapExceededLimit()));
+            Object count = executeScript("var kept = [];"
+                    + "for (var i = 0; i < 100000; i++) kept.push({ index: i, values: [i, i + 1, i + 2] });"
+                    + "kept.length;");
+            assertEquals("Allocated after the collection", 100000, ((Number) count).intValue());
+        } finally {
+            submit(() -> {
+                WebPage.setJavaScriptHeapPolicy(0, 0, 0);
+                return null;
+            });
+        }
+    }
 }
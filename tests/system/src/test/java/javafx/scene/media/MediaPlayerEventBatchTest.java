@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package javafx.scene.media;
+
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.stage.Stage;
+import junit.framework.AssertionFailedError;
+import org.junit.After;
+import org.junit.AfterClass;
+import org.junit.BeforeClass;
+import org.junit.Test;
+import util.Util;
+
+import static org.junit.Assert.*;
+import static util.Util.TIMEOUT;
+
+/**
+ * Test coalescing and deadline delivery of the events the native player
+ * batches, see CJavaPlayerEventDispatcher::EVENT_BATCH_INTERVAL_MS.
+ */
+public class MediaPlayerEventBatchTest {
+
+    // Must match CJavaPlayerEventDispatcher::EVENT_BATCH_INTERVAL_MS
+    private static final double EVENT_BATCH_INTERVAL = 0.016;
+
+    // Length of the generated audio clip in seconds
+    private static final int CLIP_DURATION = 3;
+
+    // Used to launch the application before running any test
+    private static final CountDownLatch launchLatch = new CountDownLatch(1);
+
+    public static class MyApp extends Application {
+        @Override public void start(Stage primaryStage) throws Exception {
+            launchLatch.countDown();
+        }
+    }
+
+    private static File clipFile;
+
+    private MediaPlayer player;
+
+    // Media time stamps of the spectrum updates received, FX thread only
+    private final List<Double> timestamps = new ArrayList<>();
+
+    @BeforeClass
+    public static void setupOnce() throws IOException {
+        // Start the Application
+        new Thread(() -> Application.launch(MyApp.class, (String[])null)).start();
+
+        try {
+            if (!launchLatch.await(TIMEOUT, TimeUnit.MILLISECONDS)) {
+                throw new AssertionFailedError("Timeout waiting for Application to launch");
+            }
+        } catch (InterruptedException ex) {
+            AssertionFailedError err = new AssertionFailedError("Unexpected exception");
+            err.initCause(ex);
+            throw err;
+        }
+
+        clipFile = File.createTempFile("eventbatch", ".wav");
+        clipFile.deleteOnExit();
+        writeWaveFile(clipFile, CLIP_DURATION);
+    }
+
+    @AfterClass
+    public static void teardownOnce() {
+        Platform.exit();
+    }
+
+    @After
+    public void teardownEach() {
+        Util.runAndWait(() -> {
+            if (player != null) {
+                player.dispose();
+            }
+        });
+    }
+
+    // 16 bit mono PCM, 440 Hz sine
+    private static void writeWaveFile(File file, int seconds) throws IOException {
+        final int sampleRate = 44100;
+        final int dataSize = sampleRate * seconds * 2;
+        try (DataOutputStream out = new DataOutputStream(new FileOutputStream(file))) {
+            out.writeBytes("RIFF");
+            out.writeInt(Integer.reverseBytes(36 + dataSize));
+            out.writeBytes("WAVEfmt ");
+            out.writeInt(Integer.reverseBytes(16));
+            out.writeShort(Short.reverseBytes((short) 1));  // PCM
+            out.writeShort(Short.reverseBytes((short) 1));  // channels
+            out.writeInt(Integer.reverseBytes(sampleRate));
+            out.writeInt(Integer.reverseBytes(sampleRate * 2));
+            out.writeShort(Short.reverseBytes((short) 2));  // block align
+            out.writeShort(Short.reverseBytes((short) 16)); // bits per sample
+            out.writeBytes("data");
+            out.writeInt(Integer.reverseBytes(dataSize));
+            for (int i = 0; i < sampleRate * seconds; i++) {
+                double sample = Math.sin(2 * Math.PI * 440 * i / sampleRate);
+                out.writeShort(Short.reverseBytes((short) (sample * 8000)));
+            }
+        }
+    }
+
+    // Plays the clip with spectrum updates produced every millisecond
+    private void playClip(Runnable onEndOfMedia) {
+        Util.runAndWait(() -> {
+            player = new MediaPlayer(new Media(clipFile.toURI().toString()));
+            player.setAudioSpectrumInterval(0.001);
+            player.setAudioSpectrumListener((timestamp, duration, magnitudes, phases) -> {
+                timestamps.add(timestamp);
+            });
+            player.setOnEndOfMedia(onEndOfMedia);
+            player.play();
+        });
+    }
+
+    private int getUpdateCount() {
+        final int[] count = new int[1];
+        Util.runAndWait(() -> count[0] = timestamps.size());
+        return count[0];
+    }
+
+    @Test(timeout = 20000)
+    public void testSpectrumUpdatesCoalesced() throws InterruptedException {
+        final CountDownLatch endLatch = new CountDownLatch(1);
+        playClip(endLatch::countDown);
+        assertTrue("Timeout waiting for end of media",
+                endLatch.await(CLIP_DURATION * 1000 + TIMEOUT, TimeUnit.MILLISECONDS));
+
+        Util.runAndWait(() -> {
+            // About one update per millisecond is produced, at most one per
+            // batch interval may reach Java.
+            int maxUpdates = (int) (CLIP_DURATION / EVENT_BATCH_INTERVAL * 1.5);
+            assertTrue("No spectrum update received", timestamps.size() > 1);
+            assertTrue("Spectrum updates not coalesced: " + timestamps.size(),
+                    timestamps.size() < maxUpdates);
+
+            // The updates which are kept arrive in order and keep flowing at
+            // the batch interval rather than waiting for other events.
+            double maxGap = 0;
+            for (int i = 1; i < timestamps.size(); i++) {
+                double gap = timestamps.get(i) - timestamps.get(i - 1);
+                assertTrue("Spectrum updates out of order", gap > 0);
+                maxGap = Math.max(maxGap, gap);
+            }
+            assertTrue("Spectrum updates delayed by " + maxGap + "s", maxGap < 0.25);
+        });
+    }
+
+    @Test(timeout = 20000)
+    public void testPendingUpdateDeliveredAtDeadline() {
+        playClip(null);
+        int count = 0;
+        for (int i = 0; i < TIMEOUT / 10 && count < 10; i++) {
+            Util.sleep(10);
+            count = getUpdateCount();
+        }
+        assertTrue("Timeout waiting for spectrum updates", count >= 10);
+
+        // Stop producing updates while the player keeps playing. The update
+        // that was still coalescing must go out once the batch interval has
+        // elapsed, not with the queue flush done for the next state change.
+        Util.runAndWait(() -> player.setAudioSpectrumInterval(CLIP_DURATION * 10));
+        Util.sleep(500);
+        int countBeforePause = getUpdateCount();
+        Util.runAndWait(() -> player.pause());
+        Util.sleep(500);
+        assertEquals("Pending spectrum update held back until pause",
+                countBeforePause, getUpdateCount());
+    }
+}